@@ -138,6 +138,47 @@ BOOST_AUTO_TEST_CASE( CMA_Sphere_Niko )
 	BOOST_CHECK(!condHigh);
 }
 
+BOOST_AUTO_TEST_CASE( CMA_LargeScale )
+{
+	//several blocks for the parallel matrix operations and lazy updates of the eigendecomposition.
+	//for N=250 the decomposition is only updated every second generation
+	Rng::seed(42);
+	const std::size_t N = 250;
+	Ellipsoid elli(N, 100);
+	elli.init();
+	CMA cma;
+	cma.init(elli, RealVector(N, 1.0));
+	double initialValue = elli.eval(RealVector(N, 1.0));
+	std::size_t staleSteps = 0;
+	std::size_t updateSteps = 0;
+	for(unsigned i=0; i<300; i++){
+		RealVector eigenValues = cma.eigenValues();
+		cma.step( elli );
+		if(max(abs(eigenValues - cma.eigenValues())) == 0)
+			++staleSteps;
+		else
+			++updateSteps;
+	}
+	BOOST_CHECK_GT(staleSteps, 0u);
+	BOOST_CHECK_GT(updateSteps, 0u);
+	BOOST_CHECK_SMALL(cma.solution().value / initialValue, 0.1);
+	BOOST_CHECK_GT(cma.condition(), 1.2);
+
+	//after an update, the decomposition belongs to the current covariance matrix
+	RealVector eigenValues = cma.eigenValues();
+	cma.step( elli );
+	if(max(abs(eigenValues - cma.eigenValues())) == 0)
+		cma.step( elli );
+	RealMatrix const& C = cma.covarianceMatrix();
+	RealMatrix const& B = cma.eigenVectors();
+	RealMatrix BD = B;
+	for(std::size_t j = 0; j != N; ++j)
+		column(BD, j) *= cma.eigenValues()(j);
+	BOOST_CHECK_SMALL(max(abs(C - trans(C))), 0.0);
+	BOOST_CHECK_SMALL(max(abs(BD % trans(B) - C)) / max(abs(C)), 1.e-10);
+	BOOST_CHECK_GT(min(cma.eigenValues()), 0.0);
+}
+
 BOOST_AUTO_TEST_CASE( CMA_Multiplicative_Noisy_Sphere)
 {
 	std::cout<<"start"<<std::endl;
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE DirectSearch_Hyperband
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/DirectSearch/Hyperband.h>
+
+#include <map>
+
+using namespace shark;
+
+// Sphere whose evaluations with a small budget are disturbed by a second sphere.
+// All budgets used are recorded.
+class BudgetedSphere : public AbstractBudgetedObjectiveFunction{
+public:
+	BudgetedSphere(){
+		m_features |= CAN_PROPOSE_STARTING_POINT;
+	}
+	std::string name() const
+	{ return "BudgetedSphere"; }
+
+	std::size_t numberOfVariables()const{
+		return 2;
+	}
+	SearchPointType proposeStartingPoint()const{
+		return RealVector(2, 0.5);
+	}
+
+	double evalBudgeted(RealVector const& point, double budget)const{
+		++m_evaluationCounter;
+		++budgets[budget];
+		RealVector shift(2, 0.5);
+		return norm_sqr(point) + (1 - budget) * norm_sqr(point - shift);
+	}
+	mutable std::map<double, std::size_t> budgets;
+};
+
+BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_Hyperband)
+
+BOOST_AUTO_TEST_CASE( SuccessiveHalving_Rounds )
+{
+	BudgetedSphere function;
+	SuccessiveHalving optimizer;
+	optimizer.init(function);
+	optimizer.step(function);
+
+	//27 points with budget 1/27, 9 with 1/9, 3 with 1/3 and one with full budget
+	BOOST_REQUIRE_EQUAL(function.budgets.size(), 4u);
+	std::size_t expected = 1;
+	for(auto budget = function.budgets.rbegin(); budget != function.budgets.rend(); ++budget){
+		BOOST_CHECK_CLOSE(budget->first, 1.0 / expected, 1.e-10);
+		BOOST_CHECK_EQUAL(budget->second, expected);
+		expected *= 3;
+	}
+	BOOST_CHECK_EQUAL(optimizer.solution().value, function.eval(optimizer.solution().point));
+}
+
+BOOST_AUTO_TEST_CASE( Hyperband_Brackets )
+{
+	BudgetedSphere function;
+	Hyperband optimizer;
+	optimizer.setMinimumBudget(1.0 / 9);
+	optimizer.init(function);
+	BOOST_REQUIRE_EQUAL(optimizer.numberOfBrackets(), 3u);
+
+	//first bracket: 9 points with budget 1/9, 3 with 1/3 and one with full budget
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(function.budgets[1.0 / 9], 9u);
+	BOOST_CHECK_EQUAL(function.budgets[1.0 / 3], 3u);
+	BOOST_CHECK_EQUAL(function.budgets[1.0], 1u);
+	//second bracket: 5 points with budget 1/3 and one with full budget
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(function.budgets[1.0 / 3], 8u);
+	BOOST_CHECK_EQUAL(function.budgets[1.0], 2u);
+	//third bracket: random search with 3 points
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(function.budgets[1.0 / 9], 9u);
+	BOOST_CHECK_EQUAL(function.budgets[1.0], 5u);
+	//and again the first one
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(function.budgets[1.0 / 9], 18u);
+}
+
+BOOST_AUTO_TEST_CASE( Hyperband_Optimize )
+{
+	BudgetedSphere function;
+	Hyperband optimizer;
+	optimizer.configure(2, -1, 1);
+	optimizer.init(function);
+	for(std::size_t i = 0; i != 10 * optimizer.numberOfBrackets(); ++i){
+		optimizer.step(function);
+	}
+	BOOST_CHECK_SMALL(optimizer.solution().value, 0.05);
+	BOOST_CHECK_EQUAL(optimizer.solution().value, function.eval(optimizer.solution().point));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,7 +5,9 @@
 #include <shark/Algorithms/DirectSearch/Operators/Indicators/HypervolumeIndicator.h>
 #include <shark/Algorithms/DirectSearch/Individual.h>
 #include <shark/Rng/GlobalRng.h>
+#include <shark/Core/ISerializable.h>
 #include <limits>
+#include <sstream>
 
 using namespace shark;
 
@@ -99,4 +101,22 @@ BOOST_AUTO_TEST_CASE( HypervolumeIndicator_LeastK ) {
 		
 	}
 }
+BOOST_AUTO_TEST_CASE( HypervolumeIndicator_Serialization ) {
+	HypervolumeIndicator indicator;
+	indicator.useIncrementalUpdates(false);
+	indicator.setReference(RealVector(4, 1.0));
+	std::stringstream stream;
+	{
+		TextOutArchive archive(stream);
+		archive << indicator;
+	}
+	HypervolumeIndicator restored;
+	BOOST_REQUIRE(restored.useIncrementalUpdates());
+	{
+		TextInArchive archive(stream);
+		archive >> restored;
+	}
+	BOOST_CHECK(!restored.useIncrementalUpdates());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include <shark/Algorithms/DirectSearch/Operators/Domination/FastNonDominatedSort.h>
 #include <shark/Algorithms/DirectSearch/Operators/Domination/DCNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/ENSNonDominatedSort.h>
 #include <shark/Rng/GlobalRng.h>
 #include <shark/Core/Timer.h>
 
@@ -39,6 +40,10 @@ BOOST_AUTO_TEST_CASE( NonDominatedSort_Test )
 			
 			std::vector<unsigned int> ranks2(numPoints);
 			dcNonDominatedSort(points, ranks2);
+			
+			//small blocks, so that the ranks of the blocks need to be corrected
+			std::vector<unsigned int> ranks3(numPoints);
+			ensNonDominatedSort(points, ranks3, 7);
 
 			// check that ranks are consistent with the dominance relation
 			for(std::size_t i = 0; i != numPoints; ++i){
@@ -59,8 +64,35 @@ BOOST_AUTO_TEST_CASE( NonDominatedSort_Test )
 			for (std::size_t i=0; i<numPoints; i++)
 			{
 				BOOST_CHECK_EQUAL(ranks1[i], ranks2[i]);
+				BOOST_CHECK_EQUAL(ranks1[i], ranks3[i]);
 			}
 		}
 	}
 }
+
+// the parallel algorithm on a larger set with many objectives
+// must deliver the same result as the other algorithms.
+BOOST_AUTO_TEST_CASE( NonDominatedSort_ENS_Large )
+{
+	std::size_t numPoints = 2000;
+	for (std::size_t numDims=3; numDims <= 8; numDims += 5)
+	{
+		std::vector<RealVector> points(numPoints);
+		for (std::size_t i = 0; i != numPoints; ++i) {
+			points[i].resize(numDims);
+			for (std::size_t j = 0; j != numDims; ++j) {
+				points[i][j] = Rng::uni(-1,2);
+			}
+		}
+		std::vector<unsigned int> ranks1(numPoints);
+		dcNonDominatedSort(points, ranks1);
+		
+		std::vector<unsigned int> ranks2(numPoints);
+		ensNonDominatedSort(points, ranks2);
+		for (std::size_t i=0; i<numPoints; i++)
+		{
+			BOOST_CHECK_EQUAL(ranks1[i], ranks2[i]);
+		}
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
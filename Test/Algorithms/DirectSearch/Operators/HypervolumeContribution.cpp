@@ -7,6 +7,8 @@
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContributionMD.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContributionApproximator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/IncrementalHypervolumeContribution.h>
+#include <shark/Algorithms/DirectSearch/Operators/Indicators/HypervolumeIndicator.h>
 
 using namespace shark;
 
@@ -262,4 +264,86 @@ BOOST_AUTO_TEST_CASE( Algorithms_HypervolumeContributionApproximator ) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Algorithms_IncrementalHypervolumeContribution ) {
+	std::cout<<"Contribution Incremental"<<std::endl;
+	const unsigned int numSteps = 30;
+	const std::size_t numPoints = 20;
+	Rng::seed(42);
+	
+	for(std::size_t numObj = 3; numObj <= 5; ++numObj){
+		RealVector reference(numObj,1.0);
+		auto set = createRandomFront(numPoints,numObj,2);
+		IncrementalHypervolumeContribution algorithm;
+		algorithm.assign(set,reference);
+		for(unsigned int t = 0; t != numSteps; ++t){
+			//steady-state step: insert a new point and remove a random point
+			auto newPoint = createRandomFront(1,numObj,2)[0];
+			set.push_back(newPoint);
+			algorithm.insert(newPoint);
+			std::size_t index = Rng::discrete(0,set.size()-1);
+			set.erase(set.begin()+index);
+			algorithm.remove(index);
+			
+			BOOST_REQUIRE_EQUAL(algorithm.size(), set.size());
+			auto contributionsTrue = contributionsNaive(set, reference);
+			for(std::size_t i = 0; i != contributionsTrue.size(); ++i){
+				std::size_t pos = contributionsTrue[i].value;
+				BOOST_CHECK_SMALL(norm_inf(algorithm.point(pos) - set[pos]), 1.e-15);
+				BOOST_CHECK_SMALL(algorithm.contribution(pos) - contributionsTrue[i].key, 1.e-10);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Algorithms_HypervolumeIndicator_IncrementalUpdates ) {
+	const unsigned int numSteps = 30;
+	const std::size_t numPoints = 20;
+	Rng::seed(42);
+	
+	for(std::size_t numObj = 4; numObj <= 5; ++numObj){
+		for(std::size_t useReference = 0; useReference != 2; ++useReference){
+			HypervolumeIndicator incremental;
+			HypervolumeIndicator full;
+			full.useIncrementalUpdates(false);
+			if(useReference){
+				incremental.setReference(RealVector(numObj,1.0));
+				full.setReference(RealVector(numObj,1.0));
+			}
+			auto front = createRandomFront(numPoints,numObj,2);
+			for(unsigned int t = 0; t != numSteps; ++t){
+				//like a steady-state algorithm: one offspring is added and the least contributor removed.
+				//every few steps, two points are removed to exercise the multi-point selection.
+				//without reference, ties of boundary points change the reference of the second selection,
+				//thus this is only done with a fixed reference point
+				front.push_back(createRandomFront(1,numObj,2)[0]);
+				std::size_t K = (useReference && t % 5 == 4)? 2: 1;
+				auto indices = incremental.leastContributors(front,front,K);
+				auto indicesFull = full.leastContributors(front,front,K);
+				BOOST_REQUIRE_EQUAL(indices.size(), K);
+				
+				//points on the boundary can have the same contribution, thus we compare the remaining volume
+				RealVector reference(numObj,1.0);
+				if(!useReference){
+					reference = front[0];
+					for(auto const& point: front)
+						noalias(reference) = max(reference,point);
+				}
+				auto remaining = [&](std::vector<std::size_t> removed){
+					std::sort(removed.begin(),removed.end());
+					auto set = front;
+					for(std::size_t k = K; k != 0; --k){
+						set.erase(set.begin()+removed[k-1]);
+					}
+					return set;
+				};
+				HypervolumeCalculator hv;
+				BOOST_CHECK_SMALL(hv(remaining(indices),reference) - hv(remaining(indicesFull),reference), 1.e-12);
+				front = remaining(indices);
+				if(K == 2)
+					front.push_back(createRandomFront(1,numObj,2)[0]);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
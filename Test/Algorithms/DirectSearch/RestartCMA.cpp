@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE DirectSearch_RestartCMA
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/DirectSearch/RestartCMA.h>
+
+#include <sstream>
+
+using namespace shark;
+
+// Rastrigin function, highly multimodal with the global optimum 0 at the origin.
+class Rastrigin : public SingleObjectiveFunction{
+public:
+	Rastrigin(std::size_t numberOfVariables, bool threadSafe):m_numberOfVariables(numberOfVariables){
+		if(threadSafe)
+			m_features |= IS_THREAD_SAFE;
+	}
+	std::string name() const
+	{ return "Rastrigin"; }
+
+	std::size_t numberOfVariables()const{
+		return m_numberOfVariables;
+	}
+
+	double eval(RealVector const& x)const{
+		double value = 10.0 * x.size();
+		for(std::size_t i = 0; i != x.size(); ++i){
+			value += x(i) * x(i) - 10.0 * std::cos(2 * M_PI * x(i));
+		}
+		return value;
+	}
+private:
+	std::size_t m_numberOfVariables;
+};
+
+BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_RestartCMA)
+
+BOOST_AUTO_TEST_CASE( RestartCMA_Rastrigin )
+{
+	RestartCMA::RestartStrategy strategies[] = {RestartCMA::IPOP, RestartCMA::BIPOP};
+	for(auto strategy: strategies){
+		Rastrigin function(3, true);
+		RestartCMA optimizer;
+		optimizer.setStrategy(strategy);
+		optimizer.setNumberOfInstances(2);
+		optimizer.setMaxEvaluations(100000);
+		optimizer.configure(3, -5, 5);
+		optimizer.init(function, RealVector(3, 3.0));
+		while(!optimizer.budgetExhausted() && optimizer.solution().value > 1.e-10){
+			optimizer.step(function);
+		}
+		BOOST_CHECK_SMALL(optimizer.solution().value, 1.e-10);
+		BOOST_CHECK_GT(optimizer.numberOfRuns(), 2u);
+		BOOST_CHECK_CLOSE(optimizer.solution().value, function.eval(optimizer.solution().point), 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( RestartCMA_Budget )
+{
+	Rastrigin function(5, true);
+	RestartCMA optimizer;
+	optimizer.setNumberOfInstances(3);
+	optimizer.setMaxEvaluations(5000);
+	optimizer.configure(5, -5, 5);
+	optimizer.init(function, RealVector(5, 3.0));
+	//every instance can overshoot the budget by at most one generation
+	std::size_t maxLambda = 0;
+	while(!optimizer.budgetExhausted()){
+		for(std::size_t i = 0; i != optimizer.numberOfInstances(); ++i){
+			maxLambda = std::max(maxLambda, optimizer.instance(i).lambda());
+		}
+		optimizer.step(function);
+	}
+	BOOST_CHECK_GE(optimizer.numberOfEvaluations(), 5000u);
+	BOOST_CHECK_LT(optimizer.numberOfEvaluations(), 5000u + 3 * maxLambda);
+	std::size_t evaluations = optimizer.numberOfEvaluations();
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(optimizer.numberOfEvaluations(), evaluations);
+}
+
+BOOST_AUTO_TEST_CASE( RestartCMA_ParallelEqualsSerial )
+{
+	//stepping the instances in parallel must not change the result
+	Rastrigin parallelFunction(4, true);
+	Rastrigin serialFunction(4, false);
+	//new runs are seeded from the generator passed to the constructor, thus both get the same seed
+	DefaultRngType parallelRng(42);
+	DefaultRngType serialRng(42);
+	RestartCMA parallel(parallelRng);
+	RestartCMA serial(serialRng);
+	parallel.setNumberOfInstances(4);
+	serial.setNumberOfInstances(4);
+	parallel.configure(4, -5, 5);
+	serial.configure(4, -5, 5);
+	parallel.init(parallelFunction, RealVector(4, 3.0));
+	for(std::size_t t = 0; t != 300; ++t){
+		parallel.step(parallelFunction);
+	}
+	serial.init(serialFunction, RealVector(4, 3.0));
+	for(std::size_t t = 0; t != 300; ++t){
+		serial.step(serialFunction);
+	}
+	BOOST_CHECK_GT(parallel.numberOfRuns(), 4u);
+	BOOST_CHECK_EQUAL(parallel.numberOfRuns(), serial.numberOfRuns());
+	BOOST_CHECK_EQUAL(parallel.numberOfEvaluations(), serial.numberOfEvaluations());
+	BOOST_CHECK_EQUAL(parallel.solution().value, serial.solution().value);
+	BOOST_CHECK_SMALL(norm_inf(parallel.solution().point - serial.solution().point), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( RestartCMA_Serialization )
+{
+	//a restored optimizer continues exactly as the original one
+	Rastrigin function(3, true);
+	RestartCMA optimizer;
+	optimizer.setNumberOfInstances(2);
+	optimizer.configure(3, -5, 5);
+	optimizer.init(function, RealVector(3, 3.0));
+	for(std::size_t t = 0; t != 200; ++t){
+		optimizer.step(function);
+	}
+
+	std::stringstream stream;
+	{
+		TextOutArchive archive(stream);
+		optimizer.write(archive);
+	}
+	RestartCMA restored;
+	{
+		TextInArchive archive(stream);
+		restored.read(archive);
+	}
+	BOOST_CHECK_EQUAL(restored.solution().value, optimizer.solution().value);
+
+	//the random number stream seeding new runs is restored as well
+	for(std::size_t t = 0; t != 200; ++t){
+		optimizer.step(function);
+	}
+	for(std::size_t t = 0; t != 200; ++t){
+		restored.step(function);
+	}
+	BOOST_CHECK_GT(restored.numberOfRuns(), 2u);
+	BOOST_CHECK_EQUAL(restored.numberOfRuns(), optimizer.numberOfRuns());
+	BOOST_CHECK_EQUAL(restored.numberOfEvaluations(), optimizer.numberOfEvaluations());
+	BOOST_CHECK_EQUAL(restored.solution().value, optimizer.solution().value);
+	BOOST_CHECK_SMALL(norm_inf(restored.solution().point - optimizer.solution().point), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
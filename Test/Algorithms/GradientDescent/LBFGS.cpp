@@ -51,4 +51,80 @@ BOOST_AUTO_TEST_CASE( BFGS_wolfe_Rosenbrock )
 	testFunction(optimizer,function,100,100);
 }
 
+BOOST_AUTO_TEST_CASE( LBFGS_Compact_wolfe )
+{
+	Ellipsoid function(5);
+	LBFGS optimizer;
+	optimizer.setCompactRepresentation();
+	optimizer.lineSearch().lineSearchType()=LineSearch::WolfeCubic;
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" in compact representation"<<std::endl;
+	testFunction(optimizer,function,100,100);
+}
+BOOST_AUTO_TEST_CASE( LBFGS_Compact_Dlinmin_Rosenbrock )
+{
+	Rosenbrock function(3);
+	LBFGS optimizer;
+	optimizer.setHistCount(3);
+	optimizer.setCompactRepresentation();
+	optimizer.lineSearch().lineSearchType()=LineSearch::Dlinmin;
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" in compact representation"<<std::endl;
+	testFunction(optimizer,function,100,100);
+}
+
+//the compact representation and the two-loop recursion compute the same direction,
+//the history is short such that old pairs are replaced
+BOOST_AUTO_TEST_CASE( LBFGS_Compact_Same_Steps )
+{
+	Rosenbrock function(10);
+	function.init();
+	RealVector start = function.proposeStartingPoint();
+	LBFGS twoLoop;
+	LBFGS compact;
+	twoLoop.setHistCount(3);
+	compact.setHistCount(3);
+	compact.setCompactRepresentation();
+	BOOST_CHECK(compact.compactRepresentation());
+	BOOST_CHECK(!twoLoop.compactRepresentation());
+	twoLoop.init(function,start);
+	compact.init(function,start);
+	for(std::size_t i = 0; i != 15; ++i){
+		twoLoop.step(function);
+		compact.step(function);
+		BOOST_CHECK_SMALL(norm_inf(twoLoop.solution().point - compact.solution().point),1.e-8);
+	}
+}
+
+//changing the representation between init and step has no effect until the next init
+BOOST_AUTO_TEST_CASE( LBFGS_Compact_Toggle_After_Init )
+{
+	Rosenbrock function(10);
+	function.init();
+	RealVector start = function.proposeStartingPoint();
+	LBFGS reference;
+	LBFGS toggled;
+	reference.setHistCount(3);
+	toggled.setHistCount(3);
+	reference.init(function,start);
+	toggled.init(function,start);
+	toggled.setCompactRepresentation(true);
+	for(std::size_t i = 0; i != 5; ++i){
+		reference.step(function);
+		toggled.step(function);
+		BOOST_CHECK_EQUAL(norm_inf(reference.solution().point - toggled.solution().point), 0.0);
+	}
+
+	//the other way round, the compact representation stays in use
+	reference.setCompactRepresentation(true);
+	reference.init(function,start);
+	toggled.init(function,start);
+	toggled.setCompactRepresentation(false);
+	for(std::size_t i = 0; i != 5; ++i){
+		reference.step(function);
+		toggled.step(function);
+		BOOST_CHECK_EQUAL(norm_inf(reference.solution().point - toggled.solution().point), 0.0);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
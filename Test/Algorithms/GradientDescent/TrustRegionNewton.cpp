@@ -5,6 +5,10 @@
 #include <shark/Algorithms/GradientDescent/TrustRegionNewton.h>
 #include <shark/ObjectiveFunctions/Benchmarks/Rosenbrock.h>
 #include <shark/ObjectiveFunctions/Benchmarks/Ellipsoid.h>
+#include <shark/ObjectiveFunctions/ErrorFunction.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Models/FFNet.h>
+#include <shark/Data/DataDistribution.h>
 
 #include "../testFunction.h"
 
@@ -30,5 +34,87 @@ BOOST_AUTO_TEST_CASE( TrustRegionNewton_Rosenbrock )
 	testFunction(optimizer,function,100,1000,1.e-14);
 }
 
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Ellipsoid )
+{
+	Ellipsoid function(5);
+	TrustRegionNewton optimizer;
+	optimizer.setHessianFree();
+	BOOST_CHECK(!optimizer.requiresSecondDerivative());
+	BOOST_CHECK(optimizer.requiresHessianVectorProduct());
+
+	std::cout<<"Testing: "<<optimizer.name()<<" (Hessian-free) with "<<function.name()<<std::endl;
+	testFunction(optimizer,function,100,100);
+}
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Rosenbrock )
+{
+	Rosenbrock function(3);
+	TrustRegionNewton optimizer;
+	optimizer.setHessianFree();
+
+	std::cout<<"Testing: "<<optimizer.name()<<" (Hessian-free) with "<<function.name()<<std::endl;
+	testFunction(optimizer,function,100,1000,1.e-14);
+}
+
+//the Hessian-free mode takes the same steps as the mode using the full Hessian, up to rounding
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Same_Steps )
+{
+	Rosenbrock function(10);
+	RealVector start(10,0.0);
+	TrustRegionNewton dense;
+	TrustRegionNewton hessianFree;
+	hessianFree.setHessianFree();
+	dense.init(function,start);
+	hessianFree.init(function,start);
+	for(std::size_t i = 0; i != 30; ++i){
+		dense.step(function);
+		hessianFree.step(function);
+		BOOST_REQUIRE_SMALL(norm_inf(dense.solution().point - hessianFree.solution().point), 1.e-8);
+	}
+}
+
+//changing the mode between init and step has no effect until the next init
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Toggle_After_Init )
+{
+	Rosenbrock function(10);
+	RealVector start(10,0.0);
+	for(std::size_t mode = 0; mode != 2; ++mode){
+		bool hessianFree = mode == 0;
+		TrustRegionNewton reference;
+		TrustRegionNewton toggled;
+		reference.setHessianFree(hessianFree);
+		toggled.setHessianFree(hessianFree);
+		reference.init(function,start);
+		toggled.init(function,start);
+		toggled.setHessianFree(!hessianFree);
+		for(std::size_t i = 0; i != 10; ++i){
+			reference.step(function);
+			toggled.step(function);
+			BOOST_CHECK_EQUAL(norm_inf(reference.solution().point - toggled.solution().point), 0.0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_FFNet )
+{
+	Wave problem;
+	RegressionDataset data = problem.generateDataset(200,50);
+	FFNet<LogisticNeuron,LinearNeuron> model;
+	model.setStructure(1,10,1);
+	initRandomNormal(model,0.1);
+	SquaredLoss<> loss;
+	ErrorFunction error(data,&model,&loss);
+	BOOST_REQUIRE(!error.hasSecondDerivative());
+
+	TrustRegionNewton optimizer;
+	optimizer.setHessianFree();
+	optimizer.init(error,model.parameterVector());
+	double initialError = optimizer.solution().value;
+	for(std::size_t i = 0; i != 100; ++i){
+		optimizer.step(error);
+	}
+	std::cout<<"error: "<<initialError<<" -> "<<optimizer.solution().value<<std::endl;
+	BOOST_CHECK_LT(optimizer.solution().value, 0.25 * initialError);
+	BOOST_CHECK_CLOSE(optimizer.solution().value, error.eval(optimizer.solution().point), 1.e-10);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
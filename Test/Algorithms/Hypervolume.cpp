@@ -3,6 +3,8 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/DominanceTestSet.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/utility/functional.h>
 
 #include <shark/Rng/GlobalRng.h>
@@ -281,6 +283,22 @@ BOOST_AUTO_TEST_CASE( Algorithms_ExactHypervolumeMDWFG ) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Algorithms_ExactHypervolumeMDWFG_LargeSets ) {
+	//large enough to use tasks in the recursion
+	HypervolumeCalculatorMDWFG hc;
+	HypervolumeCalculatorMDHOY hoy;
+	const std::size_t numTests = 3;
+	const std::size_t numPoints = 60;
+	
+	for(std::size_t numObj = 4; numObj < 6; ++numObj){
+		RealVector reference(numObj,1.0);
+		for(std::size_t t = 0; t != numTests;++t){
+			std::vector<RealVector> points = createRandomFront(numPoints,numObj,2);
+			BOOST_CHECK_CLOSE(hc(points, reference), hoy(points, reference), 1.e-10);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE( Algorithms_ExactHypervolumeMDApprox ) {
 
 	HypervolumeApproximator hc;
@@ -310,6 +328,51 @@ BOOST_AUTO_TEST_CASE( Algorithms_ExactHypervolumeMDApprox ) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Algorithms_ExactHypervolumeMDApprox_ThreadIndependent ) {
+	HypervolumeApproximator hc;
+	hc.epsilon() = 0.05;
+	hc.delta() = 0.3;
+	RealVector reference(6,1.0);
+	std::vector<RealVector> points = createRandomFront(20,6,2);
+	
+	//the random streams do not depend on the number of threads
+	Rng::seed(42);
+	double hv1 = hc(points, reference);
+#ifdef SHARK_USE_OPENMP
+	int threads = omp_get_max_threads();
+	omp_set_num_threads(3);
+#endif
+	Rng::seed(42);
+	double hv3 = hc(points, reference);
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(threads);
+#endif
+	BOOST_CHECK_EQUAL(hv1, hv3);
+}
+
+BOOST_AUTO_TEST_CASE( Algorithms_DominanceTestSet ) {
+	const std::size_t numPoints = 150;
+	const std::size_t numSamples = 100;
+	for(std::size_t numObj = 2; numObj < 6; ++numObj){
+		std::vector<RealVector> points = createRandomFront(numPoints,numObj,1);
+		DominanceTestSet set(points);
+		BOOST_REQUIRE_EQUAL(set.size(), numPoints);
+		for(std::size_t s = 0; s != numSamples; ++s){
+			RealVector sample(numObj);
+			for(std::size_t j = 0; j != numObj; ++j){
+				sample(j) = Rng::uni(0.0,1.0);
+			}
+			std::size_t count = 0;
+			for(auto const& point: points){
+				if(min(sample - point) >= 0)
+					++count;
+			}
+			BOOST_CHECK_EQUAL(set.countDominating(sample), count);
+			BOOST_CHECK_EQUAL(set.dominates(sample), count > 0);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE( Algorithms_HypervolumeCalculator) {
 	HypervolumeCalculator hc;
 	const std::size_t numTests = 10;
@@ -0,0 +1,109 @@
+#include <shark/Algorithms/Trainers/IncrementalPCA.h>
+#include <shark/Algorithms/Trainers/PCA.h>
+#include <shark/Data/Statistics.h>
+#include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
+
+#define BOOST_TEST_MODULE ALGORITHM_INCREMENTALPCA
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+using namespace std;
+using namespace shark;
+
+///Creates a Gaussian dataset with a few dominant directions and small noise on all others.
+UnlabeledData<RealVector> createData(std::size_t dimensions, std::size_t numberOfExamples, std::size_t batchSize)
+{
+	RealMatrix A(dimensions,dimensions,0.0);
+	diag(A) = blas::repeat(0.01,dimensions);
+	A(0,0) = 5;
+	A(1,1) = 3; A(1,2) = 1;
+	A(2,1) = -1; A(2,2) = 2;
+	A(3,3) = 1;
+	RealMatrix covariance = prod(trans(A),A);
+	MultiVariateNormalDistribution distribution(covariance);
+
+	RealVector mean(dimensions);
+	for(std::size_t i = 0; i != dimensions; ++i)
+		mean(i) = double(i);
+
+	std::vector<RealVector> data(numberOfExamples);
+	for(auto& sample: data)
+	{
+		sample = mean + distribution(Rng::globalRng).first;
+	}
+	return createDataFromRange(data,batchSize);
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_IncrementalPCA)
+
+//if all components are kept, the incremental algorithm is exact
+BOOST_AUTO_TEST_CASE( IncrementalPCA_Full_Rank ){
+	UnlabeledData<RealVector> data = createData(6,1000,37);
+	PCA pca(data);
+
+	IncrementalPCA ipca(6);
+	ipca.update(data);
+	ipca.finalize();
+
+	BOOST_REQUIRE_EQUAL(ipca.numberOfPoints(), 1000);
+	RealVector mean = shark::mean(data);
+	BOOST_CHECK_SMALL(norm_inf(ipca.mean() - mean), 1.e-10);
+	for(std::size_t i = 0; i != 6; ++i){
+		BOOST_CHECK_CLOSE(ipca.eigenvalue(i), pca.eigenvalue(i), 1.e-8);
+		double cosAngle = inner_prod(column(ipca.eigenvectors(),i),column(pca.eigenvectors(),i));
+		BOOST_CHECK_CLOSE(std::abs(cosAngle), 1.0, 1.e-8);
+	}
+}
+
+//updating batch by batch and merging partial decompositions gives the same result
+BOOST_AUTO_TEST_CASE( IncrementalPCA_Merge ){
+	UnlabeledData<RealVector> data = createData(10,2000,50);
+
+	IncrementalPCA streamed(4);
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+		streamed.update(data.batch(b));
+	}
+	streamed.finalize();
+
+	std::size_t half = data.numberOfBatches()/2;
+	IncrementalPCA first(4);
+	IncrementalPCA second(4);
+	first.update(rangeSubset(data,0,half));
+	second.update(rangeSubset(data,half,data.numberOfBatches()));
+	first.merge(second);
+	first.finalize();
+
+	BOOST_REQUIRE_EQUAL(first.numberOfPoints(), 2000);
+	BOOST_CHECK_SMALL(norm_inf(first.mean() - streamed.mean()), 1.e-10);
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_CLOSE(first.eigenvalue(i), streamed.eigenvalue(i), 1.e-3);
+	}
+}
+
+//truncated decomposition approximates the leading components and trains a usable model
+BOOST_AUTO_TEST_CASE( IncrementalPCA_Truncated ){
+	UnlabeledData<RealVector> data = createData(20,2000,100);
+	PCA pca(data);
+
+	IncrementalPCA ipca;
+	ipca.setWhitening(true);
+	LinearModel<> encoder(20,3,true);
+	ipca.train(encoder,data);
+
+	BOOST_REQUIRE_EQUAL(ipca.eigenvalues().size(), 3);
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_CLOSE(ipca.eigenvalue(i), pca.eigenvalue(i), 0.1);
+		double cosAngle = inner_prod(column(ipca.eigenvectors(),i),column(pca.eigenvectors(),i));
+		BOOST_CHECK_CLOSE(std::abs(cosAngle), 1.0, 0.01);
+	}
+
+	//the encoded data is white
+	RealVector emean;
+	RealMatrix ecovar;
+	meanvar(encoder(data), emean, ecovar);
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_SMALL(emean(i), 1.e-8);
+		BOOST_CHECK_CLOSE(ecovar(i,i), 1.0, 0.5);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -272,4 +272,39 @@ BOOST_AUTO_TEST_CASE( PCA_TEST_LESS_DATA_THAN_DIMENSIONS ){
 	}
 }
 
+BOOST_AUTO_TEST_CASE( PCA_TEST_RANDOMIZED ){
+	UnlabeledData<RealVector> data = createData3D();
+
+	PCA exact(data);
+
+	//compute the first two components using the randomized algorithm
+	PCA pca;
+	pca.setAlgorithm(PCA::RANDOMIZED);
+	pca.setRandomizedParameters(0,10);
+	LinearModel<> pcaModel(3,2,true);
+	pca.train(pcaModel,data);
+
+	BOOST_REQUIRE_EQUAL(pca.eigenvalues().size(), 2);
+	BOOST_REQUIRE_EQUAL(pca.eigenvectors().size2(), 2);
+	for(std::size_t i = 0; i != 2; ++i){
+		BOOST_CHECK_CLOSE(pca.eigenvalue(i), exact.eigenvalue(i), 1.e-3);
+		//eigenvectors are only unique up to the sign
+		double cosAngle = inner_prod(column(pca.eigenvectors(),i),column(exact.eigenvectors(),i));
+		BOOST_CHECK_CLOSE(std::abs(cosAngle), 1.0, 1.e-3);
+	}
+
+	//the less data than dimensions case must work as well
+	data = createDataNotFullRank();
+	PCA exactSmall(data);
+	PCA pcaSmall;
+	pcaSmall.setAlgorithm(PCA::RANDOMIZED);
+	pcaSmall.setComponents(3);
+	pcaSmall.setData(data);
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_CLOSE(pcaSmall.eigenvalue(i), exactSmall.eigenvalue(i), 1.e-6);
+		double cosAngle = inner_prod(column(pcaSmall.eigenvectors(),i),column(exactSmall.eigenvectors(),i));
+		BOOST_CHECK_CLOSE(std::abs(cosAngle), 1.0, 1.e-6);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
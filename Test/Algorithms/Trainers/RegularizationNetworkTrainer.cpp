@@ -73,4 +73,53 @@ BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_TEST )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_LOW_RANK_TEST )
+{
+	const std::size_t ell = 500;
+	const double sigma2 = 0.01;
+
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(ell,50);
+
+	GaussianRbfKernel<> kernel(0.5);
+	KernelExpansion<RealVector> exact;
+	RegularizationNetworkTrainer<RealVector> trainer(&kernel, sigma2);
+	trainer.train(exact, training);
+
+	//the low rank model lives on the landmarks and is close to the exact one
+	KernelExpansion<RealVector> lowRank;
+	trainer.setNumberOfLandmarks(100);
+	trainer.train(lowRank, training);
+	BOOST_REQUIRE_EQUAL(lowRank.basis().numberOfElements(), 100);
+
+	Data<RealVector> outputExact = exact(training.inputs());
+	Data<RealVector> outputLowRank = lowRank(training.inputs());
+	for (std::size_t i=0; i<training.numberOfElements(); i++)
+	{
+		BOOST_CHECK_SMALL(outputExact.element(i)(0) - outputLowRank.element(i)(0), 1.e-2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_ITERATIVE_TEST )
+{
+	const std::size_t ell = 300;
+	const double sigma2 = 0.01;
+
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(ell,32);
+
+	GaussianRbfKernel<> kernel(0.5);
+	KernelExpansion<RealVector> exact;
+	RegularizationNetworkTrainer<RealVector> trainer(&kernel, sigma2);
+	trainer.train(exact, training);
+
+	//Jacobi and Nystroem preconditioned conjugate gradients reproduce the Cholesky solution
+	for(std::size_t rank = 0; rank <= 50; rank += 50){
+		KernelExpansion<RealVector> iterative;
+		trainer.setIterativeSolver(true, 1.e-10, rank);
+		trainer.train(iterative, training);
+		BOOST_CHECK_SMALL(norm_inf(exact.alpha() - iterative.alpha()), 1.e-5);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE LinAlg_Conv2d
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/BLAS/kernels/conv2d.hpp>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+using blas::kernels::conv2d_algorithm;
+
+namespace{
+//straight forward implementation of the convolution in the block-row-wise format of the kernel
+RealMatrix referenceConv2d(
+	RealMatrix const& image, RealMatrix const& filter,
+	std::size_t numChannels, std::size_t numFilters
+){
+	std::size_t imageSize1 = image.size1() / numChannels;
+	std::size_t filterSize1 = filter.size1() / (numChannels * numFilters);
+	std::size_t outputSize1 = imageSize1 - filterSize1 + 1;
+	std::size_t outputSize2 = image.size2() - filter.size2() + 1;
+	RealMatrix output(numFilters * outputSize1, outputSize2, 0.0);
+	for(std::size_t f = 0; f != numFilters; ++f){
+		for(std::size_t c = 0; c != numChannels; ++c){
+			for(std::size_t i = 0; i != outputSize1; ++i){
+				for(std::size_t j = 0; j != outputSize2; ++j){
+					for(std::size_t k = 0; k != filterSize1; ++k){
+						for(std::size_t l = 0; l != filter.size2(); ++l){
+							output(f * outputSize1 + i, j) +=
+								image(c * imageSize1 + i + k, j + l)
+								* filter((f * numChannels + c) * filterSize1 + k, l);
+						}
+					}
+				}
+			}
+		}
+	}
+	return output;
+}
+
+//runs every algorithm with the given storage orders and compares it with the reference
+template<class ImageOrientation, class FilterOrientation, class OutputOrientation>
+void checkAlgorithms(
+	std::size_t imageSize1, std::size_t imageSize2,
+	std::size_t filterSize1, std::size_t filterSize2,
+	std::size_t numChannels, std::size_t numFilters
+){
+	RealMatrix image(numChannels * imageSize1, imageSize2);
+	RealMatrix filter(numFilters * numChannels * filterSize1, filterSize2);
+	for(std::size_t i = 0; i != image.size1(); ++i)
+		for(std::size_t j = 0; j != image.size2(); ++j)
+			image(i,j) = Rng::uni(-1,1);
+	for(std::size_t i = 0; i != filter.size1(); ++i)
+		for(std::size_t j = 0; j != filter.size2(); ++j)
+			filter(i,j) = Rng::uni(-1,1);
+	RealMatrix reference = referenceConv2d(image, filter, numChannels, numFilters);
+
+	blas::matrix<double, ImageOrientation> imageArg = image;
+	blas::matrix<double, FilterOrientation> filterArg = filter;
+	conv2d_algorithm algorithms[] = {
+		conv2d_algorithm::automatic, conv2d_algorithm::direct,
+		conv2d_algorithm::gemm, conv2d_algorithm::fft
+	};
+	for(auto algorithm: algorithms){
+		blas::matrix<double, OutputOrientation> output(reference.size1(), reference.size2(), 0.0);
+		blas::kernels::conv2d(imageArg, filterArg, output, numChannels, numFilters, algorithm);
+		BOOST_CHECK_SMALL(max(abs(output - reference)), 1.e-10);
+	}
+}
+
+template<class ImageOrientation, class FilterOrientation, class OutputOrientation>
+void checkSizes(){
+	//odd sizes which do not fit the blocks of the direct kernel or a power of two for the fft
+	checkAlgorithms<ImageOrientation, FilterOrientation, OutputOrientation>(7, 9, 3, 3, 1, 1);
+	checkAlgorithms<ImageOrientation, FilterOrientation, OutputOrientation>(13, 11, 5, 3, 3, 5);
+	checkAlgorithms<ImageOrientation, FilterOrientation, OutputOrientation>(17, 23, 4, 7, 2, 7);
+	checkAlgorithms<ImageOrientation, FilterOrientation, OutputOrientation>(31, 29, 9, 9, 3, 3);
+	//filter covering the whole image, the output is a single pixel
+	checkAlgorithms<ImageOrientation, FilterOrientation, OutputOrientation>(6, 5, 6, 5, 2, 3);
+}
+}
+
+BOOST_AUTO_TEST_SUITE (LinAlg_Conv2d)
+
+BOOST_AUTO_TEST_CASE( LinAlg_Conv2d_RowMajor ){
+	checkSizes<blas::row_major, blas::row_major, blas::row_major>();
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_Conv2d_ColumnMajor ){
+	checkSizes<blas::column_major, blas::column_major, blas::column_major>();
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_Conv2d_MixedOrientation ){
+	checkSizes<blas::column_major, blas::row_major, blas::column_major>();
+	checkSizes<blas::row_major, blas::column_major, blas::row_major>();
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_Conv2d_Selection ){
+	//small filters are cheapest with the direct or gemm kernel, large filters on large images with the fft
+	BOOST_CHECK(blas::kernels::select_conv2d_algorithm<double>(32, 32, 3, 3, 1, 4) != conv2d_algorithm::fft);
+	BOOST_CHECK(blas::kernels::select_conv2d_algorithm<double>(256, 256, 31, 31, 4, 16) == conv2d_algorithm::fft);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
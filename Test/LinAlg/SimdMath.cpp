@@ -0,0 +1,121 @@
+#define BOOST_TEST_MODULE LinAlg_SimdMath
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/BLAS/kernels/default/simd_math.hpp>
+#include <shark/Rng/GlobalRng.h>
+#include <limits>
+#include <cmath>
+
+using namespace shark;
+namespace simd_math = remora::bindings::simd_math;
+
+namespace{
+//relative error in multiples of the machine epsilon
+double relativeError(double x, double reference){
+	if(x == reference) return 0;
+	return std::abs(x - reference) / std::abs(reference) / std::numeric_limits<double>::epsilon();
+}
+}
+
+BOOST_AUTO_TEST_SUITE (LinAlg_SimdMath)
+
+BOOST_AUTO_TEST_CASE( LinAlg_SimdMath_Accuracy ){
+	double maxError[4] = {0,0,0,0};
+	for(std::size_t i = 0; i != 100000; ++i){
+		double x = Rng::uni(-700,700);
+		double y = std::exp(Rng::uni(-700,700));
+		double z = Rng::uni(-20,20);
+		maxError[0] = std::max(maxError[0], relativeError(simd_math::detail::exp(x), std::exp(x)));
+		maxError[1] = std::max(maxError[1], relativeError(simd_math::detail::log(y), std::log(y)));
+		maxError[2] = std::max(maxError[2], relativeError(simd_math::detail::tanh(z), std::tanh(z)));
+		maxError[3] = std::max(maxError[3], relativeError(simd_math::detail::sigmoid(z), 1.0/(1.0 + std::exp(-z))));
+	}
+	for(std::size_t f = 0; f != 4; ++f){
+		BOOST_CHECK_SMALL(maxError[f], 4.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_SimdMath_SpecialValues ){
+	double const inf = std::numeric_limits<double>::infinity();
+	double const nan = std::numeric_limits<double>::quiet_NaN();
+	double const subnormal = 1.e-310;
+
+	BOOST_CHECK_EQUAL(simd_math::detail::exp(0.0), 1.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::exp(-inf), 0.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::exp(inf), inf);
+	BOOST_CHECK_EQUAL(simd_math::detail::exp(710.0), inf);
+	BOOST_CHECK_EQUAL(simd_math::detail::exp(-746.0), 0.0);
+	BOOST_CHECK_SMALL(relativeError(simd_math::detail::exp(-740.0), std::exp(-740.0)), 1.e10);//subnormal result
+	BOOST_CHECK(std::isnan(simd_math::detail::exp(nan)));
+
+	BOOST_CHECK_EQUAL(simd_math::detail::log(1.0), 0.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::log(0.0), -inf);
+	BOOST_CHECK_EQUAL(simd_math::detail::log(inf), inf);
+	BOOST_CHECK_SMALL(relativeError(simd_math::detail::log(subnormal), std::log(subnormal)), 2.0);
+	BOOST_CHECK(std::isnan(simd_math::detail::log(-1.0)));
+	BOOST_CHECK(std::isnan(simd_math::detail::log(nan)));
+
+	BOOST_CHECK_EQUAL(simd_math::detail::tanh(0.0), 0.0);
+	BOOST_CHECK(std::signbit(simd_math::detail::tanh(-0.0)));
+	BOOST_CHECK_EQUAL(simd_math::detail::tanh(inf), 1.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::tanh(-inf), -1.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::tanh(subnormal), subnormal);
+	BOOST_CHECK(std::isnan(simd_math::detail::tanh(nan)));
+
+	BOOST_CHECK_EQUAL(simd_math::detail::sigmoid(0.0), 0.5);
+	BOOST_CHECK_EQUAL(simd_math::detail::sigmoid(inf), 1.0);
+	BOOST_CHECK_EQUAL(simd_math::detail::sigmoid(-inf), 0.0);
+}
+
+//blocks, the remainder and strided arrays must give the same results as the scalar functions
+BOOST_AUTO_TEST_CASE( LinAlg_SimdMath_Apply ){
+	std::size_t n = 37;
+	RealVector x(2 * n);
+	for(std::size_t i = 0; i != x.size(); ++i){
+		x(i) = Rng::uni(-10,10);
+	}
+	RealVector y(n);
+	simd_math::apply(simd_math::tanh_function(), &x(0), 1, &y(0), 1, n);
+	for(std::size_t i = 0; i != n; ++i){
+		BOOST_CHECK_EQUAL(y(i), simd_math::detail::tanh(x(i)));
+	}
+	simd_math::apply(simd_math::exp_function(), &x(0), 2, &y(0), 1, n);
+	for(std::size_t i = 0; i != n; ++i){
+		BOOST_CHECK_EQUAL(y(i), simd_math::detail::exp(x(2 * i)));
+	}
+	//in-place
+	RealVector z = subrange(x, 0, n);
+	simd_math::apply(simd_math::sigmoid_function(), &z(0), 1, &z(0), 1, n);
+	for(std::size_t i = 0; i != n; ++i){
+		BOOST_CHECK_EQUAL(z(i), simd_math::detail::sigmoid(x(i)));
+	}
+}
+
+//the assignment of elementwise functions must agree with the standard library whether or not the kernels are used
+BOOST_AUTO_TEST_CASE( LinAlg_SimdMath_Assignment ){
+	RealMatrix A(13, 21);
+	for(std::size_t i = 0; i != A.size1(); ++i){
+		for(std::size_t j = 0; j != A.size2(); ++j){
+			A(i,j) = Rng::uni(-5,5);
+		}
+	}
+	RealMatrix expA = exp(A);
+	RealMatrix logA = log(abs(A) + 1.0);
+	RealMatrix tanhA = tanh(A);
+	RealMatrix sigmoidA = sigmoid(trans(A));
+	RealVector expColumn = exp(column(A,3));
+	for(std::size_t i = 0; i != A.size1(); ++i){
+		for(std::size_t j = 0; j != A.size2(); ++j){
+			BOOST_CHECK_SMALL(relativeError(expA(i,j), std::exp(A(i,j))), 4.0);
+			BOOST_CHECK_SMALL(relativeError(logA(i,j), std::log(std::abs(A(i,j)) + 1.0)), 4.0);
+			BOOST_CHECK_SMALL(relativeError(tanhA(i,j), std::tanh(A(i,j))), 4.0);
+			//without the kernels, the sigmoid is computed using tanh which loses some digits for negative arguments
+			BOOST_CHECK_SMALL(relativeError(sigmoidA(j,i), 1.0/(1.0 + std::exp(-A(i,j)))), 100.0);
+		}
+		BOOST_CHECK_SMALL(relativeError(expColumn(i), std::exp(A(i,3))), 4.0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
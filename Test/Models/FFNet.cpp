@@ -18,6 +18,18 @@ double activation(double a)
 	return 1.0/(1.0+std::exp(-a));
 }
 
+//user defined neuron which does not provide a second derivative
+struct SoftsignNeuron: public shark::detail::NeuronBase<SoftsignNeuron>{
+	template<class T>
+	T function(T x)const{
+		return x / (1 + std::abs(x));
+	}
+	template<class T>
+	T functionDerivative(T y)const{
+		return sqr(1 - std::abs(y));
+	}
+};
+
 //check that the structure is correct, i.e. matrice have the right form and setting parameters works
 BOOST_AUTO_TEST_SUITE (Models_FFNet)
 
@@ -693,4 +705,116 @@ BOOST_AUTO_TEST_CASE( FFNET_WeightedDerivatives)
 	}
 }
 
+//the state holds workspaces which are reused. Check that reusing a state for batches of
+//different sizes gives the same results as a fresh state.
+BOOST_AUTO_TEST_CASE( FFNET_StateReuse)
+{
+	FFNet<LogisticNeuron,TanhNeuron> net;
+	net.setStructure(3,5,4,2,FFNetStructures::InputOutputShortcut,true);
+	initRandomNormal(net,1);
+	boost::shared_ptr<State> reusedState = net.createState();
+	std::size_t batchSizes[] = {10, 3, 10, 17};
+	for(std::size_t size: batchSizes){
+		RealMatrix inputs(size,3);
+		RealMatrix coefficients(size,2);
+		for(std::size_t i = 0; i != size; ++i){
+			for(std::size_t j = 0; j != 3; ++j)
+				inputs(i,j) = Rng::gauss(0,1);
+			for(std::size_t j = 0; j != 2; ++j)
+				coefficients(i,j) = Rng::gauss(0,1);
+		}
+		boost::shared_ptr<State> freshState = net.createState();
+		RealMatrix outputs, reusedOutputs;
+		net.eval(inputs,outputs,*freshState);
+		net.eval(inputs,reusedOutputs,*reusedState);
+		BOOST_CHECK_SMALL(max(abs(outputs - reusedOutputs)), 1.e-14);
+
+		RealVector gradient, reusedGradient;
+		RealMatrix inputDerivative, reusedInputDerivative;
+		net.weightedDerivatives(inputs,coefficients,*freshState,gradient,inputDerivative);
+		net.weightedDerivatives(inputs,coefficients,*reusedState,reusedGradient,reusedInputDerivative);
+		BOOST_CHECK_SMALL(norm_inf(gradient - reusedGradient), 1.e-14);
+		BOOST_CHECK_SMALL(max(abs(inputDerivative - reusedInputDerivative)), 1.e-14);
+	}
+}
+
+//a single precision network must agree with the double precision network with the same parameters
+BOOST_AUTO_TEST_CASE( FFNET_SinglePrecision)
+{
+	FFNet<LogisticNeuron,TanhNeuron> net;
+	FFNet<LogisticNeuron,TanhNeuron,FloatVector> netFloat;
+	net.setStructure(3,5,4,2,FFNetStructures::InputOutputShortcut,true);
+	netFloat.setStructure(3,5,4,2,FFNetStructures::InputOutputShortcut,true);
+	initRandomNormal(net,1);
+	netFloat.setParameterVector(net.parameterVector());
+	BOOST_REQUIRE_EQUAL(netFloat.numberOfParameters(), net.numberOfParameters());
+	BOOST_CHECK_SMALL(norm_inf(netFloat.parameterVector() - net.parameterVector()), 1.e-6);
+
+	RealMatrix inputs(10,3);
+	RealMatrix coefficients(10,2);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 3; ++j)
+			inputs(i,j) = Rng::gauss(0,1);
+		for(std::size_t j = 0; j != 2; ++j)
+			coefficients(i,j) = Rng::gauss(0,1);
+	}
+	FloatMatrix inputsFloat = inputs;
+	FloatMatrix coefficientsFloat = coefficients;
+
+	boost::shared_ptr<State> state = net.createState();
+	boost::shared_ptr<State> stateFloat = netFloat.createState();
+	RealMatrix outputs;
+	FloatMatrix outputsFloat;
+	net.eval(inputs,outputs,*state);
+	netFloat.eval(inputsFloat,outputsFloat,*stateFloat);
+	BOOST_CHECK_SMALL(max(abs(outputs - outputsFloat)), 1.e-5);
+
+	RealVector gradient, gradientFloat;
+	RealMatrix inputDerivative;
+	FloatMatrix inputDerivativeFloat;
+	net.weightedDerivatives(inputs,coefficients,*state,gradient,inputDerivative);
+	netFloat.weightedDerivatives(inputsFloat,coefficientsFloat,*stateFloat,gradientFloat,inputDerivativeFloat);
+	BOOST_REQUIRE_EQUAL(gradientFloat.size(), gradient.size());
+	BOOST_CHECK_SMALL(norm_inf(gradient - gradientFloat), 1.e-4);
+	BOOST_CHECK_SMALL(max(abs(inputDerivative - inputDerivativeFloat)), 1.e-4);
+}
+
+//networks with neurons without second derivative still compile, but offer no Hessian-vector products
+BOOST_AUTO_TEST_CASE( FFNET_NeuronWithoutSecondDerivative)
+{
+	BOOST_CHECK(HasSecondDerivativeNeuron<LogisticNeuron>::value);
+	BOOST_CHECK(HasSecondDerivativeNeuron<DropoutNeuron<TanhNeuron> >::value);
+	BOOST_CHECK(!HasSecondDerivativeNeuron<SoftsignNeuron>::value);
+	BOOST_CHECK(!HasSecondDerivativeNeuron<DropoutNeuron<SoftsignNeuron> >::value);
+
+	FFNet<SoftsignNeuron,LinearNeuron> net;
+	net.setStructure(3,5,2);
+	initRandomNormal(net,1);
+	BOOST_CHECK(net.hasFirstParameterDerivative());
+	BOOST_CHECK(!net.hasParameterHessianVectorProduct());
+	FFNet<LogisticNeuron,LinearNeuron> secondOrderNet;
+	BOOST_CHECK(secondOrderNet.hasParameterHessianVectorProduct());
+
+	RealMatrix inputs(4,3);
+	RealMatrix coefficients(4,2);
+	for(std::size_t i = 0; i != 4; ++i){
+		for(std::size_t j = 0; j != 3; ++j)
+			inputs(i,j) = Rng::gauss(0,1);
+		for(std::size_t j = 0; j != 2; ++j)
+			coefficients(i,j) = Rng::gauss(0,1);
+	}
+	boost::shared_ptr<State> state = net.createState();
+	RealMatrix outputs;
+	net.eval(inputs,outputs,*state);
+	RealVector gradient;
+	net.weightedParameterDerivative(inputs,coefficients,*state,gradient);
+	BOOST_CHECK_EQUAL(gradient.size(), net.numberOfParameters());
+	RealVector product;
+	typedef AbstractModel<RealVector,RealVector>::FeatureNotAvailableException FeatureNotAvailableException;
+	BOOST_CHECK_THROW(
+		net.weightedParameterHessianVectorProduct(inputs,coefficients,coefficients,gradient,*state,product),
+		FeatureNotAvailableException
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
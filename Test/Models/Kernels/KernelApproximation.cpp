@@ -0,0 +1,118 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       test case for the Nystroem and random Fourier feature maps
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define BOOST_TEST_MODULE Models_KernelApproximation
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Models/Kernels/RandomFourierFeatures.h>
+#include <shark/Models/Kernels/NystromFeatureMap.h>
+#include <shark/Algorithms/Trainers/NystromTrainer.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Data/DataDistribution.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Models_Kernels_KernelApproximation)
+
+BOOST_AUTO_TEST_CASE( RandomFourierFeatures_Approximates_Gaussian )
+{
+	Rng::seed(42);
+	GaussianRbfKernel<> kernel(0.5);
+	RandomFourierFeatures model;
+	model.setStructure(kernel, 3, 20000);
+	BOOST_REQUIRE_EQUAL(model.inputSize(), 3);
+	BOOST_REQUIRE_EQUAL(model.outputSize(), 20000);
+
+	RealMatrix points(10,3);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			points(i,j) = Rng::uni(-1,1);
+		}
+	}
+	RealMatrix features = model(points);
+	RealMatrix approximation = prod(features,trans(features));
+	RealMatrix exact = kernel(points,points);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 10; ++j){
+			BOOST_CHECK_SMALL(approximation(i,j) - exact(i,j), 0.03);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Nystrom_All_Landmarks_Is_Exact )
+{
+	Rng::seed(42);
+	Chessboard problem;
+	UnlabeledData<RealVector> data = problem.generateDataset(30,8).inputs();
+	GaussianRbfKernel<> kernel(0.5);
+
+	NystromFeatureMap<RealVector> model(&kernel, data);
+	Data<RealVector> features = model(data);
+	RealMatrix phi = createBatch<RealVector>(features.elements());
+	RealMatrix approximation = prod(phi,trans(phi));
+	RealMatrix exact = calculateRegularizedKernelMatrix(kernel, data, 0.0);
+	for(std::size_t i = 0; i != 30; ++i){
+		for(std::size_t j = 0; j != 30; ++j){
+			BOOST_CHECK_SMALL(approximation(i,j) - exact(i,j), 1.e-6);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Nystrom_Landmark_Selection )
+{
+	Rng::seed(42);
+	Chessboard problem;
+	UnlabeledData<RealVector> data = problem.generateDataset(200,32).inputs();
+	GaussianRbfKernel<> kernel(0.5);
+	RealMatrix exact = calculateRegularizedKernelMatrix(kernel, data, 0.0);
+
+	NystromTrainer<RealVector> trainer(&kernel, 40);
+	for(std::size_t s = 0; s != 2; ++s){
+		if(s == 1){
+			trainer.setLandmarkSelection(NystromTrainer<RealVector>::LEVERAGE_SCORES);
+		}
+		NystromFeatureMap<RealVector> model;
+		trainer.train(model, data);
+		BOOST_REQUIRE_EQUAL(model.landmarks().numberOfElements(), 40);
+		BOOST_CHECK(model.outputSize() <= 40);
+
+		//the approximation is exact on the landmarks and good on average elsewhere
+		RealMatrix phi = createBatch<RealVector>(model(data).elements());
+		RealMatrix approximation = prod(phi,trans(phi));
+		double error = norm_frobenius(approximation - exact) / norm_frobenius(exact);
+		BOOST_CHECK_SMALL(error, 0.05);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
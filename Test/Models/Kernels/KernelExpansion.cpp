@@ -178,4 +178,40 @@ BOOST_AUTO_TEST_CASE( KERNEL_EXPANSION_SERIALIZATION )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( KERNEL_EXPANSION_REDUCE_BASIS )
+{
+	Rng::seed(42);
+	std::vector<RealVector> points(100,RealVector(3));
+	for(std::size_t i = 0; i != 100; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			points[i](j) = Rng::gauss(0,1);
+		}
+	}
+	DenseRbfKernel kernel(0.5);
+	KernelExpansion<RealVector> ex(&kernel, createDataFromRange(points,16), true, 2);
+	//only every 4th basis vector has non-zero coefficients
+	for(std::size_t i = 0; i != 100; i += 4){
+		ex.alpha(i,0) = Rng::gauss(0,1);
+		ex.alpha(i,1) = Rng::gauss(0,1);
+	}
+	ex.offset(0) = 1.0;
+	ex.offset(1) = -1.0;
+	Data<RealVector> inputs = createDataFromRange(points,16);
+	Data<RealVector> before = ex(inputs);
+
+	//the projection on the support vectors is exact
+	ex.reduceBasis(25);
+	BOOST_REQUIRE_EQUAL(ex.basis().numberOfElements(), 25);
+	BOOST_REQUIRE_EQUAL(ex.alpha().size1(), 25);
+	Data<RealVector> after = ex(inputs);
+	for(std::size_t i = 0; i != 100; ++i){
+		BOOST_CHECK_SMALL(norm_inf(before.element(i) - after.element(i)), 1.e-6);
+	}
+
+	//a smaller basis gives an approximation
+	ex.reduceBasis(10);
+	BOOST_REQUIRE_EQUAL(ex.basis().numberOfElements(), 10);
+	BOOST_CHECK_EQUAL(ex(inputs).element(0).size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       test case for the KernelExpansionPredictor
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define BOOST_TEST_MODULE MODELS_KERNEL_EXPANSION_PREDICTOR
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Models/Kernels/KernelExpansionPredictor.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/PolynomialKernel.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Models/Kernels/ArdKernel.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <sstream>
+
+using namespace shark;
+
+namespace{
+RealMatrix randomPoints(std::size_t n, std::size_t dim){
+	RealMatrix points(n,dim);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != dim; ++j){
+			points(i,j) = Rng::gauss(0,1);
+		}
+	}
+	return points;
+}
+
+//compares predictor and expansion on batches of different sizes
+void checkPredictor(AbstractKernelFunction<RealVector>* kernel, bool offset){
+	RealMatrix basisPoints = randomPoints(1100,5);
+	std::vector<RealVector> basis(basisPoints.size1());
+	for(std::size_t i = 0; i != basis.size(); ++i){
+		basis[i] = row(basisPoints,i);
+	}
+	KernelExpansion<RealVector> expansion(kernel, createDataFromRange(basis,100), offset, 3);
+	for(std::size_t i = 0; i != basis.size(); ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			expansion.alpha(i,j) = Rng::gauss(0,1);
+		}
+	}
+	if(offset){
+		expansion.offset(0) = 1.0;
+		expansion.offset(2) = -2.0;
+	}
+
+	KernelExpansionPredictor predictor(expansion);
+	predictor.setTileSize(256);
+	BOOST_REQUIRE_EQUAL(predictor.inputSize(), 5);
+	BOOST_REQUIRE_EQUAL(predictor.outputSize(), 3);
+
+	std::size_t sizes[] = {1, 7, 200};
+	for(std::size_t s = 0; s != 3; ++s){
+		RealMatrix patterns = randomPoints(sizes[s],5);
+		RealMatrix expected = expansion(patterns);
+		RealMatrix result = predictor(patterns);
+		BOOST_REQUIRE_EQUAL(result.size1(), sizes[s]);
+		BOOST_CHECK_SMALL(norm_inf(result - expected) / (1.0 + norm_inf(expected)), 1.e-10);
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE (Models_Kernels_KernelExpansionPredictor)
+
+BOOST_AUTO_TEST_CASE( KernelExpansionPredictor_Gaussian )
+{
+	Rng::seed(42);
+	GaussianRbfKernel<> kernel(0.3);
+	checkPredictor(&kernel, true);
+	checkPredictor(&kernel, false);
+}
+
+BOOST_AUTO_TEST_CASE( KernelExpansionPredictor_Polynomial )
+{
+	Rng::seed(42);
+	PolynomialKernel<> kernel(3, 1.5);
+	checkPredictor(&kernel, true);
+}
+
+BOOST_AUTO_TEST_CASE( KernelExpansionPredictor_Linear )
+{
+	Rng::seed(42);
+	LinearKernel<> kernel;
+	checkPredictor(&kernel, true);
+}
+
+BOOST_AUTO_TEST_CASE( KernelExpansionPredictor_Unsupported )
+{
+	ARDKernelUnconstrained<> kernel(5);
+	KernelExpansion<RealVector> expansion(&kernel);
+	BOOST_CHECK_THROW(KernelExpansionPredictor predictor(expansion), Exception);
+}
+
+BOOST_AUTO_TEST_CASE( KernelExpansionPredictor_Serialization )
+{
+	Rng::seed(42);
+	GaussianRbfKernel<> kernel(0.3);
+	std::vector<RealVector> basis(10,RealVector(2));
+	for(std::size_t i = 0; i != 10; ++i){
+		basis[i](0) = Rng::gauss(0,1);
+		basis[i](1) = Rng::gauss(0,1);
+	}
+	KernelExpansion<RealVector> expansion(&kernel, createDataFromRange(basis), true, 1);
+	for(std::size_t i = 0; i != 10; ++i){
+		expansion.alpha(i,0) = Rng::gauss(0,1);
+	}
+	KernelExpansionPredictor predictor(expansion);
+
+	std::stringstream ss;
+	{
+		TextOutArchive oa(ss);
+		oa << const_cast<KernelExpansionPredictor const&>(predictor);
+	}
+	KernelExpansionPredictor predictor2;
+	{
+		TextInArchive ia(ss);
+		ia >> predictor2;
+	}
+	RealMatrix patterns = randomPoints(5,2);
+	RealMatrix result = predictor(patterns);
+	RealMatrix result2 = predictor2(patterns);
+	BOOST_CHECK_SMALL(norm_inf(result - result2), 1.e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -122,4 +122,64 @@ BOOST_AUTO_TEST_CASE(WeightedDerivatives_Multiple)
 	testWeightedDerivative(net,1000,5.e-6,1.e-7);
 }
 
+//several streams advanced together must give the same results as the streams processed one by one
+//truncated BPTT with a window covering the whole sequence must give the RTRL gradient
+BOOST_AUTO_TEST_CASE(MultipleStreams)
+{
+	const std::size_t streams = 5;
+	const std::size_t T = 6;
+	RecurrentStructure structure;
+	structure.setStructure(2,4,2,true,RecurrentStructure::Tanh);
+	RealVector parameters(structure.parameters());
+	for(std::size_t i = 0; i != parameters.size(); ++i){
+		parameters(i) = Rng::gauss(0,0.5);
+	}
+	structure.setParameterVector(parameters);
+	OnlineRNNet rtrl(&structure,true);
+	OnlineRNNet truncated(&structure,true);
+	truncated.setTruncation(T);
+	BOOST_CHECK_EQUAL(truncated.truncation(),T);
+	
+	boost::shared_ptr<State> rtrlState = rtrl.createState();
+	boost::shared_ptr<State> truncatedState = truncated.createState();
+	std::vector<boost::shared_ptr<State> > singleStates(streams);
+	for(std::size_t k = 0; k != streams; ++k){
+		singleStates[k] = rtrl.createState();
+	}
+	for(std::size_t t = 0; t != T; ++t){
+		RealMatrix inputs(streams,2);
+		RealMatrix coefficients(streams,2);
+		for(std::size_t k = 0; k != streams; ++k){
+			for(std::size_t j = 0; j != 2; ++j){
+				inputs(k,j) = Rng::gauss(0,1);
+				coefficients(k,j) = Rng::gauss(0,1);
+			}
+		}
+		RealMatrix outputs;
+		RealMatrix truncatedOutputs;
+		rtrl.eval(inputs,outputs,*rtrlState);
+		truncated.eval(inputs,truncatedOutputs,*truncatedState);
+		BOOST_REQUIRE_EQUAL(outputs.size1(),streams);
+		RealVector gradient;
+		RealVector truncatedGradient;
+		rtrl.weightedParameterDerivative(inputs,coefficients,*rtrlState,gradient);
+		truncated.weightedParameterDerivative(inputs,coefficients,*truncatedState,truncatedGradient);
+		
+		RealVector testGradient(parameters.size(),0.0);
+		for(std::size_t k = 0; k != streams; ++k){
+			RealMatrix singleInput = rows(inputs,k,k+1);
+			RealMatrix singleCoefficients = rows(coefficients,k,k+1);
+			RealMatrix singleOutput;
+			rtrl.eval(singleInput,singleOutput,*singleStates[k]);
+			BOOST_CHECK_SMALL(norm_inf(row(singleOutput,0)-row(outputs,k)),1.e-12);
+			BOOST_CHECK_SMALL(norm_inf(row(truncatedOutputs,k)-row(outputs,k)),1.e-12);
+			RealVector singleGradient;
+			rtrl.weightedParameterDerivative(singleInput,singleCoefficients,*singleStates[k],singleGradient);
+			testGradient += singleGradient;
+		}
+		BOOST_CHECK_SMALL(norm_inf(gradient-testGradient),1.e-10);
+		BOOST_CHECK_SMALL(norm_inf(gradient-truncatedGradient),1.e-10);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -212,6 +212,122 @@ BOOST_AUTO_TEST_CASE( RNNET_WEIGHTED_PARAMETER_DERIVATIVE ){
 
 }
 
+//sequences of different lengths are processed in blocks, the results must be the same as for single sequences
+BOOST_AUTO_TEST_CASE( RNNET_BATCH_OF_SEQUENCES ){
+	RecurrentStructure netStruct;
+	netStruct.setStructure(2,4,2);
+	RNNet net(&netStruct);
+
+	RealVector parameters(numberOfParameters);
+	for(size_t i=0;i!=numberOfParameters;++i){
+		parameters(i)= Rng::gauss(0,1);
+	}
+	net.setParameterVector(parameters);
+	Sequence warmUp(2,RealVector(2,0.5));
+	net.setWarmUpSequence(warmUp);
+
+	//200 sequences of 4 different lengths, more than fit into one block
+	std::vector<Sequence> inputs(200);
+	std::vector<Sequence> coefficients(200);
+	for(size_t b = 0; b != inputs.size(); ++b){
+		size_t length = 3 + b % 4;
+		inputs[b].resize(length,RealVector(2));
+		coefficients[b].resize(length,RealVector(2));
+		for(size_t t = 0; t != length; ++t){
+			for(size_t j=0;j!=2;++j){
+				inputs[b][t](j) = Rng::gauss(0,1);
+				coefficients[b][t](j) = Rng::gauss(0,1);
+			}
+		}
+	}
+	boost::shared_ptr<State> state = net.createState();
+	std::vector<Sequence> outputs;
+	net.eval(inputs,outputs,*state);
+	RealVector derivative;
+	net.weightedParameterDerivative(inputs,coefficients,*state,derivative);
+	BOOST_REQUIRE_EQUAL(outputs.size(),inputs.size());
+
+	RealVector testDerivative(numberOfParameters,0.0);
+	for(size_t b = 0; b != inputs.size(); ++b){
+		std::vector<Sequence> singleInput(1,inputs[b]);
+		std::vector<Sequence> singleCoefficients(1,coefficients[b]);
+		std::vector<Sequence> singleOutput;
+		boost::shared_ptr<State> singleState = net.createState();
+		net.eval(singleInput,singleOutput,*singleState);
+		BOOST_REQUIRE_EQUAL(outputs[b].size(),inputs[b].size());
+		for(size_t t = 0; t != inputs[b].size(); ++t){
+			BOOST_CHECK_SMALL(norm_2(outputs[b][t]-singleOutput[0][t]),1.e-12);
+		}
+		RealVector singleDerivative;
+		net.weightedParameterDerivative(singleInput,singleCoefficients,*singleState,singleDerivative);
+		testDerivative += singleDerivative;
+	}
+	BOOST_CHECK_SMALL(norm_inf(derivative-testDerivative),1.e-10);
+}
+
+//truncated BPTT with a window spanning the whole sequence is exact, with window length 1
+//only the direct dependency of the output on the weights remains
+BOOST_AUTO_TEST_CASE( RNNET_TRUNCATED_BPTT ){
+	const size_t T=6;
+	RecurrentStructure netStruct;
+	netStruct.setStructure(2,4,2);
+	RNNet net(&netStruct);
+
+	RealVector parameters(numberOfParameters);
+	for(size_t i=0;i!=numberOfParameters;++i){
+		parameters(i)= Rng::gauss(0,1);
+	}
+	net.setParameterVector(parameters);
+
+	std::vector<Sequence> inputs(1,Sequence(T,RealVector(2)));
+	std::vector<Sequence> coefficients(1,Sequence(T,RealVector(2)));
+	for (size_t t = 0; t < T; t++){
+		for(size_t j=0;j!=2;++j){
+			inputs[0][t](j) = Rng::gauss(0,1);
+			coefficients[0][t](j) = Rng::gauss(0,1);
+		}
+	}
+	boost::shared_ptr<State> state = net.createState();
+	std::vector<Sequence> outputs;
+	net.eval(inputs,outputs,*state);
+	RealVector exact;
+	net.weightedParameterDerivative(inputs,coefficients,*state,exact);
+
+	net.setTruncation(T);
+	BOOST_CHECK_EQUAL(net.truncation(),T);
+	RealVector window;
+	net.weightedParameterDerivative(inputs,coefficients,*state,window);
+	BOOST_CHECK_SMALL(norm_inf(exact-window),1.e-12);
+
+	//with window length 1, the gradient is the sum of the one step derivatives
+	//given the activations of the previous time step
+	net.setTruncation(1);
+	RealVector truncated;
+	net.weightedParameterDerivative(inputs,coefficients,*state,truncated);
+	RealMatrix weightGradient(6,9,0.0);
+	RealVector previous(9,0.0);
+	for(size_t t = 0; t != T; ++t){
+		subrange(previous,0,2) = inputs[0][t];
+		previous(2) = 1;
+		RealVector delta(6,0.0);
+		for(size_t i = 0; i != 2; ++i){
+			double y = outputs[0][t](i);
+			delta(4+i) = coefficients[0][t](i) * y * (1-y);
+		}
+		weightGradient += outer_prod(delta,previous);
+		//activations of the neurons for the next time step
+		RealVector neurons = prod(netStruct.weights(),previous);
+		for(size_t i = 0; i != 6; ++i){
+			previous(i+3) = 1.0/(1.0+std::exp(-neurons(i)));
+		}
+	}
+	for(size_t i = 0; i != 6; ++i){
+		for(size_t j = 0; j != 9; ++j){
+			BOOST_CHECK_SMALL(truncated(i*9+j)-weightGradient(i,j),1.e-12);
+		}
+	}
+}
+
 //~ BOOST_AUTO_TEST_CASE( RNNET_SERIALIZATION_TEST)
 //~ {
 	//~ std::stringstream str;
@@ -126,4 +126,30 @@ BOOST_AUTO_TEST_CASE( CROSSENTROPY_DERIVATIVES_MULTI_CLASS ){
 	}
 }
 
+//single precision predictions must give the same loss and derivative as double precision up to rounding
+BOOST_AUTO_TEST_CASE( CROSSENTROPY_SINGLE_PRECISION ){
+	CrossEntropy loss;
+	BasicCrossEntropy<FloatVector> lossFloat;
+	std::size_t classes[] = {1, 5};
+	for(std::size_t c: classes){
+		RealMatrix predictions(20,c);
+		UIntVector labels(20);
+		for(std::size_t i = 0; i != 20; ++i){
+			for(std::size_t j = 0; j != c; ++j){
+				predictions(i,j) = (float)Rng::uni(-10.0,10.0);
+			}
+			labels(i) = Rng::discrete(0,std::max<std::size_t>(c,2)-1);
+		}
+		FloatMatrix predictionsFloat = predictions;
+
+		RealMatrix derivative;
+		FloatMatrix derivativeFloat;
+		double value = loss.evalDerivative(labels, predictions, derivative);
+		double valueFloat = lossFloat.evalDerivative(labels, predictionsFloat, derivativeFloat);
+		BOOST_CHECK_CLOSE(value, valueFloat, 1.e-4);
+		BOOST_CHECK_CLOSE(lossFloat.eval(labels, predictionsFloat), valueFloat, 1.e-4);
+		BOOST_CHECK_SMALL(max(abs(derivative - derivativeFloat)), 1.e-5);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
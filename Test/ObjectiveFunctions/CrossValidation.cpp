@@ -37,6 +37,10 @@
 #include <shark/Algorithms/Trainers/LinearRegression.h>
 #include <shark/ObjectiveFunctions/CrossValidationError.h>
 #include <shark/ObjectiveFunctions/Loss/AbsoluteLoss.h>
+#include <shark/Algorithms/DirectSearch/GridSearch.h>
+#include <shark/Algorithms/Trainers/OptimizationTrainer.h>
+#include <shark/Algorithms/GradientDescent/Rprop.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
 #include <shark/Data/Dataset.h>
 
 #define BOOST_TEST_MODULE ObjectiveFunctions_CrossValidation
@@ -45,6 +49,18 @@
 using namespace shark;
 
 
+namespace{
+// Linear regression which refuses to train with a large regularization.
+class FailingLinearRegression: public LinearRegression{
+public:
+	void train(LinearModel<>& model, RegressionDataset const& dataset){
+		if(regularization() > 50.0)
+			throw SHARKEXCEPTION("regularization too large");
+		LinearRegression::train(model, dataset);
+	}
+};
+}
+
 // This test case judges a linear regression of data
 // *not* on a line by means of cross-validation. In
 // this very simple case the error can be computed
@@ -90,4 +106,143 @@ BOOST_AUTO_TEST_CASE( ObjectiveFunctions_CrossValidation )
 	BOOST_CHECK_LT(std::abs(cve - 5.0 / 3.0), 1e-12);
 }
 
+// The folds are distributed over several workers. The result and the
+// point chosen by a grid search must not change.
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_CrossValidation_Workers )
+{
+	std::vector<RealVector> data(50,RealVector(3));
+	std::vector<RealVector> target(50,RealVector(1));
+	for (std::size_t i=0; i != 50; i++)
+	{
+		for(std::size_t j = 0; j != 3; ++j)
+			data[i](j) = Rng::gauss(0,1);
+		target[i](0) = data[i](0) - 2 * data[i](2) + Rng::gauss(0,0.5);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(data, target, 10);
+	CVFolds<RegressionDataset> folds = createCVSameSize(dataset, 5);
+	AbsoluteLoss<> loss;
+
+	LinearModel<> lin(3, 1, true);
+	LinearRegression trainer;
+	CrossValidationError<LinearModel<> > cvError(folds, &trainer, &lin, &trainer, &loss);
+	BOOST_CHECK(!cvError.isThreadSafe());
+
+	std::vector<LinearModel<> > models(3, LinearModel<>(3, 1, true));
+	std::vector<LinearRegression> trainers(3);
+	CrossValidationError<LinearModel<> > parallelError(folds, &trainer, &lin, &trainer, &loss);
+	for(std::size_t i = 0; i != 3; ++i)
+		parallelError.addWorker(&trainers[i], &models[i], &trainers[i]);
+	BOOST_CHECK_EQUAL(parallelError.numberOfWorkers(), 4u);
+	BOOST_CHECK(parallelError.isThreadSafe());
+
+	for(std::size_t i = 0; i != 5; ++i){
+		RealVector param(1, 10.0 * i);
+		BOOST_CHECK_EQUAL(cvError.eval(param), parallelError.eval(param));
+	}
+
+	GridSearch grid;
+	grid.configure(1, 0.0, 100.0, 21);
+	grid.init(cvError, RealVector(1,0.0));
+	grid.step(cvError);
+	GridSearch parallelGrid;
+	parallelGrid.configure(1, 0.0, 100.0, 21);
+	parallelGrid.init(parallelError, RealVector(1,0.0));
+	parallelGrid.step(parallelError);
+	BOOST_CHECK_EQUAL(grid.solution().value, parallelGrid.solution().value);
+	BOOST_CHECK_EQUAL(grid.solution().point(0), parallelGrid.solution().point(0));
+}
+
+// Exceptions thrown while the folds or grid points are evaluated in parallel
+// reach the caller.
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_CrossValidation_Workers_Exception )
+{
+	std::vector<RealVector> data(50,RealVector(3));
+	std::vector<RealVector> target(50,RealVector(1));
+	for (std::size_t i=0; i != 50; i++)
+	{
+		for(std::size_t j = 0; j != 3; ++j)
+			data[i](j) = Rng::gauss(0,1);
+		target[i](0) = data[i](0) - 2 * data[i](2) + Rng::gauss(0,0.5);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(data, target, 10);
+	CVFolds<RegressionDataset> folds = createCVSameSize(dataset, 5);
+	AbsoluteLoss<> loss;
+
+	LinearModel<> lin(3, 1, true);
+	FailingLinearRegression trainer;
+	std::vector<LinearModel<> > models(3, LinearModel<>(3, 1, true));
+	std::vector<FailingLinearRegression> trainers(3);
+	CrossValidationError<LinearModel<> > parallelError(folds, &trainer, &lin, &trainer, &loss);
+	for(std::size_t i = 0; i != 3; ++i)
+		parallelError.addWorker(&trainers[i], &models[i], &trainers[i]);
+
+	BOOST_CHECK_THROW(parallelError.eval(RealVector(1, 100.0)), Exception);
+	//all workers are released again
+	BOOST_CHECK_NO_THROW(parallelError.eval(RealVector(1, 10.0)));
+
+	GridSearch grid;
+	grid.configure(1, 0.0, 100.0, 21);
+	grid.init(parallelError, RealVector(1,0.0));
+	BOOST_CHECK_THROW(grid.step(parallelError), Exception);
+}
+
+// Evaluations with a budget use fewer folds, less training data or fewer iterations.
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_CrossValidation_Budget )
+{
+	std::vector<RealVector> data(50,RealVector(3));
+	std::vector<RealVector> target(50,RealVector(1));
+	for (std::size_t i=0; i != 50; i++)
+	{
+		for(std::size_t j = 0; j != 3; ++j)
+			data[i](j) = Rng::gauss(0,1);
+		target[i](0) = data[i](0) - 2 * data[i](2) + Rng::gauss(0,0.5);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(data, target, 5);
+	CVFolds<RegressionDataset> folds = createCVSameSize(dataset, 5);
+	AbsoluteLoss<> loss;
+	LinearModel<> lin(3, 1, true);
+	LinearRegression trainer;
+	RealVector param(1, 1.0);
+	trainer.setParameterVector(param);
+	CrossValidationError<LinearModel<> > cvError(folds, &trainer, &lin, &trainer, &loss);
+
+	//first two folds
+	double foldError = 0;
+	for(std::size_t i = 0; i != 2; ++i){
+		trainer.train(lin, folds.training(i));
+		foldError += loss.eval(folds.validation(i).labels(), lin(folds.validation(i).inputs()));
+	}
+	BOOST_CHECK_CLOSE(cvError.evalBudgeted(param, 0.4), foldError / 2, 1.e-10);
+
+	//first half of the batches of every training set
+	cvError.setBudgetType(cvError.TrainingData);
+	double dataError = 0;
+	for(std::size_t i = 0; i != 5; ++i){
+		RegressionDataset training = folds.training(i);
+		trainer.train(lin, rangeSubset(training, 0, training.numberOfBatches() / 2));
+		dataError += loss.eval(folds.validation(i).labels(), lin(folds.validation(i).inputs()));
+	}
+	BOOST_CHECK_CLOSE(cvError.evalBudgeted(param, 0.5), dataError / 5, 1.e-10);
+	BOOST_CHECK_CLOSE(cvError.evalBudgeted(param, 1.0), cvError.eval(param), 1.e-10);
+
+	//iterations of a gradient based trainer
+	SquaredLoss<> squaredLoss;
+	IRpropPlus optimizer;
+	IParameterizable meta;
+	MaxIterations<> iterations(1);
+	OptimizationTrainer<LinearModel<> > optimizationTrainer(&squaredLoss, &optimizer, &iterations);
+	LinearModel<> budgetedModel(3, 1, true);
+	CrossValidationError<LinearModel<> > budgetedError(folds, &meta, &budgetedModel, &optimizationTrainer, &loss);
+	budgetedError.setIterationBudget(10, &iterations);
+
+	MaxIterations<> fixedIterations(3);
+	OptimizationTrainer<LinearModel<> > fixedTrainer(&squaredLoss, &optimizer, &fixedIterations);
+	LinearModel<> fixedModel(3, 1, true);
+	CrossValidationError<LinearModel<> > fixedError(folds, &meta, &fixedModel, &fixedTrainer, &loss);
+
+	BOOST_CHECK_EQUAL(budgetedError.evalBudgeted(RealVector(), 0.3), fixedError.eval(RealVector()));
+	fixedIterations.setMaxIterations(10);
+	BOOST_CHECK_EQUAL(budgetedError.eval(RealVector()), fixedError.eval(RealVector()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,10 +1,14 @@
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
+#include <shark/ObjectiveFunctions/Regularizer.h>
 #include <shark/ObjectiveFunctions/ErrorFunction.h>
 #include <shark/Algorithms/Trainers/LinearRegression.h>
 #include <shark/Algorithms/GradientDescent/Rprop.h>
 #include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
 #include <shark/Rng/Uniform.h>
 #include <shark/Data/DataDistribution.h>
+#include <shark/Models/FFNet.h>
+#include <shark/Core/OpenMP.h>
 
 #define BOOST_TEST_MODULE ObjFunct_ErrorFunction
 #include <boost/test/unit_test.hpp>
@@ -12,6 +16,16 @@
 
 using namespace shark;
 
+//simulates the reduction of two processes: adds the buffer of the other process
+class TwoProcessReducer : public AbstractReducer{
+public:
+	RealVector otherBuffer;
+	void allReduce(RealVector& buffer){
+		SIZE_CHECK(buffer.size() == otherBuffer.size());
+		buffer += otherBuffer;
+	}
+};
+
 class TestModel : public AbstractModel<RealVector,RealVector>
 {
 private:
@@ -66,6 +80,27 @@ public:
 };
 
 
+//compares the hessian vector product with central differences of the gradient in the direction
+void checkHessianVectorProduct(ErrorFunction& error, RealVector const& point){
+	BOOST_REQUIRE(error.hasHessianVectorProduct());
+	double epsilon = 1.e-5;
+	for(std::size_t trial = 0; trial != 3; ++trial){
+		RealVector direction(point.size());
+		for(std::size_t i = 0; i != direction.size(); ++i){
+			direction(i) = Rng::gauss(0,1);
+		}
+		RealVector product;
+		error.evalHessianVectorProduct(point, direction, product);
+		ErrorFunction::FirstOrderDerivative derivative1;
+		ErrorFunction::FirstOrderDerivative derivative2;
+		error.evalDerivative(point + epsilon * direction, derivative1);
+		error.evalDerivative(point - epsilon * direction, derivative2);
+		RealVector estimate = (derivative1 - derivative2) / (2 * epsilon);
+		BOOST_REQUIRE_EQUAL(product.size(), point.size());
+		BOOST_CHECK_SMALL(norm_inf(product - estimate) / (1 + norm_inf(estimate)), 1.e-6);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE (ObjectiveFunctions_ErrorFunction)
 
 BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_BASE )
@@ -260,4 +295,197 @@ BOOST_AUTO_TEST_CASE( ObjFunct_WeightedErrorFunction_LinearRegression )
 	BOOST_CHECK_SMALL(norm_sqr(unWDerivative - WDerivative),1.e-8);
 }
 
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_Deterministic_Reduction )
+{
+	Wave problem;
+	RegressionDataset data = problem.generateDataset(1000,10);
+	//uneven batch sizes
+	std::vector<std::size_t> sizes;
+	for(std::size_t i = 0; i != 20; ++i)
+		sizes.push_back(i % 2 == 0? 80 : 20);
+	data.repartition(sizes);
+
+	FFNet<LogisticNeuron,LinearNeuron> model;
+	model.setStructure(1,10,1);
+	initRandomNormal(model,1);
+	SquaredLoss<> loss;
+	ErrorFunction error(data,&model,&loss);
+	RealVector point = model.parameterVector();
+
+#ifdef SHARK_USE_OPENMP
+	int threads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	ErrorFunction::FirstOrderDerivative derivative1;
+	double value1 = error.evalDerivative(point,derivative1);
+	double valueNoDerivative1 = error.eval(point);
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(3);
+#endif
+	ErrorFunction::FirstOrderDerivative derivative3;
+	double value3 = error.evalDerivative(point,derivative3);
+	double valueNoDerivative3 = error.eval(point);
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(threads);
+#endif
+
+	//results are bitwise identical
+	BOOST_CHECK_EQUAL(value1, value3);
+	BOOST_CHECK_EQUAL(valueNoDerivative1, valueNoDerivative3);
+	for(std::size_t i = 0; i != derivative1.size(); ++i){
+		BOOST_CHECK_EQUAL(derivative1(i), derivative3(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_Structure_Change )
+{
+	//the cached model states must not be reused after the structure of the model changed
+	Wave problem;
+	RegressionDataset data = problem.generateDataset(200,20);
+	FFNet<LogisticNeuron,LinearNeuron> model;
+	model.setStructure(1,5,1);
+	initRandomNormal(model,1);
+	SquaredLoss<> loss;
+	ErrorFunction error(data,&model,&loss);
+	ErrorFunction::FirstOrderDerivative derivative;
+	error.evalDerivative(model.parameterVector(),derivative);
+
+	model.setStructure(1,20,1);
+	initRandomNormal(model,1);
+	ErrorFunction fresh(data,&model,&loss);
+	RealVector point = model.parameterVector();
+	ErrorFunction::FirstOrderDerivative freshDerivative;
+	double freshValue = fresh.evalDerivative(point,freshDerivative);
+	double value = error.evalDerivative(point,derivative);
+	BOOST_CHECK_EQUAL(value, freshValue);
+	BOOST_REQUIRE_EQUAL(derivative.size(), freshDerivative.size());
+	BOOST_CHECK_SMALL(norm_inf(derivative - freshDerivative), 1.e-15);
+
+	//after init, the states are created again as well
+	error.init();
+	BOOST_CHECK_EQUAL(error.evalDerivative(point,derivative), freshValue);
+	BOOST_CHECK_EQUAL(error.evaluationCounter(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_Reducer )
+{
+	Wave problem;
+	RegressionDataset data = problem.generateDataset(300,50);
+	RegressionDataset part1 = rangeSubset(data,0,2);
+	RegressionDataset part2 = rangeSubset(data,2,6);
+
+	FFNet<LogisticNeuron,LinearNeuron> model;
+	model.setStructure(1,5,1);
+	initRandomNormal(model,1);
+	SquaredLoss<> loss;
+	RealVector point = model.parameterVector();
+	ErrorFunction fullError(data,&model,&loss);
+	ErrorFunction::FirstOrderDerivative fullDerivative;
+	double fullValue = fullError.evalDerivative(point, fullDerivative);
+
+	//the buffer of the second process: weight, error sum and gradient sum
+	ErrorFunction error2(part2,&model,&loss);
+	ErrorFunction::FirstOrderDerivative derivative2;
+	double value2 = error2.evalDerivative(point, derivative2);
+	TwoProcessReducer reducer;
+	reducer.otherBuffer.resize(derivative2.size() + 2);
+	reducer.otherBuffer(0) = 200;
+	reducer.otherBuffer(1) = 200 * value2;
+	noalias(subrange(reducer.otherBuffer,2,derivative2.size() + 2)) = 200 * derivative2;
+
+	ErrorFunction error1(part1,&model,&loss);
+	error1.setReducer(&reducer);
+	ErrorFunction::FirstOrderDerivative derivative;
+	double value = error1.evalDerivative(point, derivative);
+	BOOST_CHECK_CLOSE(value, fullValue, 1.e-10);
+	BOOST_CHECK_SMALL(norm_inf(derivative - fullDerivative), 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_HessianVectorProduct_Regression )
+{
+	Wave problem;
+	RegressionDataset data = problem.generateDataset(100,25);
+	SquaredLoss<> loss;
+	{
+		FFNet<LogisticNeuron,LinearNeuron> model;
+		model.setStructure(1,5,1);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+	{
+		FFNet<TanhNeuron,LogisticNeuron> model;
+		model.setStructure(1,4,3,1,FFNetStructures::Full);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+	{
+		FFNet<FastSigmoidNeuron,TanhNeuron> model;
+		model.setStructure(1,4,3,1,FFNetStructures::InputOutputShortcut);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+		
+		//the regularizer adds its own product
+		TwoNormRegularizer regularizer;
+		error.setRegularizer(0.1,&regularizer);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+	{
+		LinearModel<> model(1,1,true);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_HessianVectorProduct_Classification )
+{
+	std::vector<RealVector> inputs(150,RealVector(4));
+	std::vector<unsigned int> labels(150);
+	for(std::size_t i = 0; i != inputs.size(); ++i){
+		labels[i] = i % 3;
+		for(std::size_t j = 0; j != 4; ++j){
+			inputs[i](j) = Rng::gauss(0,1) + (j == labels[i]);
+		}
+	}
+	ClassificationDataset data = createLabeledDataFromRange(inputs,labels,40);
+	CrossEntropy loss;
+	{
+		FFNet<LogisticNeuron,LinearNeuron> model;
+		model.setStructure(4,6,3);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+	{
+		LinearModel<> model(4,3,true);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+	}
+	{
+		//binary case with one output
+		for(std::size_t i = 0; i != data.numberOfElements(); ++i)
+			data.element(i).label = data.element(i).label % 2;
+		FFNet<TanhNeuron,LinearNeuron> model;
+		model.setStructure(4,5,1);
+		initRandomNormal(model,1);
+		ErrorFunction error(data,&model,&loss);
+		checkHessianVectorProduct(error, model.parameterVector());
+		
+		//the weighted error function weights the products of the points
+		UnlabeledData<double> weights(data.numberOfBatches());
+		for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+			weights.batch(b).resize(data.batch(b).size());
+			for(std::size_t i = 0; i != weights.batch(b).size(); ++i)
+				weights.batch(b)(i) = Rng::uni(0.1,2);
+		}
+		WeightedLabeledData<RealVector,unsigned int> weightedData(data, weights);
+		ErrorFunction weightedError(weightedData,&model,&loss);
+		checkHessianVectorProduct(weightedError, model.parameterVector());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
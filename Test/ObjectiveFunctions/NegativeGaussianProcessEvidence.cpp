@@ -142,4 +142,67 @@ BOOST_AUTO_TEST_CASE( GAUUSIAN_PROCESS_EVIDENCE )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( GAUSSIAN_PROCESS_EVIDENCE_ITERATIVE )
+{
+	Rng::seed( 0 );
+	Wave prob;
+	std::size_t N = 200;
+	std::size_t p = 100;
+	RegressionDataset trainingData = prob.generateDataset(N,20);
+	GaussianRbfKernel<> kernel(1.0);
+
+	//the probes are drawn from the global Rng, the reference below draws the same probes
+	NegativeGaussianProcessEvidence<> iterative(trainingData, &kernel);
+	Rng::seed( 1 );
+	iterative.setIterativeSolver(p, 100, 1.e-12, 50);
+	Rng::seed( 1 );
+	RealMatrix V = rademacherProbes(N, p);
+
+	RealVector params(2);
+	params(0) = 1.0;
+	params(1) = 0.1;
+	SingleObjectiveFunction::FirstOrderDerivative iterativeDerivative;
+	double iterativeValue = iterative.evalDerivative(params, iterativeDerivative);
+	BOOST_CHECK_SMALL(iterativeValue - iterative.eval(params), 1.e-8);
+
+	//reference: the estimate with the same probes, computed from the eigendecomposition of the dense matrix.
+	//Only the conjugate gradient and Lanczos iterations remain as error.
+	kernel.setParameterVector(subrange(params,0,1));
+	RealMatrix M = calculateRegularizedKernelMatrix(kernel, trainingData.inputs(), params(1));
+	RealVector t = column(createBatch<RealVector>(trainingData.labels().elements()),0);
+	blas::symm_eigenvalue_decomposition<RealMatrix> eigen(M);
+	RealMatrix const& Q = eigen.Q();
+	RealVector const& D = eigen.D();
+
+	RealMatrix QtV = prod(trans(Q), V);
+	RealVector Qtt = prod(trans(Q), t);
+	double logDet = 0;
+	for(std::size_t i = 0; i != N; ++i){
+		logDet += std::log(D(i)) * norm_sqr(row(QtV,i)) / p;
+		row(QtV,i) /= D(i);
+		Qtt(i) /= D(i);
+	}
+	RealMatrix U = prod(Q, QtV);//M^{-1} V
+	RealVector z = prod(Q, Qtt);//M^{-1} t
+	double value = -0.5 * (-logDet - inner_prod(t, z) - N * std::log(2.0 * M_PI));
+
+	//W = z z^T - 1/p U V^T, only its symmetric part enters the derivative
+	RealMatrix W = outer_prod(z,z);
+	noalias(W) -= 0.5 / p * prod(U, trans(V));
+	noalias(W) -= 0.5 / p * prod(V, trans(U));
+	RealVector derivative(2);
+	derivative(0) = -0.5 * calculateKernelMatrixParameterDerivative(kernel, trainingData.inputs(), W)(0);
+	derivative(1) = -0.5 * trace(W);
+
+	BOOST_CHECK_CLOSE(iterativeValue, value, 1.e-4);
+	BOOST_REQUIRE_EQUAL(iterativeDerivative.size(), 2);
+	for(std::size_t i = 0; i != 2; ++i){
+		BOOST_CHECK_CLOSE(iterativeDerivative(i), derivative(i), 1.e-4);
+	}
+
+	//the stochastic estimate itself is close to the exact evidence
+	NegativeGaussianProcessEvidence<> exact(trainingData, &kernel);
+	BOOST_CHECK_CLOSE(iterativeValue, exact.eval(params), 2.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -51,6 +51,21 @@ inline RealMatrix estimateSecondDerivative(
 	}
 	return hessian;
 }
+//estimates the product of the Hessian with a vector using the formula:
+//H(x)v~=(df(x+ev)/dx-df(x-ev)/dx)/2e
+inline RealVector estimateHessianVectorProduct(
+	SingleObjectiveFunction& function,
+	RealVector const& point,
+	RealVector const& vector,
+	double epsilon=1.e-10
+){
+	typedef SingleObjectiveFunction::FirstOrderDerivative Derivative;
+	Derivative result1;
+	function.evalDerivative(point + epsilon * vector,result1);
+	Derivative result2;
+	function.evalDerivative(point - epsilon * vector,result2);
+	return (result1-result2)/(2*epsilon);
+}
 void testDerivative(
 	SingleObjectiveFunction& function, 
 	const RealVector& point,
@@ -107,6 +122,27 @@ void testDerivative(
 			}
 		}
 	}
+	
+	//if possible, check the products of the Hessian with random vectors
+	if(function.features() & Function::HAS_HESSIAN_VECTOR_PRODUCT){
+		double maxErrorSecond = epsilonSecond * 100;
+		for(std::size_t trial = 0; trial != 3; ++trial){
+			RealVector vector(point.size());
+			for(std::size_t i = 0; i != vector.size(); ++i){
+				vector(i) = Rng::gauss(0,1);
+			}
+			vector /= norm_2(vector);
+			RealVector estimatedProduct = estimateHessianVectorProduct(function,point,vector,epsilonSecond);
+			RealVector product;
+			function.evalHessianVectorProduct(point,vector,product);
+			BOOST_REQUIRE_EQUAL(estimatedProduct.size(),product.size());
+			//the finite differences of the gradient lose precision when the gradient is large
+			double maxError = maxErrorSecond * (1 + norm_inf(product)) + 1.e-15 * norm_inf(derivative) / epsilonSecond;
+			for(std::size_t i=0;i != product.size(); ++i){
+				BOOST_CHECK_SMALL(estimatedProduct(i) - product(i),maxError);
+			}
+		}
+	}
 }
 
 
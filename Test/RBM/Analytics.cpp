@@ -123,4 +123,32 @@ BOOST_AUTO_TEST_CASE( Energy_NegLogLikelihood )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( AIS_Reproducible_And_Accurate )
+{
+	//create RBM with 8 visible and 6 hidden units
+	RBM<BinaryLayer,BinaryLayer,Rng::rng_type > rbm(Rng::globalRng);
+	rbm.setStructure(8,6);
+	initRandomNormal(rbm,1);
+	double logZRatio = logPartitionFunction(rbm,1.0)-logPartitionFunction(rbm,0.0);
+	
+	//the same seed gives the same result, independent of the parallel batches
+	Rng::seed(42);
+	double estimate = annealedImportanceSampling(rbm,20,2000);
+	Rng::seed(42);
+	double estimateRepeated = annealedImportanceSampling(rbm,20,2000);
+	BOOST_CHECK_EQUAL(estimate,estimateRepeated);
+	BOOST_CHECK_SMALL(estimate-logZRatio,0.2);
+	
+	//adaptive schedule
+	RealVector beta = adaptiveBetaSchedule(rbm,20,50,500);
+	BOOST_REQUIRE_EQUAL(beta.size(),20);
+	BOOST_CHECK_EQUAL(beta(0),1.0);
+	BOOST_CHECK_EQUAL(beta(19),0.0);
+	for(std::size_t i = 1; i != 20; ++i){
+		BOOST_CHECK(beta(i) < beta(i-1));
+	}
+	double adaptiveEstimate = annealedImportanceSampling(rbm,beta,2000);
+	BOOST_CHECK_SMALL(adaptiveEstimate-logZRatio,0.2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+#define BOOST_TEST_MODULE RBM_ParallelChainTraining
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Unsupervised/RBM/BinaryRBM.h>
+#include <shark/Unsupervised/RBM/analytics.h>
+
+#include <shark/Unsupervised/RBM/Problems/BarsAndStripes.h>
+#include <shark/Algorithms/GradientDescent/SteepestDescent.h>
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (RBM_ParallelChainTraining)
+
+BOOST_AUTO_TEST_CASE( ParallelPCDTraining_Bars ){
+	
+	BarsAndStripes problem;
+	UnlabeledData<RealVector> data = problem.data();
+	
+	Rng::seed(0);
+	
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,8);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::gauss(0,1);
+	}
+	rbm.setParameterVector(params);
+	BinaryParallelPCD cd(&rbm);
+	cd.setNumberOfSamples(32);
+	cd.setNumberOfChains(4);
+	cd.setData(data);
+	BOOST_REQUIRE_EQUAL(cd.numberOfChains(), 4);
+	
+	SteepestDescent optimizer;
+	optimizer.setLearningRate(0.05);
+	optimizer.setMomentum(0);
+	optimizer.init(cd);
+	
+	double logLikelyhood = 0;
+	for(std::size_t i = 0; i != 5001; ++i){
+		if(i % 5000 == 0){
+			rbm.setParameterVector(optimizer.solution().point);
+			logLikelyhood = negativeLogLikelihood(rbm,data);
+			std::cout<<i<<" "<<logLikelyhood<<std::endl;
+		}
+		optimizer.step(cd);
+	}
+	
+	BOOST_CHECK( logLikelyhood<200.0 );
+}
+
+BOOST_AUTO_TEST_CASE( ParallelPTTraining_Bars ){
+	
+	BarsAndStripes problem;
+	UnlabeledData<RealVector> data = problem.data();
+	
+	Rng::seed(42);
+	
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,8);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::uni(-0.1,0.1);
+	}
+	rbm.setParameterVector(params);
+	BinaryParallelPT cd(&rbm);
+	cd.chain().setUniformTemperatureSpacing(5);
+	cd.setNumberOfChains(4);
+	cd.numBatches()=2;
+	cd.setData(data);
+	
+	SteepestDescent optimizer;
+	optimizer.setLearningRate(0.1);
+	optimizer.setMomentum(0);
+	optimizer.init(cd);
+	
+	double logLikelyhood = 0;
+	for(std::size_t i = 0; i != 3001; ++i){
+		if(i % 1000 == 0){
+			rbm.setParameterVector(optimizer.solution().point);
+			logLikelyhood = negativeLogLikelihood(rbm,data);
+			std::cout<<i<<" "<<logLikelyhood<<std::endl;
+		}
+		optimizer.step(cd);
+	}
+	
+	BOOST_CHECK( logLikelyhood<200.0 );
+}
+
+//the gradient only depends on the seed and the number of chains, not on the scheduling of the threads
+BOOST_AUTO_TEST_CASE( ParallelPT_Reproducible ){
+	BarsAndStripes problem;
+	UnlabeledData<RealVector> data = problem.data();
+	
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,8);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::uni(-0.1,0.1);
+	}
+	
+	RealVector derivatives[2];
+	for(std::size_t trial = 0; trial != 2; ++trial){
+		Rng::seed(17);
+		BinaryParallelPT cd(&rbm);
+		cd.chain().setUniformTemperatureSpacing(3);
+		cd.setNumberOfChains(3);
+		cd.setData(data);
+		for(std::size_t i = 0; i != 5; ++i)
+			cd.evalDerivative(params,derivatives[trial]);
+	}
+	BOOST_CHECK_SMALL(norm_inf(derivatives[0] - derivatives[1]), 1.e-15);
+}
+
+//a copy samples with its own generators, starting from the state of the original ones
+BOOST_AUTO_TEST_CASE( ParallelPCD_Copy ){
+	BarsAndStripes problem;
+	UnlabeledData<RealVector> data = problem.data();
+	
+	Rng::seed(3);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,8);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::uni(-0.1,0.1);
+	}
+	
+	BinaryParallelPCD cd(&rbm);
+	cd.setNumberOfSamples(32);
+	cd.setNumberOfChains(4);
+	cd.setData(data);
+	BinaryParallelPCD copy(cd);
+	BinaryParallelPCD assigned(&rbm);
+	assigned = cd;
+	
+	RealVector derivative;
+	RealVector copyDerivative;
+	RealVector assignedDerivative;
+	for(std::size_t i = 0; i != 3; ++i)
+		cd.evalDerivative(params,derivative);
+	for(std::size_t i = 0; i != 3; ++i)
+		copy.evalDerivative(params,copyDerivative);
+	for(std::size_t i = 0; i != 3; ++i)
+		assigned.evalDerivative(params,assignedDerivative);
+	BOOST_CHECK_SMALL(norm_inf(derivative - copyDerivative), 1.e-15);
+	BOOST_CHECK_SMALL(norm_inf(derivative - assignedDerivative), 1.e-15);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,11 +1,20 @@
 #define SHARK_USE_SIMD
-#include <shark/LinAlg/BLAS/blas.h>
+#include <shark/LinAlg/Base.h>
 #include <shark/LinAlg/BLAS/kernels/conv2d.hpp>
 #include <shark/Core/Timer.h>
 #include <iostream>
 using namespace shark;
 using namespace std;
 
+const char* algorithmName(blas::kernels::conv2d_algorithm algorithm){
+	switch(algorithm){
+	case blas::kernels::conv2d_algorithm::direct: return "direct";
+	case blas::kernels::conv2d_algorithm::gemm: return "gemm";
+	case blas::kernels::conv2d_algorithm::fft: return "fft";
+	default: return "automatic";
+	}
+}
+
 template<class E1, class E2>
 void benchmark(
 	blas::matrix_expression<E1, blas::cpu_tag> const& image,
@@ -21,23 +30,34 @@ void benchmark(
 	typedef typename E1::value_type value_type;
 	
 	blas::matrix<value_type> out(output_size1 * num_filters, output_size2 ,0.0);
-	double minOptTime = std::numeric_limits<double>::max();
-	for(std::size_t i = 0; i != 20; ++i){
-		Timer time;
-		blas::kernels::conv2d(image,filter,out, num_channels, num_filters);
-		minOptTime = min(minOptTime,time.stop());
-	}
-	
 	double mults = output_size1 * output_size2 * filter_size * filter_size * num_filters * num_channels;
-	double flops = mults /1024/1024/minOptTime;
 	
 	std::cout<<output_size1<<"\t"<<filter_size<<"\t"<<num_channels<<"\t"<< num_filters<<"\t";
-	std::cout<<"\t"<<flops<< std::endl;
+	blas::kernels::conv2d_algorithm algorithms[] = {
+		blas::kernels::conv2d_algorithm::direct,
+		blas::kernels::conv2d_algorithm::gemm,
+		blas::kernels::conv2d_algorithm::fft
+	};
+	for(auto algorithm: algorithms){
+		double minOptTime = std::numeric_limits<double>::max();
+		for(std::size_t i = 0; i != 5; ++i){
+			Timer time;
+			blas::kernels::conv2d(image,filter,out, num_channels, num_filters, algorithm);
+			minOptTime = min(minOptTime,time.stop());
+		}
+		double flops = mults /1024/1024/minOptTime;
+		std::cout<<"\t"<<flops;
+	}
+	blas::kernels::conv2d_algorithm chosen = blas::kernels::select_conv2d_algorithm<value_type>(
+		image_size1, image_size2, filter_size, filter_size, num_channels, num_filters
+	);
+	std::cout<<"\t"<<algorithmName(chosen)<< std::endl;
 }
 
 
 int main(int argc, char **argv) {
 	std::cout<<"Flops"<<std::endl;
+	std::cout<<"size\tfilter\tchannels\tfilters\t\tdirect\tgemm\tfft\tchosen"<<std::endl;
 	std::size_t num_channels = 8;
 	std::size_t num_outputs = 16;
 	std::cout<<"performance float"<<std::endl;
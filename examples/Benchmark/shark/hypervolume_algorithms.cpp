@@ -1,7 +1,8 @@
-#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMD.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMDHOY.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMDWFG.h>
 
 #include <shark/Core/Timer.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Rng/GlobalRng.h>
 #include <iostream>
 using namespace shark;
@@ -23,9 +24,21 @@ std::vector<RealVector> createRandomFront(std::size_t numPoints, std::size_t num
 	return points;
 }
 
+//measures the time of the algorithm on the set with the given number of threads
+template<class Algorithm>
+double timeAlgorithm(Algorithm algorithm, std::vector<RealVector> const& set, RealVector const& reference, std::size_t threads, double& value){
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(threads);
+#endif
+	Timer time;
+	value = algorithm(set, reference);
+	return time.stop();
+}
+
 int main(int argc, char **argv) {
+	std::size_t maxThreads = SHARK_NUM_THREADS;
 	
-	
+	//HOY against WFG
 	Rng::seed(42);
 	for(std::size_t dim = 4; dim != 9; ++dim){
 		std::cout<<"dimensions = " <<dim<<std::endl;
@@ -33,25 +46,40 @@ int main(int argc, char **argv) {
 		for(unsigned int numPoints = 10; numPoints != 110; numPoints +=10){
 			auto set = createRandomFront(numPoints,dim,2);
 			
-			HypervolumeCalculatorMD algorithm1;
+			HypervolumeCalculatorMDHOY algorithm1;
 			HypervolumeCalculatorMDWFG algorithm2;
 			
 			double val1= 0;
-			double stop1 = 0;
-			{
-				Timer time;
-				val1 = algorithm1(set, reference);
-				stop1 = time.stop();
-			}
+			double stop1 = timeAlgorithm(algorithm1, set, reference, 1, val1);
 			double val2= 0;
-			double stop2 = 0;
-			{
-				Timer time;
-				val2 = algorithm2(set, reference);
-				stop2 = time.stop();
-			}
+			double stop2 = timeAlgorithm(algorithm2, set, reference, 1, val2);
 			std::cout<<numPoints<<"\t"<<stop1<<"\t"<<stop2<<"\t"<<val1-val2<<"\t"<<std::endl;
 		}
 		std::cout<<std::endl;
 	}
-}
\ No newline at end of file
+	
+	//scaling of WFG with the number of threads
+	Rng::seed(42);
+	for(std::size_t dim = 6; dim != 11; ++dim){
+		std::cout<<"dimensions = " <<dim<<", threads = 1 ... "<<maxThreads<<std::endl;
+		RealVector reference(dim,1.0);
+		for(unsigned int numPoints = 20; numPoints <= 140; numPoints +=20){
+			auto set = createRandomFront(numPoints,dim,2);
+			HypervolumeCalculatorMDWFG algorithm;
+			
+			double val1 = 0;
+			double stop1 = timeAlgorithm(algorithm, set, reference, 1, val1);
+			std::cout<<numPoints<<"\t"<<stop1;
+			for(std::size_t threads = 2; threads <= maxThreads; threads *= 2){
+				double val = 0;
+				double stop = timeAlgorithm(algorithm, set, reference, threads, val);
+				std::cout<<"\t"<<stop<<"\t"<<stop1/stop<<"\t"<<val1-val;
+			}
+			std::cout<<std::endl;
+		}
+		std::cout<<std::endl;
+	}
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(maxThreads);
+#endif
+}
@@ -0,0 +1,64 @@
+#include <shark/Algorithms/DirectSearch/Operators/Domination/FastNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/DCNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/ENSNonDominatedSort.h>
+
+#include <shark/Core/Timer.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
+#include <iostream>
+using namespace shark;
+
+//uniformly distributed points. for many objectives, most points are in the first fronts
+std::vector<RealVector> createRandomPoints(std::size_t numPoints, std::size_t numObj){
+	std::vector<RealVector> points(numPoints, RealVector(numObj));
+	for(auto& point: points){
+		for(std::size_t j = 0; j != numObj; ++j){
+			point(j) = Rng::uni(0.0, 1.0);
+		}
+	}
+	return points;
+}
+
+//measures the time of the algorithm with the given number of threads and returns the number of fronts
+template<class Algorithm>
+double timeAlgorithm(Algorithm algorithm, std::vector<RealVector> const& points, std::size_t threads, std::size_t& fronts){
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(threads);
+#endif
+	std::vector<std::size_t> ranks(points.size());
+	Timer time;
+	algorithm(points, ranks);
+	double stop = time.stop();
+	fronts = *std::max_element(ranks.begin(), ranks.end());
+	return stop;
+}
+
+int main(int argc, char **argv) {
+	std::size_t maxThreads = SHARK_NUM_THREADS;
+	auto fast = [](std::vector<RealVector> const& points, std::vector<std::size_t>& ranks){fastNonDominatedSort(points, ranks);};
+	auto dc = [](std::vector<RealVector> const& points, std::vector<std::size_t>& ranks){dcNonDominatedSort(points, ranks);};
+	auto ens = [](std::vector<RealVector> const& points, std::vector<std::size_t>& ranks){ensNonDominatedSort(points, ranks);};
+	
+	Rng::seed(42);
+	std::cout<<"points\tobjectives\tfronts\tfast\tDC\tENS(1 thread) ... ENS("<<maxThreads<<" threads)"<<std::endl;
+	for(std::size_t numPoints: {1000, 10000, 100000}){
+		for(std::size_t numObj: {2, 3, 5, 10}){
+			auto points = createRandomPoints(numPoints, numObj);
+			std::size_t fronts = 0;
+			std::cout<<numPoints<<"\t"<<numObj;
+			//fast non-dominated sort needs quadratic memory
+			double timeFast = 0;
+			if(numPoints <= 10000)
+				timeFast = timeAlgorithm(fast, points, 1, fronts);
+			double timeDC = timeAlgorithm(dc, points, 1, fronts);
+			std::cout<<"\t"<<fronts<<"\t"<<timeFast<<"\t"<<timeDC;
+			for(std::size_t threads = 1; threads <= maxThreads; threads *= 2){
+				std::cout<<"\t"<<timeAlgorithm(ens, points, threads, fronts);
+			}
+			std::cout<<std::endl;
+		}
+	}
+#ifdef SHARK_USE_OPENMP
+	omp_set_num_threads(maxThreads);
+#endif
+}
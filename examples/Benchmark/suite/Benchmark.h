@@ -0,0 +1,310 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Registry, measurement and reporting of the benchmark suite
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_BENCHMARK_SUITE_BENCHMARK_H
+#define SHARK_BENCHMARK_SUITE_BENCHMARK_H
+
+#include <shark/Core/Exception.h>
+#include <shark/Core/OpenMP.h>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace shark{ namespace benchmark{
+
+/// \brief The code which is timed.
+///
+/// It is created by the WorkloadFactory outside of the measurement, thus all
+/// data needed by the workload should be generated in the factory and captured by the workload.
+/// Objects which are only referenced by other captured objects, e.g. the kernel of a kernel matrix,
+/// need to be captured explicitly to keep them alive.
+typedef std::function<void()> Workload;
+
+/// \brief Creates the workload of a benchmark for a value of its parameter, e.g. the size of the problem.
+typedef std::function<Workload(std::size_t)> WorkloadFactory;
+
+/// \brief A benchmark which is run for every value of its parameter.
+struct BenchmarkDefinition{
+	std::string name; ///< name of the form "group/benchmark"
+	std::string parameterName; ///< meaning of the parameter, e.g. "n" for the size of a matrix
+	std::vector<std::size_t> parameters;
+	WorkloadFactory factory;
+};
+
+/// \brief All benchmarks in the order of registration.
+inline std::vector<BenchmarkDefinition>& registry(){
+	static std::vector<BenchmarkDefinition> benchmarks;
+	return benchmarks;
+}
+
+/// \brief Adds a benchmark to the registry when a static instance is constructed.
+///
+/// \code
+/// static RegisterBenchmark gemm("remora/gemm", "n", {128, 256, 512}, [](std::size_t n) -> Workload{
+/// 	...//create the matrices
+/// 	return [=](){ ... };
+/// });
+/// \endcode
+struct RegisterBenchmark{
+	RegisterBenchmark(
+		std::string const& name,
+		std::string const& parameterName,
+		std::vector<std::size_t> const& parameters,
+		WorkloadFactory const& factory
+	){
+		BenchmarkDefinition definition = {name, parameterName, parameters, factory};
+		registry().push_back(definition);
+	}
+};
+
+/// \brief Keeps the compiler from removing computations whose result is otherwise unused.
+inline void keep(double value){
+	static volatile double sink = 0;
+	sink = sink + value;
+}
+
+/// \brief Controls how often the workloads are run.
+struct Settings{
+	Settings():repetitions(10), warmup(2), minSampleTime(0.01){}
+
+	std::size_t repetitions; ///< number of measured samples
+	std::size_t warmup; ///< number of samples which are run before the measurement and not recorded
+	double minSampleTime; ///< the workload is run repeatedly in a sample until it takes at least this many seconds
+};
+
+/// \brief Summary of the time per run of the workload over all samples in seconds.
+struct Statistics{
+	double min;
+	double p10;
+	double median;
+	double p90;
+	double max;
+	double mean;
+	double stddev;
+};
+
+/// \brief The measurements of one benchmark with one parameter value.
+struct Result{
+	std::string name;
+	std::string parameterName;
+	std::size_t parameter;
+	std::size_t iterations; ///< number of runs of the workload per sample
+	std::vector<double> samples; ///< time per run of the workload in seconds
+	Statistics statistics;
+
+	/// \brief Identifies the result in a baseline.
+	std::string key()const{
+		return name + "/" + std::to_string(parameter);
+	}
+};
+
+/// \brief Percentile of sorted values with linear interpolation between the closest ranks.
+inline double percentile(std::vector<double> const& sorted, double p){
+	SHARK_RUNTIME_CHECK(!sorted.empty(), "No values given");
+	double position = p * (sorted.size() - 1);
+	std::size_t lower = (std::size_t)std::floor(position);
+	std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+	double fraction = position - lower;
+	return (1 - fraction) * sorted[lower] + fraction * sorted[upper];
+}
+
+inline Statistics computeStatistics(std::vector<double> samples){
+	std::sort(samples.begin(), samples.end());
+	Statistics statistics;
+	statistics.min = samples.front();
+	statistics.p10 = percentile(samples, 0.1);
+	statistics.median = percentile(samples, 0.5);
+	statistics.p90 = percentile(samples, 0.9);
+	statistics.max = samples.back();
+	double sum = 0;
+	for(double sample: samples) sum += sample;
+	statistics.mean = sum / samples.size();
+	double variance = 0;
+	for(double sample: samples) variance += (sample - statistics.mean) * (sample - statistics.mean);
+	statistics.stddev = samples.size() > 1? std::sqrt(variance / (samples.size() - 1)) : 0.0;
+	return statistics;
+}
+
+/// \brief Runs the workload the given number of times and returns the elapsed time in seconds.
+inline double timeWorkload(Workload const& workload, std::size_t iterations){
+	auto start = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i != iterations; ++i){
+		workload();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+/// \brief Measures a benchmark for one parameter value.
+///
+/// The warmup samples are also used to find the number of runs per sample such that a sample
+/// takes at least the minimum sample time. Without warmup, every sample consists of a single run.
+inline Result runBenchmark(BenchmarkDefinition const& definition, std::size_t parameter, Settings const& settings){
+	Workload workload = definition.factory(parameter);
+	Result result;
+	result.name = definition.name;
+	result.parameterName = definition.parameterName;
+	result.parameter = parameter;
+	result.iterations = 1;
+	for(std::size_t i = 0; i != settings.warmup; ++i){
+		double time = timeWorkload(workload, result.iterations);
+		if(time < settings.minSampleTime){
+			double factor = std::min(100.0, 1.2 * settings.minSampleTime / std::max(time, 1.e-9));
+			result.iterations = (std::size_t)std::ceil(result.iterations * factor);
+		}
+	}
+	for(std::size_t i = 0; i != std::max<std::size_t>(settings.repetitions, 1); ++i){
+		result.samples.push_back(timeWorkload(workload, result.iterations) / result.iterations);
+	}
+	result.statistics = computeStatistics(result.samples);
+	return result;
+}
+
+/// \brief Writes the results as JSON. The output can be used as a baseline for compareToBaseline.
+inline void writeJson(std::ostream& stream, std::vector<Result> const& results, Settings const& settings){
+	stream << std::setprecision(9);
+	stream << "{\n";
+	stream << "  \"context\": {\"threads\": " << SHARK_NUM_THREADS
+		<< ", \"repetitions\": " << settings.repetitions
+		<< ", \"warmup\": " << settings.warmup
+		<< ", \"min_sample_time\": " << settings.minSampleTime << "},\n";
+	stream << "  \"benchmarks\": [";
+	for(std::size_t i = 0; i != results.size(); ++i){
+		Result const& result = results[i];
+		Statistics const& s = result.statistics;
+		stream << (i == 0? "\n" : ",\n");
+		stream << "    {\"name\": \"" << result.name << "\""
+			<< ", \"parameter_name\": \"" << result.parameterName << "\""
+			<< ", \"parameter\": " << result.parameter
+			<< ", \"iterations\": " << result.iterations
+			<< ", \"repetitions\": " << result.samples.size()
+			<< ", \"unit\": \"s\""
+			<< ", \"min\": " << s.min
+			<< ", \"p10\": " << s.p10
+			<< ", \"median\": " << s.median
+			<< ", \"p90\": " << s.p90
+			<< ", \"max\": " << s.max
+			<< ", \"mean\": " << s.mean
+			<< ", \"stddev\": " << s.stddev << "}";
+	}
+	stream << "\n  ]\n}\n";
+}
+
+/// \brief Writes the results as CSV with one line per benchmark and parameter.
+inline void writeCsv(std::ostream& stream, std::vector<Result> const& results){
+	stream << std::setprecision(9);
+	stream << "name,parameter_name,parameter,iterations,repetitions,min,p10,median,p90,max,mean,stddev\n";
+	for(Result const& result: results){
+		Statistics const& s = result.statistics;
+		stream << result.name << ',' << result.parameterName << ',' << result.parameter << ','
+			<< result.iterations << ',' << result.samples.size() << ','
+			<< s.min << ',' << s.p10 << ',' << s.median << ',' << s.p90 << ','
+			<< s.max << ',' << s.mean << ',' << s.stddev << '\n';
+	}
+}
+
+/// \brief Writes a human readable table of the results.
+inline void writeTable(std::ostream& stream, std::vector<Result> const& results){
+	stream << std::left << std::setw(40) << "benchmark" << std::right
+		<< std::setw(12) << "median[s]" << std::setw(12) << "p10[s]" << std::setw(12) << "p90[s]"
+		<< std::setw(12) << "iterations" << '\n';
+	stream << std::setprecision(4);
+	for(Result const& result: results){
+		std::string name = result.name + "/" + result.parameterName + "=" + std::to_string(result.parameter);
+		stream << std::left << std::setw(40) << name << std::right
+			<< std::setw(12) << result.statistics.median
+			<< std::setw(12) << result.statistics.p10
+			<< std::setw(12) << result.statistics.p90
+			<< std::setw(12) << result.iterations << '\n';
+	}
+}
+
+/// \brief Reads the median times of a JSON file written by writeJson, indexed by Result::key.
+inline std::map<std::string, double> readBaseline(std::string const& filename){
+	boost::property_tree::ptree tree;
+	boost::property_tree::read_json(filename, tree);
+	std::map<std::string, double> medians;
+	for(auto const& entry: tree.get_child("benchmarks")){
+		boost::property_tree::ptree const& benchmark = entry.second;
+		std::string key = benchmark.get<std::string>("name") + "/" + benchmark.get<std::string>("parameter");
+		medians[key] = benchmark.get<double>("median");
+	}
+	return medians;
+}
+
+/// \brief Compares the median times with a baseline and returns the number of regressions.
+///
+/// A benchmark regressed if its median is more than (1+threshold) times the median of the baseline.
+/// Benchmarks which are not part of the baseline are reported but not compared.
+inline std::size_t compareToBaseline(
+	std::ostream& stream,
+	std::vector<Result> const& results,
+	std::map<std::string, double> const& baseline,
+	double threshold
+){
+	std::size_t regressions = 0;
+	stream << std::left << std::setw(40) << "benchmark" << std::right
+		<< std::setw(14) << "baseline[s]" << std::setw(14) << "current[s]" << std::setw(10) << "ratio" << '\n';
+	stream << std::setprecision(4);
+	for(Result const& result: results){
+		stream << std::left << std::setw(40) << result.key() << std::right;
+		auto pos = baseline.find(result.key());
+		if(pos == baseline.end()){
+			stream << std::setw(14) << "-" << std::setw(14) << result.statistics.median << std::setw(10) << "-" << "  new\n";
+			continue;
+		}
+		double ratio = result.statistics.median / pos->second;
+		stream << std::setw(14) << pos->second << std::setw(14) << result.statistics.median << std::setw(10) << ratio;
+		if(ratio > 1 + threshold){
+			stream << "  REGRESSION";
+			++regressions;
+		}else if(ratio < 1 / (1 + threshold)){
+			stream << "  improved";
+		}
+		stream << '\n';
+	}
+	return regressions;
+}
+
+}}
+#endif
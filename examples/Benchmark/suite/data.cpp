@@ -0,0 +1,92 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the data import
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/Data/Csv.h>
+#include <shark/Data/SparseData.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <sstream>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+//dense csv file with 20 columns
+std::string createCsv(std::size_t rows){
+	std::ostringstream stream;
+	stream.precision(8);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != 20; ++j){
+			stream << (j == 0? "" : ",") << Rng::gauss(0, 1);
+		}
+		stream << '\n';
+	}
+	return stream.str();
+}
+
+//libsvm file with 1000 features of which about 5% are nonzero
+std::string createLibSVM(std::size_t rows){
+	std::ostringstream stream;
+	stream.precision(8);
+	for(std::size_t i = 0; i != rows; ++i){
+		stream << (Rng::coinToss(0.5)? "+1" : "-1");
+		for(std::size_t j = 1; j <= 1000; ++j){
+			if(Rng::coinToss(0.05))
+				stream << ' ' << j << ':' << Rng::gauss(0, 1);
+		}
+		stream << '\n';
+	}
+	return stream.str();
+}
+
+RegisterBenchmark csv("data/csv_import", "rows", {1000, 10000}, [](std::size_t rows) -> Workload{
+	std::string contents = createCsv(rows);
+	return [=](){
+		Data<RealVector> data;
+		csvStringToData(data, contents);
+		keep(data.numberOfElements());
+	};
+});
+
+RegisterBenchmark libsvm("data/libsvm_import", "rows", {1000, 10000}, [](std::size_t rows) -> Workload{
+	std::string contents = createLibSVM(rows);
+	return [=](){
+		std::istringstream stream(contents);
+		LabeledData<RealVector, unsigned int> data;
+		importSparseData(data, stream, 1000);
+		keep(data.numberOfElements());
+	};
+});
+}
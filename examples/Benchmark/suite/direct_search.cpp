@@ -0,0 +1,115 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the multi-objective operators and direct search
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/NonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContribution.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Sphere.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <memory>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+//points on the positive part of the unit sphere, thus all points are mutually non-dominated
+std::vector<RealVector> randomFront(std::size_t n, std::size_t objectives){
+	std::vector<RealVector> points(n, RealVector(objectives));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != objectives; ++j) points[i](j) = std::abs(Rng::gauss(0, 1));
+		points[i] /= norm_2(points[i]);
+	}
+	return points;
+}
+
+//random points in the unit cube, which form many fronts
+std::vector<RealVector> randomPoints(std::size_t n, std::size_t objectives){
+	std::vector<RealVector> points(n, RealVector(objectives));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != objectives; ++j) points[i](j) = Rng::uni(0, 1);
+	}
+	return points;
+}
+
+RegisterBenchmark hypervolume3D("moo/hypervolume_3d", "points", {100, 1000}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> front = randomFront(n, 3);
+	RealVector reference(3, 1.1);
+	return [=](){
+		HypervolumeCalculator algorithm;
+		keep(algorithm(front, reference));
+	};
+});
+
+RegisterBenchmark hypervolume5D("moo/hypervolume_5d", "points", {20, 50}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> front = randomFront(n, 5);
+	RealVector reference(5, 1.1);
+	return [=](){
+		HypervolumeCalculator algorithm;
+		keep(algorithm(front, reference));
+	};
+});
+
+RegisterBenchmark contribution3D("moo/hypervolume_contribution_3d", "points", {100, 1000}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> front = randomFront(n, 3);
+	RealVector reference(3, 1.1);
+	return [=](){
+		HypervolumeContribution algorithm;
+		keep(algorithm.smallest(front, 1, reference)[0].key);
+	};
+});
+
+RegisterBenchmark sort("moo/non_dominated_sort_3d", "points", {1000, 5000}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> points = randomPoints(n, 3);
+	std::vector<unsigned int> ranks(n);
+	return [=]() mutable{
+		nonDominatedSort(points, ranks);
+		keep(ranks[0]);
+	};
+});
+
+//one generation of the CMA-ES
+RegisterBenchmark cma("direct_search/cma_step", "n", {100, 400}, [](std::size_t n) -> Workload{
+	auto function = std::make_shared<Sphere>(n);
+	auto optimizer = std::make_shared<CMA>();
+	function->init();
+	optimizer->init(*function, RealVector(n, 1.0));
+	return [=](){
+		optimizer->step(*function);
+		keep(optimizer->solution().value);
+	};
+});
+}
@@ -0,0 +1,145 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Command line interface of the benchmark suite
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace shark::benchmark;
+
+namespace{
+void printUsage(){
+	std::cout
+		<< "Usage: SharkBenchmarks [options]\n"
+		<< "  --list               list the benchmarks and their parameters\n"
+		<< "  --filter <text>      only run benchmarks whose name contains the text\n"
+		<< "  --repetitions <n>    number of measured samples (default 10)\n"
+		<< "  --warmup <n>         number of unmeasured samples, also used for calibration (default 2)\n"
+		<< "  --min-time <s>       minimum duration of a sample in seconds (default 0.01)\n"
+		<< "  --format <f>         table, json or csv (default table)\n"
+		<< "  --output <file>      write the results to the file instead of the standard output\n"
+		<< "  --compare <file>     compare the medians with a JSON file written by --format json\n"
+		<< "  --threshold <x>      relative slowdown reported as regression (default 0.1)\n"
+		<< "With --compare, the exit code is 1 if a benchmark regressed.\n";
+}
+}
+
+int main(int argc, char** argv){
+	Settings settings;
+	std::string filter;
+	std::string format = "table";
+	std::string output;
+	std::string baselineFile;
+	double threshold = 0.1;
+	bool list = false;
+	for(int i = 1; i < argc; ++i){
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+		if(argument == "--list"){
+			list = true;
+		}else if(argument == "--filter" && hasValue){
+			filter = argv[++i];
+		}else if(argument == "--repetitions" && hasValue){
+			settings.repetitions = std::strtoul(argv[++i], NULL, 10);
+		}else if(argument == "--warmup" && hasValue){
+			settings.warmup = std::strtoul(argv[++i], NULL, 10);
+		}else if(argument == "--min-time" && hasValue){
+			settings.minSampleTime = std::atof(argv[++i]);
+		}else if(argument == "--format" && hasValue){
+			format = argv[++i];
+		}else if(argument == "--output" && hasValue){
+			output = argv[++i];
+		}else if(argument == "--compare" && hasValue){
+			baselineFile = argv[++i];
+		}else if(argument == "--threshold" && hasValue){
+			threshold = std::atof(argv[++i]);
+		}else{
+			printUsage();
+			return argument == "--help"? 0 : 2;
+		}
+	}
+	if(format != "table" && format != "json" && format != "csv"){
+		printUsage();
+		return 2;
+	}
+
+	std::vector<BenchmarkDefinition> const& benchmarks = registry();
+	if(list){
+		for(BenchmarkDefinition const& benchmark: benchmarks){
+			std::cout << benchmark.name << " " << benchmark.parameterName << " =";
+			for(std::size_t parameter: benchmark.parameters){
+				std::cout << " " << parameter;
+			}
+			std::cout << "\n";
+		}
+		return 0;
+	}
+
+	//progress goes to the error stream so that the results can be piped
+	std::vector<Result> results;
+	for(BenchmarkDefinition const& benchmark: benchmarks){
+		if(benchmark.name.find(filter) == std::string::npos) continue;
+		for(std::size_t parameter: benchmark.parameters){
+			std::cerr << benchmark.name << " " << benchmark.parameterName << "=" << parameter << std::endl;
+			results.push_back(runBenchmark(benchmark, parameter, settings));
+		}
+	}
+
+	std::ofstream file;
+	if(!output.empty()){
+		file.open(output.c_str());
+		if(!file){
+			std::cerr << "Can not open " << output << std::endl;
+			return 2;
+		}
+	}
+	std::ostream& stream = output.empty()? std::cout : file;
+	if(format == "json"){
+		writeJson(stream, results, settings);
+	}else if(format == "csv"){
+		writeCsv(stream, results);
+	}else{
+		writeTable(stream, results);
+	}
+
+	if(!baselineFile.empty()){
+		std::size_t regressions = compareToBaseline(std::cerr, results, readBaseline(baselineFile), threshold);
+		if(regressions != 0){
+			std::cerr << regressions << " benchmark(s) regressed by more than " << 100 * threshold << "%" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,114 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the model evaluation
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/Algorithms/Trainers/RFTrainer.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Models/FFNet.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/KernelExpansion.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <memory>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+Data<RealVector> randomInputs(std::size_t n, std::size_t dimensions){
+	std::vector<RealVector> points(n, RealVector(dimensions));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != dimensions; ++j) points[i](j) = Rng::gauss(0, 1);
+	}
+	return createDataFromRange(points);
+}
+
+template<class Model>
+void initRandomParameters(Model& model){
+	RealVector parameters(model.numberOfParameters());
+	for(std::size_t i = 0; i != parameters.size(); ++i) parameters(i) = Rng::gauss(0, 0.1);
+	model.setParameterVector(parameters);
+}
+
+//linear model with 100 inputs and 10 outputs
+RegisterBenchmark linear("models/linear_eval", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	auto inputs = std::make_shared<Data<RealVector> >(randomInputs(n, 100));
+	auto model = std::make_shared<LinearModel<> >(100, 10, true);
+	initRandomParameters(*model);
+	return [=](){
+		Data<RealVector> outputs = (*model)(*inputs);
+		keep(outputs.element(0)(0));
+	};
+});
+
+//network with 100 inputs, two hidden layers with 200 neurons and 10 outputs
+RegisterBenchmark ffnet("models/ffnet_eval", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	auto inputs = std::make_shared<Data<RealVector> >(randomInputs(n, 100));
+	auto model = std::make_shared<FFNet<LogisticNeuron, LinearNeuron> >();
+	model->setStructure(std::vector<std::size_t>{100, 200, 200, 10});
+	initRandomParameters(*model);
+	return [=](){
+		Data<RealVector> outputs = (*model)(*inputs);
+		keep(outputs.element(0)(0));
+	};
+});
+
+//kernel expansion with 1000 basis points in 20 dimensions
+RegisterBenchmark kernelExpansion("models/kernel_expansion_eval", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	auto inputs = std::make_shared<Data<RealVector> >(randomInputs(n, 20));
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(0.1);
+	auto model = std::make_shared<KernelExpansion<RealVector> >(kernel.get(), randomInputs(1000, 20), true);
+	initRandomParameters(*model);
+	return [inputs, kernel, model](){
+		Data<RealVector> outputs = (*model)(*inputs);
+		keep(outputs.element(0)(0));
+	};
+});
+
+//prediction of a random forest with 50 trees trained on 2000 points
+RegisterBenchmark randomForest("models/random_forest_eval", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	Chessboard problem;
+	ClassificationDataset data = problem.generateDataset(2000);
+	auto inputs = std::make_shared<Data<RealVector> >(problem.generateDataset(n).inputs());
+	auto model = std::make_shared<RFClassifier>();
+	RFTrainer trainer;
+	trainer.setNTrees(50);
+	trainer.train(*model, data);
+	return [=](){
+		auto outputs = (*model)(*inputs);
+		keep(outputs.numberOfElements());
+	};
+});
+}
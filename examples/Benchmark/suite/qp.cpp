@@ -0,0 +1,95 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the kernel matrices and the quadratic program solvers
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/Algorithms/Trainers/CSvmTrainer.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/LinAlg/CachedMatrix.h>
+#include <shark/LinAlg/KernelMatrix.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <memory>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+//computes all rows of the kernel matrix
+RegisterBenchmark kernelMatrix("qp/kernel_matrix_rows", "n", {500, 2000}, [](std::size_t n) -> Workload{
+	Chessboard problem;
+	auto data = std::make_shared<ClassificationDataset>(problem.generateDataset(n));
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(0.5);
+	auto matrix = std::make_shared<KernelMatrix<RealVector, float> >(*kernel, data->inputs());
+	auto storage = std::make_shared<std::vector<float> >(n);
+	return [data, kernel, matrix, storage, n](){
+		for(std::size_t i = 0; i != n; ++i){
+			matrix->row(i, 0, n, storage->data());
+		}
+		keep((*storage)[0]);
+	};
+});
+
+//random row accesses of a cached kernel matrix which is large enough to hold all rows
+RegisterBenchmark cachedMatrix("qp/cached_matrix_rows", "n", {500, 2000}, [](std::size_t n) -> Workload{
+	Chessboard problem;
+	auto data = std::make_shared<ClassificationDataset>(problem.generateDataset(n));
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(0.5);
+	typedef KernelMatrix<RealVector, float> Matrix;
+	auto matrix = std::make_shared<Matrix>(*kernel, data->inputs());
+	auto cache = std::make_shared<CachedMatrix<Matrix> >(matrix.get(), n * n);
+	std::vector<std::size_t> order(n);
+	for(std::size_t i = 0; i != n; ++i){
+		order[i] = Rng::discrete(0, n - 1);
+	}
+	return [data, kernel, matrix, cache, order, n](){
+		for(std::size_t i: order){
+			keep(cache->row(i, 0, n)[0]);
+		}
+	};
+});
+
+//training of a C-SVM, which solves the dual quadratic program with a cached kernel matrix
+RegisterBenchmark csvm("qp/csvm_train", "n", {500, 2000}, [](std::size_t n) -> Workload{
+	Chessboard problem;
+	auto data = std::make_shared<ClassificationDataset>(problem.generateDataset(n));
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(0.5);
+	return [=](){
+		KernelClassifier<RealVector> model;
+		CSvmTrainer<RealVector> trainer(kernel.get(), 10.0, true);
+		trainer.train(model, *data);
+		keep(model.decisionFunction().offset(0));
+	};
+});
+}
@@ -0,0 +1,106 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the Remora linear algebra kernels
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/BLAS/kernels/syrk.hpp>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+RealMatrix randomMatrix(std::size_t rows, std::size_t columns){
+	RealMatrix matrix(rows, columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			matrix(i, j) = Rng::gauss(0, 1);
+		}
+	}
+	return matrix;
+}
+
+//well conditioned symmetric positive definite matrix
+RealMatrix randomSPDMatrix(std::size_t n){
+	RealMatrix A = randomMatrix(n, n);
+	RealMatrix C = A % trans(A);
+	diag(C) += n;
+	return C;
+}
+
+RegisterBenchmark gemv("remora/gemv", "n", {256, 1024, 4096}, [](std::size_t n) -> Workload{
+	RealMatrix A = randomMatrix(n, n);
+	RealVector x = row(randomMatrix(1, n), 0);
+	RealVector y(n);
+	return [=]() mutable{
+		noalias(y) = A % x;
+		keep(y(0));
+	};
+});
+
+RegisterBenchmark gemm("remora/gemm", "n", {128, 256, 512}, [](std::size_t n) -> Workload{
+	RealMatrix A = randomMatrix(n, n);
+	RealMatrix B = randomMatrix(n, n);
+	RealMatrix C(n, n);
+	return [=]() mutable{
+		noalias(C) = A % B;
+		keep(C(0, 0));
+	};
+});
+
+RegisterBenchmark syrk("remora/syrk", "n", {128, 256, 512}, [](std::size_t n) -> Workload{
+	RealMatrix A = randomMatrix(n, n);
+	RealMatrix C(n, n, 0.0);
+	return [=]() mutable{
+		blas::kernels::syrk<false>(A, C, 1.0);
+		keep(C(0, 0));
+	};
+});
+
+RegisterBenchmark potrf("remora/cholesky", "n", {128, 256, 512}, [](std::size_t n) -> Workload{
+	RealMatrix C = randomSPDMatrix(n);
+	return [=](){
+		blas::cholesky_decomposition<RealMatrix> cholesky(C);
+		keep(cholesky.lower_factor()(0, 0));
+	};
+});
+
+RegisterBenchmark syev("remora/eigenvalues", "n", {64, 128, 256}, [](std::size_t n) -> Workload{
+	RealMatrix C = randomSPDMatrix(n);
+	return [=](){
+		blas::symm_eigenvalue_decomposition<RealMatrix> eigen(C);
+		keep(eigen.D()(0));
+	};
+});
+}
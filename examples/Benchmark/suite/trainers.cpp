@@ -0,0 +1,91 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmarks of the trainers
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/Algorithms/KMeans.h>
+#include <shark/Algorithms/Trainers/LinearRegression.h>
+#include <shark/Algorithms/Trainers/RFTrainer.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <memory>
+
+using namespace shark;
+using namespace shark::benchmark;
+
+namespace{
+//linear regression with 50 inputs and 5 outputs
+RegisterBenchmark linearRegression("trainers/linear_regression", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> inputs(n, RealVector(50));
+	std::vector<RealVector> labels(n, RealVector(5));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != 50; ++j) inputs[i](j) = Rng::gauss(0, 1);
+		for(std::size_t j = 0; j != 5; ++j) labels[i](j) = inputs[i](j) + Rng::gauss(0, 0.1);
+	}
+	auto data = std::make_shared<RegressionDataset>(createLabeledDataFromRange(inputs, labels));
+	return [=](){
+		LinearModel<> model;
+		LinearRegression trainer;
+		trainer.train(model, *data);
+		keep(model.offset()(0));
+	};
+});
+
+//random forest with 20 trees
+RegisterBenchmark randomForest("trainers/random_forest", "n", {500, 2000}, [](std::size_t n) -> Workload{
+	Chessboard problem;
+	auto data = std::make_shared<ClassificationDataset>(problem.generateDataset(n));
+	return [=](){
+		RFClassifier model;
+		RFTrainer trainer;
+		trainer.setNTrees(20);
+		trainer.train(model, *data);
+		keep(model.numberOfModels());
+	};
+});
+
+//k-means with 10 clusters in 10 dimensions
+RegisterBenchmark kmeans("trainers/kmeans", "n", {1000, 10000}, [](std::size_t n) -> Workload{
+	std::vector<RealVector> points(n, RealVector(10));
+	for(std::size_t i = 0; i != n; ++i){
+		std::size_t cluster = i % 10;
+		for(std::size_t j = 0; j != 10; ++j) points[i](j) = Rng::gauss(cluster == j? 5.0 : 0.0, 1);
+	}
+	auto data = std::make_shared<Data<RealVector> >(createDataFromRange(points));
+	return [=](){
+		Centroids centroids;
+		keep(kMeans(*data, 10, centroids, 100));
+	};
+});
+}
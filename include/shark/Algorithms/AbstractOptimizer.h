@@ -53,6 +53,8 @@ namespace shark {
 *	- HAS_FIRST_DERIVATIVE must be set
 *	- REQUIRES_SECOND_DERIVATIVE: The second derivative needs to be evaluated and
 *	- HAS_SECOND_DERIVATIVE must be set
+*	- REQUIRES_HESSIAN_VECTOR_PRODUCT: Products of the Hessian with vectors are computed and
+*	- HAS_HESSIAN_VECTOR_PRODUCT must be set
 *	- CAN_SOLVE_CONSTRAINED: The optimizer can solve functions which are constrained and
 *	  where the IS_CONSTRAINED_FEATURE is set.
 *	- REQUIRES_CLOSEST_FEASIBLE: If the function is constrained, it must offer a way to
@@ -83,7 +85,8 @@ public:
 		REQUIRES_FIRST_DERIVATIVE	=  2,
 		REQUIRES_SECOND_DERIVATIVE	=  4,
 		CAN_SOLVE_CONSTRAINED           =  8,
-		REQUIRES_CLOSEST_FEASIBLE       = 16
+		REQUIRES_CLOSEST_FEASIBLE       = 16,
+		REQUIRES_HESSIAN_VECTOR_PRODUCT = 32
 	};
 
 	SHARK_FEATURE_INTERFACE;
@@ -98,6 +101,9 @@ public:
 	bool requiresSecondDerivative()const{
 		return features()& REQUIRES_SECOND_DERIVATIVE;
 	}
+	bool requiresHessianVectorProduct()const{
+		return features()& REQUIRES_HESSIAN_VECTOR_PRODUCT;
+	}
 	bool canSolveConstrained()const{
 		return features()& CAN_SOLVE_CONSTRAINED;
 	}
@@ -143,6 +149,8 @@ protected:
 		SHARK_RUNTIME_CHECK(!requiresFirstDerivative() || objectiveFunction.hasFirstDerivative(), name()+" Requires first derivative of objective function");
 		//test second derivative
 		SHARK_RUNTIME_CHECK(!requiresSecondDerivative() || objectiveFunction.hasSecondDerivative(), name()+" Requires second derivative of objective function");
+		//test hessian vector product
+		SHARK_RUNTIME_CHECK(!requiresHessianVectorProduct() || objectiveFunction.hasHessianVectorProduct(), name()+" Requires hessian vector products of objective function");
 		//test for constraints
 		if(objectiveFunction.isConstrained()){
 			SHARK_RUNTIME_CHECK(canSolveConstrained(), name()+" Can not solve constrained problems");
@@ -62,6 +62,11 @@ namespace shark {
 /// the rank of the average function value is used for updating the strategy parameters
 /// which ensures asymptotic unbiasedness. We further do not have an upper bound on
 /// the number of reevaluations for the same reason.
+///
+/// For large search spaces, all offspring of a generation are sampled with a single matrix product
+/// and the rank-mu update of the covariance matrix is computed in blocks; both are distributed over the threads.
+/// As proposed by Hansen, the eigendecomposition of the covariance matrix is only updated
+/// every \f$ 1/(10n(c_1+c_\mu)) \f$ generations, which is \f$ \mathcal{O}(n/\lambda) \f$.
 class CMA : public AbstractSingleObjectiveOptimizer<RealVector >
 {
 public:
@@ -38,12 +38,46 @@
 
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
 #include <shark/Rng/GlobalRng.h>
+#include <shark/Core/OpenMP.h>
 
 #include <boost/serialization/vector.hpp>
-
+#include <exception>
 
 namespace shark {
 
+namespace detail{
+//! Evaluates the objective function at all points. The points are evaluated
+//! concurrently if the objective function is thread safe.
+//! The values are returned in the order of the points. If evaluations throw,
+//! the exception of the first such point is rethrown after all points are done.
+inline std::vector<double> evaluateSearchPoints(
+	SingleObjectiveFunction const& objectiveFunction,
+	std::vector<RealVector> const& points
+){
+	std::vector<double> values(points.size());
+	if(objectiveFunction.isThreadSafe()){
+		//exceptions must not leave the parallel region, they are rethrown afterwards
+		std::vector<std::exception_ptr> exceptions(points.size());
+		SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)points.size(); ++i){
+			try{
+				values[i] = objectiveFunction.eval(points[i]);
+			}catch(...){
+				exceptions[i] = std::current_exception();
+			}
+		}
+		for(std::size_t i = 0; i != points.size(); ++i){
+			if(exceptions[i])
+				std::rethrow_exception(exceptions[i]);
+		}
+	}else{
+		for(std::size_t i = 0; i != points.size(); ++i){
+			values[i] = objectiveFunction.eval(points[i]);
+		}
+	}
+	return values;
+}
+}
+
 //!
 //! \brief Optimize by trying out a grid of configurations
 //!
@@ -60,6 +94,11 @@ namespace shark {
 //! A more sophisticated (less exhaustive) grid search variant is
 //! available with the NestedGridSearch class.
 //!
+//! \par
+//! If the objective function is thread safe, the grid points are
+//! evaluated in parallel. The best point is the same as in a
+//! sequential evaluation.
+//!
 class GridSearch : public AbstractSingleObjectiveOptimizer<RealVector >
 {
 public:
@@ -280,30 +319,16 @@ public:
 		m_best.value = 1e100;
 		RealVector point(dimensions);
 
-		// loop through all grid points
+		// collect all feasible grid points
+		std::vector<RealVector> points;
 		while (true)
 		{
 			// define the parameters
 			for (size_t dimension = 0; dimension < dimensions; dimension++)
 				point(dimension) = m_nodeValues[dimension][index[dimension]];
 
-			// evaluate the model
 			if (objectiveFunction.isFeasible(point))
-			{
-				double error = objectiveFunction.eval(point);
-
-#ifdef SHARK_CV_VERBOSE_1
-				std::cout << "." << std::flush;
-#endif
-#ifdef SHARK_CV_VERBOSE
-				std::cout << point << "\t" << error << std::endl;
-#endif
-				if (error < m_best.value)
-				{
-					m_best.value = error;
-					m_best.point = point;		// [TG] swap() solution is out, caused ugly memory bug, I changed this back
-				}
-			}
+				points.push_back(point);
 
 			// next index
 			size_t dimension = 0;
@@ -315,6 +340,23 @@ public:
 			}
 			if (dimension == dimensions) break;
 		}
+
+		// evaluate the model
+		std::vector<double> errors = detail::evaluateSearchPoints(objectiveFunction, points);
+		for (size_t i = 0; i != points.size(); ++i)
+		{
+#ifdef SHARK_CV_VERBOSE_1
+			std::cout << "." << std::flush;
+#endif
+#ifdef SHARK_CV_VERBOSE
+			std::cout << points[i] << "\t" << errors[i] << std::endl;
+#endif
+			if (errors[i] < m_best.value)
+			{
+				m_best.value = errors[i];
+				m_best.point = points[i];
+			}
+		}
 #ifdef SHARK_CV_VERBOSE_1
 		std::cout << std::endl;
 #endif
@@ -364,6 +406,10 @@ protected:
 //! error function evaluations in every iteration.
 //!
 //! \par
+//! If the objective function is thread safe, the points of
+//! one grid are evaluated in parallel.
+//!
+//! \par
 //! The grid is always centered around the best
 //! solution currently known. If this solution is
 //! located at the boundary, the landscape may exceed
@@ -488,7 +534,8 @@ public:
 
 		RealVector point=m_best.point;
 
-		// loop through the grid
+		// loop through the grid and collect the points to evaluate
+		std::vector<RealVector> points;
 		while (true)
 		{
 			// compute the grid point,
@@ -505,18 +552,9 @@ public:
 				}
 			}
 
-			// evaluate the grid point
 			if (compute && objectiveFunction.isFeasible(point))
-			{
-				double error = objectiveFunction.eval(point);
+				points.push_back(point);
 
-				// remember the best solution
-				if (error < m_best.value)
-				{
-					m_best.value = error;
-					m_best.point=point;
-				}
-			}
 			// move to the next grid point
 			size_t d = 0;
 			for (; d < dimensions; d++)
@@ -527,6 +565,17 @@ public:
 			}
 			if (d == dimensions) break;
 		}
+
+		// evaluate the grid points and remember the best solution
+		std::vector<double> errors = detail::evaluateSearchPoints(objectiveFunction, points);
+		for (size_t i = 0; i != points.size(); ++i)
+		{
+			if (errors[i] < m_best.value)
+			{
+				m_best.value = errors[i];
+				m_best.point = points[i];
+			}
+		}
 		// decrease the step sizes
 		for(double& step: m_stepsize)
 			step *= 0.5;
@@ -558,6 +607,8 @@ protected:
 //! of values for every axis; see GridSearch for this purpose.
 //! Thus, the PointSearch class allows for more flexibility.
 //!
+//! If the objective function is thread safe, the points are evaluated in parallel.
+//!
 //! If no configure method is called, this class just samples random points.
 //! They are uniformly distributed in [-1,1].
 //! parameters^2 points but minimum 20 are sampled in this case.
@@ -635,18 +686,26 @@ public:
 		m_best.value = 1e100;
 		size_t bestIndex=0;
 
-		// loop through all points
+		// collect all feasible points
+		std::vector<RealVector> points;
+		std::vector<size_t> pointIndices;
 		for (size_t point = 0; point < numPoints; point++)
 		{
-			// evaluate the model
 			if (objectiveFunction.isFeasible(m_points[point]))
 			{
-				double error = objectiveFunction.eval(m_points[point]);
-				if (error < m_best.value)
-				{
-					m_best.value = error;
-					bestIndex=point;
-				}
+				points.push_back(m_points[point]);
+				pointIndices.push_back(point);
+			}
+		}
+
+		// evaluate the model
+		std::vector<double> errors = detail::evaluateSearchPoints(objectiveFunction, points);
+		for (size_t i = 0; i != points.size(); i++)
+		{
+			if (errors[i] < m_best.value)
+			{
+				m_best.value = errors[i];
+				bestIndex=pointIndices[i];
 			}
 		}
 		m_best.point=m_points[bestIndex];
@@ -0,0 +1,303 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Successive halving and Hyperband for budgeted objective functions
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_HYPERBAND_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_HYPERBAND_H
+
+#include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/ObjectiveFunctions/AbstractBudgetedObjectiveFunction.h>
+#include <shark/Rng/GlobalRng.h>
+#include <shark/Core/OpenMP.h>
+
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace shark {
+
+/// \brief Model selection by successive halving of randomly sampled configurations.
+///
+/// Every call to step samples a number of points uniformly from a box and evaluates
+/// them with a small budget, see AbstractBudgetedObjectiveFunction. Only the best
+/// 1/eta of the points are evaluated again with a budget which is eta times larger.
+/// This is repeated until the remaining points are evaluated with the full budget.
+/// Thus most points are discarded after a cheap evaluation,
+/// for example after a few iterations of training or on a few folds of a cross-validation.
+///
+/// The solution is the best point evaluated with the full budget over all steps.
+/// If the objective function is thread safe, the points of one round are evaluated in parallel.
+///
+/// For details see
+/// K. Jamieson and A. Talwalkar: Non-stochastic Best Arm Identification and Hyperparameter Optimization. AISTATS, 2016.
+class SuccessiveHalving : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	SuccessiveHalving()
+	: m_configured(false)
+	, m_eta(3)
+	, m_minimumBudget(1.0/27)
+	, m_numberOfConfigurations(27){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "SuccessiveHalving"; }
+
+	//! samples points in the range [min,max]^parameters
+	void configure(std::size_t parameters, double min, double max){
+		RANGE_CHECK(min <= max);
+		m_minimum = std::vector<double>(parameters, min);
+		m_maximum = std::vector<double>(parameters, max);
+		m_configured = true;
+	}
+
+	//! individual definition of the sampling range for every parameter
+	void configure(std::vector<double> const& min, std::vector<double> const& max){
+		SIZE_CHECK(min.size() == max.size());
+		RANGE_CHECK(min <= max);
+		m_minimum = min;
+		m_maximum = max;
+		m_configured = true;
+	}
+
+	/// \brief Factor by which the number of points is reduced and the budget is increased in every round.
+	double eta()const{
+		return m_eta;
+	}
+	void setEta(double eta){
+		SHARK_RUNTIME_CHECK(eta > 1, "eta must be larger than one");
+		m_eta = eta;
+	}
+
+	/// \brief Lower bound on the budget of the first round.
+	///
+	/// The first round uses the smallest power of 1/eta which is not smaller than this value.
+	double minimumBudget()const{
+		return m_minimumBudget;
+	}
+	void setMinimumBudget(double budget){
+		SHARK_RUNTIME_CHECK(budget > 0 && budget <= 1, "The budget must be in (0,1]");
+		m_minimumBudget = budget;
+	}
+
+	/// \brief Number of points sampled in every step.
+	std::size_t numberOfConfigurations()const{
+		return m_numberOfConfigurations;
+	}
+	void setNumberOfConfigurations(std::size_t configurations){
+		SHARK_RUNTIME_CHECK(configurations > 0, "At least one configuration must be sampled");
+		m_numberOfConfigurations = configurations;
+	}
+
+	virtual void read( InArchive & archive ){
+		archive >> m_minimum;
+		archive >> m_maximum;
+		archive >> m_configured;
+		archive >> m_eta;
+		archive >> m_minimumBudget;
+		archive >> m_numberOfConfigurations;
+		archive >> m_best.point;
+		archive >> m_best.value;
+	}
+
+	virtual void write( OutArchive & archive ) const{
+		archive << m_minimum;
+		archive << m_maximum;
+		archive << m_configured;
+		archive << m_eta;
+		archive << m_minimumBudget;
+		archive << m_numberOfConfigurations;
+		archive << m_best.point;
+		archive << m_best.value;
+	}
+
+	//! If the class wasn't configured before, points are sampled in [-1,1]^n.
+	//! The objective function must be derived from AbstractBudgetedObjectiveFunction.
+	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint) {
+		SHARK_RUNTIME_CHECK(
+			dynamic_cast<AbstractBudgetedObjectiveFunction*>(&objectiveFunction),
+			"The objective function must support budgeted evaluations"
+		);
+		objectiveFunction.init();
+		checkFeatures(objectiveFunction);
+		if(!m_configured)
+			configure(startingPoint.size(), -1, 1);
+		SIZE_CHECK(startingPoint.size() == m_minimum.size());
+		m_best.point = startingPoint;
+		m_best.value = std::numeric_limits<double>::max();
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	//! samples new points and runs successive halving on them
+	void step(ObjectiveFunctionType const& objectiveFunction) {
+		runBracket(objectiveFunction, m_numberOfConfigurations, numberOfRounds(m_minimumBudget));
+	}
+
+protected:
+	/// number of rounds after the first one needed to get from the budget to the full budget
+	std::size_t numberOfRounds(double budget)const{
+		return (std::size_t)std::floor(std::log(1.0 / budget) / std::log(m_eta) + 1.e-10);
+	}
+
+	/// samples the points and evaluates them in rounds+1 rounds, the last one with full budget.
+	void runBracket(ObjectiveFunctionType const& objectiveFunction, std::size_t configurations, std::size_t rounds){
+		AbstractBudgetedObjectiveFunction const& function = dynamic_cast<AbstractBudgetedObjectiveFunction const&>(objectiveFunction);
+
+		std::vector<RealVector> points;
+		for(std::size_t i = 0; i != configurations; ++i){
+			RealVector point(m_minimum.size());
+			for(std::size_t j = 0; j != point.size(); ++j){
+				point(j) = Rng::uni(m_minimum[j], m_maximum[j]);
+			}
+			if(function.isFeasible(point))
+				points.push_back(point);
+		}
+
+		for(std::size_t round = 0; round <= rounds && !points.empty(); ++round){
+			double budget = 1.0 / std::pow(m_eta, double(rounds - round));
+			std::vector<double> values = evaluate(function, points, budget);
+			if(round == rounds){
+				for(std::size_t i = 0; i != points.size(); ++i){
+					if(values[i] < m_best.value){
+						m_best.value = values[i];
+						m_best.point = points[i];
+					}
+				}
+				break;
+			}
+
+			//keep the best points, ties are broken by the order of sampling
+			std::size_t survivors = std::max<std::size_t>(1, (std::size_t)std::floor(points.size() / m_eta));
+			std::vector<std::size_t> order(points.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j){
+				return values[i] < values[j];
+			});
+			std::vector<RealVector> best(survivors);
+			for(std::size_t i = 0; i != survivors; ++i){
+				best[i] = points[order[i]];
+			}
+			points.swap(best);
+		}
+	}
+
+	/// evaluates all points with the budget, in parallel if the function is thread safe
+	std::vector<double> evaluate(
+		AbstractBudgetedObjectiveFunction const& function,
+		std::vector<RealVector> const& points,
+		double budget
+	)const{
+		std::vector<double> values(points.size());
+		if(function.isThreadSafe()){
+			SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)points.size(); ++i){
+				values[i] = function.evalBudgeted(points[i], budget);
+			}
+		}else{
+			for(std::size_t i = 0; i != points.size(); ++i){
+				values[i] = function.evalBudgeted(points[i], budget);
+			}
+		}
+		return values;
+	}
+
+	std::vector<double> m_minimum; ///< lower bounds of the sampling range
+	std::vector<double> m_maximum; ///< upper bounds of the sampling range
+	bool m_configured;
+	double m_eta; ///< reduction factor of the number of points per round
+	double m_minimumBudget; ///< budget of the first round
+	std::size_t m_numberOfConfigurations; ///< number of points sampled per step
+};
+
+/// \brief Hyperband model selection.
+///
+/// Successive halving needs to trade off the number of points against the budget of the
+/// first round: with a small budget, good points might be discarded too early.
+/// Hyperband runs successive halving in brackets with different first budgets,
+/// ranging from the minimum budget with many points to the full budget with few points, as in
+/// a random search. Every bracket uses roughly the same total budget.
+///
+/// Every call to step runs one bracket, starting with the most aggressive one. After the bracket
+/// with the full budget, the next step starts again with the most aggressive bracket.
+/// The number of configurations of SuccessiveHalving is not used, instead bracket s with first budget
+/// \f$ \eta^{-s} \f$ samples \f$ \lceil (s_{max}+1)\eta^s/(s+1) \rceil \f$ points.
+///
+/// For details see
+/// L. Li, K. Jamieson, G. DeSalvo, A. Rostamizadeh and A. Talwalkar:
+/// Hyperband: A Novel Bandit-Based Approach to Hyperparameter Optimization. JMLR 18, 2018.
+class Hyperband : public SuccessiveHalving
+{
+public:
+	Hyperband():m_bracket(0){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "Hyperband"; }
+
+	/// \brief Number of brackets, i.e. the number of steps after which the brackets repeat.
+	std::size_t numberOfBrackets()const{
+		return numberOfRounds(m_minimumBudget) + 1;
+	}
+
+	virtual void read( InArchive & archive ){
+		SuccessiveHalving::read(archive);
+		archive >> m_bracket;
+	}
+
+	virtual void write( OutArchive & archive ) const{
+		SuccessiveHalving::write(archive);
+		archive << m_bracket;
+	}
+
+	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint) {
+		SuccessiveHalving::init(objectiveFunction, startingPoint);
+		m_bracket = 0;
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	//! runs the next bracket
+	void step(ObjectiveFunctionType const& objectiveFunction) {
+		std::size_t brackets = numberOfBrackets();
+		std::size_t rounds = brackets - 1 - m_bracket % brackets;
+		std::size_t configurations = (std::size_t)std::ceil(brackets * std::pow(m_eta, double(rounds)) / (rounds + 1) - 1.e-10);
+		runBracket(objectiveFunction, configurations, rounds);
+		++m_bracket;
+	}
+
+private:
+	std::size_t m_bracket; ///< number of brackets run so far
+};
+
+}
+#endif
@@ -0,0 +1,157 @@
+/*!
+ *
+ *
+ * \brief       Efficient non-dominated sort which processes blocks of points in parallel
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_OPERATORS_DOMINATION_ENSNONDOMINATEDSORT_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_OPERATORS_DOMINATION_ENSNONDOMINATEDSORT_H
+
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace shark {
+
+/// \brief Efficient non-dominated sorting with binary search, parallelized over blocks of points.
+///
+/// Assembles subsets/fronts of mutually non-dominated individuals.
+/// Afterwards every individual is assigned a rank by ranks[i] = frontIndex.
+/// The front of non-dominated points has the value 1.
+///
+/// The algorithm is described in
+/// X. Zhang, Y. Tian, R. Cheng and Y. Jin, "An Efficient Approach to Nondominated Sorting for Evolutionary
+/// Multiobjective Optimization", IEEE Transactions on Evolutionary Computation, vol. 19, no. 2, pp. 201-213, 2015.
+///
+/// After sorting the points lexicographically, a point can only be dominated by points before it.
+/// Its rank is the index of the first front which contains no point dominating it, which can be found by binary search
+/// over the fronts of the previous points. In the original algorithm, the points are inserted one after another.
+/// Here, the points are processed in blocks: the fronts built from the previous blocks are fixed while
+/// the search for all points of the block is done in parallel. Afterwards, the ranks
+/// are corrected for domination by points of the same block and the block is added to the fronts.
+/// The result does not depend on the number of threads.
+///
+/// The algorithm needs only O(n) memory and has a worst case complexity of \f$ \mathcal{O}(n^2 m) \f$.
+/// For many objectives, most points are in the first fronts and the number of dominance checks is
+/// close to the worst case, thus it profits most from the parallelization.
+template<class PointRange, class RankRange>
+void ensNonDominatedSort(PointRange const& points, RankRange& ranks, std::size_t blockSize = 256) {
+	SIZE_CHECK(points.size() == ranks.size());
+	SIZE_CHECK(blockSize > 0);
+	std::size_t n = points.size();
+	if(n == 0) return;
+	std::size_t m = points[0].size();
+
+	//sort lexicographically and store the points contiguously in that order
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j){
+		auto const& x = points[i];
+		auto const& y = points[j];
+		for(std::size_t k = 0; k != m; ++k){
+			if(x[k] < y[k]) return true;
+			if(x[k] > y[k]) return false;
+		}
+		return false;
+	});
+	std::vector<double> values(n * m);
+	for(std::size_t i = 0; i != n; ++i){
+		auto const& point = points[order[i]];
+		SIZE_CHECK(point.size() == m);
+		for(std::size_t k = 0; k != m; ++k){
+			values[i * m + k] = point[k];
+		}
+	}
+
+	//the point i dominates point j if it is not worse in any objective and not equal.
+	//as i is lexicographically not larger than j, we only need to check the first condition and whether they are equal
+	auto dominates = [&](std::size_t i, std::size_t j){
+		double const* x = values.data() + i * m;
+		double const* y = values.data() + j * m;
+		bool equal = true;
+		for(std::size_t k = 0; k != m; ++k){
+			if(x[k] > y[k]) return false;
+			equal &= x[k] == y[k];
+		}
+		return !equal;
+	};
+	//checks whether a point of the front dominates point j.
+	//the last points of a front are lexicographically closest to j and are checked first
+	auto isDominatedByFront = [&](std::vector<std::size_t> const& front, std::size_t j){
+		for(std::size_t pos = front.size(); pos != 0; --pos){
+			if(dominates(front[pos-1], j))
+				return true;
+		}
+		return false;
+	};
+
+	std::vector<std::vector<std::size_t> > fronts;
+	std::vector<std::size_t> sortedRanks(n, 0);//0-based
+	for(std::size_t start = 0; start < n; start += blockSize){
+		std::size_t end = std::min(start + blockSize, n);
+
+		//binary search for the first front of the previous blocks without point dominating the point
+		SHARK_PARALLEL_FOR_DYNAMIC(int j = (int)start; j < (int)end; ++j){
+			std::size_t lower = 0;
+			std::size_t upper = fronts.size();
+			while(lower != upper){
+				std::size_t middle = (lower + upper) / 2;
+				if(isDominatedByFront(fronts[middle], j))
+					lower = middle + 1;
+				else
+					upper = middle;
+			}
+			sortedRanks[j] = lower;
+		}
+
+		//correct for points dominated by earlier points of the same block and add the block to the fronts
+		for(std::size_t j = start; j != end; ++j){
+			for(std::size_t i = start; i != j; ++i){
+				if(sortedRanks[i] >= sortedRanks[j] && dominates(i, j))
+					sortedRanks[j] = sortedRanks[i] + 1;
+			}
+			if(sortedRanks[j] == fronts.size())
+				fronts.emplace_back();
+			fronts[sortedRanks[j]].push_back(j);
+		}
+	}
+
+	for(std::size_t i = 0; i != n; ++i){
+		ranks[order[i]] = sortedRanks[i] + 1;
+	}
+}
+
+//version that takes temporary ranges as second argument.
+template<class PointRange, class RankRange>
+void ensNonDominatedSort(PointRange const& points, RankRange const& ranks, std::size_t blockSize = 256) {
+	RankRange ranksCopy=ranks;
+	ensNonDominatedSort(points,ranksCopy,blockSize);
+}
+
+}
+#endif
@@ -30,6 +30,8 @@
 
 #include "FastNonDominatedSort.h"
 #include "DCNonDominatedSort.h"
+#include "ENSNonDominatedSort.h"
+#include <shark/Core/OpenMP.h>
 
 
 namespace shark {
@@ -42,15 +44,24 @@ namespace shark {
 ///
 /// Depending on dimensionality m and number of points n, either the 
 /// fastNonDominatedSort algorithm with O(n^2 m) or the dcNonDominatedSort
-/// alforithm with complexity O(n log(n)^m) is called.
+/// alforithm with complexity O(n log(n)^m) is called. For large sets with
+/// at least four objectives, the parallel ensNonDominatedSort is used if
+/// enough threads are available for the number of points. On a single thread,
+/// ENS is faster than dcNonDominatedSort for up to roughly 2500 m points,
+/// with three objectives it is always slower.
 template<class PointRange, class RankRange>
 void nonDominatedSort(PointRange const& points, RankRange& ranks) {
 	SIZE_CHECK(points.size() == ranks.size());
 	std::size_t n = points.size();
 	if(n == 0) return;
 	std::size_t m = points[0].size();
+	std::size_t threads = SHARK_IN_PARALLEL? 1 : SHARK_NUM_THREADS;
 	// heuristic switching strategy based on simple benchmarks
-	if (m == 2 || n > 5000 || std::log(n) / log(3.0) < m + 1.0)
+	if (m > 3 && n >= 1000 && n <= 2500 * m * threads)
+	{
+		ensNonDominatedSort(points,ranks);
+	}
+	else if (m == 2 || n > 5000 || std::log(n) / log(3.0) < m + 1.0)
 	{
 		dcNonDominatedSort(points,ranks);
 	}
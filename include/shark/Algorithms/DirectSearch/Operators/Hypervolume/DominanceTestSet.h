@@ -0,0 +1,129 @@
+/*!
+ *
+ * \brief       Point set stored objective-wise for fast dominance tests of samples
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_HYPERVOLUME_DOMINANCETESTSET_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_HYPERVOLUME_DOMINANCETESTSET_H
+
+#include <shark/LinAlg/Base.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace shark {
+/// \brief Set of points which tests samples for weak dominance by the points of the set.
+///
+/// The Monte Carlo hypervolume algorithms test every sample against many points.
+/// Instead of comparing the sample to one point after another, the values of all points
+/// are stored contiguously for every objective (structure of arrays). The points are processed in
+/// chunks and for every objective, the comparison of the chunk is a branch-free loop
+/// which the compiler can vectorize. For this, the largest difference of a point to the sample over all
+/// objectives is computed, and the point dominates the sample if it is not positive. Tests which only need to know whether a point dominates the sample
+/// stop after the first chunk containing such a point. The points are sorted by their first objective
+/// and only the points which are not worse than the sample in this objective are tested.
+///
+/// A point p weakly dominates the sample x if \f$ p_i \leq x_i \f$ for all objectives i.
+class DominanceTestSet{
+public:
+	DominanceTestSet():m_size(0), m_numberOfObjectives(0){}
+
+	/// \brief Stores the points of the set. All points need to have the same number of objectives.
+	template<class Set>
+	explicit DominanceTestSet(Set const& points){
+		m_size = points.size();
+		m_numberOfObjectives = m_size == 0? 0 : points.begin()->size();
+		//sort the points by their first objective
+		std::vector<typename Set::const_iterator> order;
+		for(auto it = points.begin(); it != points.end(); ++it){
+			SIZE_CHECK(it->size() == m_numberOfObjectives);
+			order.push_back(it);
+		}
+		std::sort(order.begin(), order.end(), [](typename Set::const_iterator a, typename Set::const_iterator b){
+			return (*a)(0) < (*b)(0);
+		});
+		m_values.resize(m_size * m_numberOfObjectives);
+		for(std::size_t i = 0; i != m_size; ++i){
+			for(std::size_t j = 0; j != m_numberOfObjectives; ++j){
+				m_values[j * m_size + i] = (*order[i])(j);
+			}
+		}
+	}
+
+	/// \brief Number of points in the set.
+	std::size_t size()const{
+		return m_size;
+	}
+
+	/// \brief Number of points of the set which weakly dominate the sample.
+	template<class VectorType>
+	std::size_t countDominating(VectorType const& sample)const{
+		return test(sample, false);
+	}
+
+	/// \brief Returns true if at least one point of the set weakly dominates the sample.
+	template<class VectorType>
+	bool dominates(VectorType const& sample)const{
+		return test(sample, true) != 0;
+	}
+
+private:
+	static const std::size_t chunkSize = 64;
+
+	template<class VectorType>
+	std::size_t test(VectorType const& sample, bool stopAtFirst)const{
+		SIZE_CHECK(m_size == 0 || sample.size() == m_numberOfObjectives);
+		//largest difference between the objectives of a point and the sample. the point dominates if it is not positive
+		double difference[chunkSize];
+		std::size_t count = 0;
+		if(m_size == 0) return 0;
+		std::size_t end = std::upper_bound(m_values.begin(), m_values.begin() + m_size, sample(0)) - m_values.begin();
+		for(std::size_t start = 0; start < end; start += chunkSize){
+			std::size_t length = end - start < chunkSize? end - start : chunkSize;
+			std::fill(difference, difference + length, -std::numeric_limits<double>::infinity());
+			for(std::size_t j = 0; j != m_numberOfObjectives; ++j){
+				double const* values = m_values.data() + j * m_size + start;
+				double x = sample(j);
+				for(std::size_t i = 0; i != length; ++i){
+					double d = values[i] - x;
+					difference[i] = difference[i] > d? difference[i] : d;
+				}
+			}
+			for(std::size_t i = 0; i != length; ++i){
+				count += difference[i] <= 0;
+			}
+			if(stopAtFirst && count != 0)
+				return count;
+		}
+		return count;
+	}
+
+	std::size_t m_size;
+	std::size_t m_numberOfObjectives;
+	std::vector<double> m_values; ///< values of objective j of all points are stored in m_values[j*m_size, (j+1)*m_size)
+};
+}
+#endif
@@ -32,11 +32,15 @@
 #ifndef HYPERVOLUME_APPROXIMATOR_H
 #define HYPERVOLUME_APPROXIMATOR_H
 
-#include <shark/Algorithms/DirectSearch/Operators/Domination/ParetoDominance.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/DominanceTestSet.h>
 #include <shark/Statistics/Distributions/MultiNomialDistribution.h>
+#include <shark/Core/OpenMP.h>
 
 #include <shark/LinAlg/Base.h>
 
+#include <cmath>
+#include <vector>
+
 namespace shark {
 
 /// \brief Implements an FPRAS for approximating the volume of a set of high-dimensional objects.
@@ -49,7 +53,21 @@ namespace shark {
 /// The algorithm computes an approximation of the true Volume V, V' that fulfills
 /// \f[ P((1-epsilon)V < V' <(1+epsilon)V') < 1-\delta \f]
 ///
+/// A box is chosen with probability proportional to its volume and a sample is drawn uniformly inside the box.
+/// If c is the number of boxes containing the sample, the mean of 1/c times the sum of the box volumes
+/// is an unbiased estimate of the volume of the union. c is computed by testing the sample
+/// against all points at once using a DominanceTestSet.
+///
+/// Samples are drawn in rounds of blocks which are processed in parallel. Every block has its own random number
+/// stream seeded from the global Rng, thus the result does not depend on the number of threads. After every round,
+/// an empirical Bernstein bound on the deviation of the mean is computed and the algorithm stops
+/// as soon as it guarantees the relative error epsilon. The error probabilities of the rounds add up to delta.
+/// The rounds grow geometrically so that only few rounds are needed.
+/// As 1/c lies in [1/n,1] for n points, the variance is small when boxes do not overlap much and only few samples are needed.
 struct HypervolumeApproximator {
+	HypervolumeApproximator()
+	: m_epsilon(1.e-2)
+	, m_delta(1.e-2){}
 	
 	template<typename Archive>
 	void serialize( Archive & archive, const unsigned int version ) {
@@ -83,55 +101,81 @@ struct HypervolumeApproximator {
 		if( noPoints == 0 )
 			return 0;
 
-		// runtime (O.K: added static_cast to prevent warning on VC10)
-		boost::uint_fast64_t maxSamples=static_cast<boost::uint_fast64_t>( 12. * std::log( 1. / delta() ) / std::log( 2. ) * noPoints/sqr(epsilon()) ); 
-
 		// calc separate volume of each box
-		VectorType vol( noPoints, 1. );
-		for( std::size_t p = 0; p != noPoints; ++p) {
+		RealVector vol( noPoints, 1. );
+		std::vector<RealVector> lower(noPoints);
+		std::size_t p = 0;
+		for(auto const& point: points) {
 			//guard against points which are worse than the reference
 			SHARK_RUNTIME_CHECK(
-				min(refPoint - points[p] ) >= 0,
+				min(refPoint - point ) >= 0,
 				"HyperVolumeApproximator: points must be better than reference point"
 			);
+			lower[p] = point;
 			//taking the sum of logs instead of their product is numerically more stable in large dimensions were intermediate volumes can become very small or large
-			vol[p] = std::exp(sum(log(refPoint[ 0 ] - points[p] )));
+			vol[p] = std::exp(sum(log(refPoint - point )));
+			++p;
 		}
 		//calculate total sum of volumes
 		double totalVolume = sum(vol);
+		if(totalVolume == 0)
+			return 0;
 		
-		VectorType rndpoint( refPoint );
-		boost::uint_fast64_t samples_sofar=0;
-		boost::uint_fast64_t round=0;
-		
+		DominanceTestSet boxes(lower);
 		//we pick points randomly based on their volume
 		MultiNomialDistribution pointDist(vol);
-
-		while (true)
-		{
-			// sample ROI based on its volume. the ROI is defined as the Area between the reference point and a point in the front.
-			auto point = points.begin() + pointDist(Rng::globalRng);
-			
-			// sample point in ROI   
-			for( std::size_t i = 0; i < rndpoint.size(); i++ ){
-				rndpoint[i] = (*point )[i] + Rng::uni() * ( refPoint[i] - (*point)[i] );
+		
+		double range = 1.0 - 1.0 / noPoints;
+		double sumInverse = 0;
+		double sumSquaredInverse = 0;
+		std::size_t samples = 0;
+		double blockSize = initialBlockSize;
+		for(std::size_t round = 1; ; ++round){
+			std::vector<unsigned int> seeds(blocksPerRound);
+			for(auto& seed: seeds)
+				seed = Rng::globalRng();
+			std::vector<double> blockSum(blocksPerRound, 0.0);
+			std::vector<double> blockSquaredSum(blocksPerRound, 0.0);
+			SHARK_PARALLEL_FOR(int b = 0; b < (int)blocksPerRound; ++b){
+				DefaultRngType rng(seeds[b]);
+				RealVector sample(refPoint.size());
+				for(std::size_t s = 0; s != (std::size_t)blockSize; ++s){
+					// sample ROI based on its volume. the ROI is defined as the Area between the reference point and a point in the front.
+					std::size_t box = pointDist(rng);
+					// sample point in ROI
+					for( std::size_t i = 0; i < sample.size(); i++ ){
+						sample(i) = uni(rng, lower[box](i), refPoint(i));
+					}
+					double inverse = 1.0 / std::max<std::size_t>(boxes.countDominating(sample), 1);
+					blockSum[b] += inverse;
+					blockSquaredSum[b] += inverse * inverse;
+				}
 			}
-
-			while (true)
-			{
-				if (samples_sofar>=maxSamples) return maxSamples * totalVolume / noPoints / round;
-				auto candidate = points.begin() + static_cast<std::size_t>(noPoints*Rng::uni());
-				samples_sofar++;
-				DominanceRelation rel = dominance(*candidate, rndpoint);
-				if (rel == LHS_DOMINATES_RHS || rel == EQUIVALENT) break;
-
-			} 
-
-			round++;
+			//sum up in fixed order so that the result does not depend on the scheduling
+			for(std::size_t b = 0; b != blocksPerRound; ++b){
+				sumInverse += blockSum[b];
+				sumSquaredInverse += blockSquaredSum[b];
+			}
+			samples += blocksPerRound * (std::size_t)blockSize;
+			
+			//empirical Bernstein bound (Maurer and Pontil, 2009) for both sides with error probability delta/(round*(round+1))
+			double mean = sumInverse / samples;
+			double variance = std::max(0.0, (sumSquaredInverse - samples * mean * mean) / (samples - 1));
+			double logFactor = std::log(4.0 * round * (round + 1) / m_delta);
+			double deviation = std::sqrt(2 * variance * logFactor / samples) + 7 * range * logFactor / (3 * (samples - 1));
+			//|mean - E[mean]| <= deviation <= epsilon*(mean - deviation) <= epsilon * E[mean]
+			if(deviation <= m_epsilon * (mean - deviation))
+				return totalVolume * mean;
+			//grow the rounds geometrically, so that the number of rounds and thus the bound grow only slowly
+			blockSize *= blockGrowth;
 		}
 	}
 	
 private:
+	static const std::size_t blocksPerRound = 16; ///< number of independent random streams per round
+	static const std::size_t initialBlockSize = 256; ///< number of samples drawn from a stream in the first round
+	static constexpr double blockGrowth = 1.25; ///< factor by which the number of samples grows in every round
+	
 	double m_epsilon;
 	double m_delta;
 };
@@ -31,6 +31,7 @@
 #define SHARK_ALGORITHMS_DIRECTSEARCH_HYPERVOLUMECALCULATOR_MD_WFG_H
 
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Algorithms/DirectSearch/Operators/Domination/NonDominatedSort.h>
 #include <algorithm>
 #include <vector>
@@ -49,6 +50,17 @@ namespace shark {
 ///
 /// We do not implement slicing as the paper showed that it does have only small impact
 /// while it increases the algorithm complexity dramatically.
+///
+/// The points are sorted in descending order of one objective before the exclusive volumes are computed.
+/// This way, the objective is constant in all limited sets. In every level of the recursion,
+/// we choose the objective with the largest range, i.e. one which is not constant already. Thus
+/// every level removes one more degree of freedom and more points are dominated after limiting.
+/// A point which covers the whole box after limiting is detected early and its subtree is skipped.
+///
+/// The exclusive volumes of the points of large sets are computed in OpenMP tasks, including those in the recursion.
+/// Thus idle threads pick up the work of expensive subtrees. If the algorithm is called inside a
+/// parallel region, for example by HypervolumeContributionMD, the tasks are shared with the other threads
+/// of the region. The volumes are summed in a fixed order, thus the result does not depend on the number of threads.
 struct HypervolumeCalculatorMDWFG {
 
 	/// \brief Executes the algorithm.
@@ -60,15 +72,26 @@ struct HypervolumeCalculatorMDWFG {
 			return 0;
 		SIZE_CHECK( points.begin()->size() == refPoint.size() );
 		
-		std::vector<VectorType> set(points.begin(),points.end());
-		std::sort( set.begin(), set.end(), [ ](VectorType const& x, VectorType const& y){return x.front() > y.front();});
-		return wfg(set,refPoint);
+		std::vector<RealVector> set(points.begin(),points.end());
+		sortPoints(set);
+		if(set.size() < minTaskPoints || SHARK_IN_PARALLEL || SHARK_NUM_THREADS == 1)
+			return wfg(set,refPoint);
+		
+		double volume = 0;
+		SHARK_PARALLEL_REGION
+		{
+			SHARK_SINGLE
+			volume = wfg(set,refPoint);
+		}
+		return volume;
 	}
 	
 private:
+	/// \brief Minimum number of points for which the exclusive volumes are computed in tasks.
+	static const std::size_t minTaskPoints = 16;
 	
-	template<class Set, class VectorType>
-	double wfg(Set const& points, VectorType const& refPoint)const{
+	template<class VectorType>
+	double wfg(std::vector<RealVector> const& points, VectorType const& refPoint)const{
 		//first handle a few special cases as they are likely faster to compute than the recursion
 		std::size_t n = points.size(); 
 		if(n == 0){
@@ -91,24 +114,44 @@ private:
 		//allows us to throw points away which do not affect the volume.
 		//This makes the algorithm fast as we can hope to throw away
 		//points quickly in early iterations.
-		double volume = 0;
-		for(std::size_t i = 0; i != points.size(); ++i){
+		std::vector<double> volumes(n, 0.0);
+		auto exclusiveVolume = [&](std::size_t i){
 			auto const& point = points[i];
 			//compute restricted pointset wrt point
 			std::vector<RealVector> pointset( points.begin()+i+1, points.end() );
-			limitSet(pointset,point);
+			if(!limitSet(pointset,point))
+				return;//point is covered by another point
 			
 			double baseVol = boxVolume(point,refPoint);
-			volume += baseVol - wfg(pointset,refPoint);
+			volumes[i] = baseVol - wfg(pointset,refPoint);
+		};
+		for(std::size_t i = 0; i != n; ++i){
+			//the last points are limited by only a few points and are computed directly
+			if(n - i >= minTaskPoints){
+				SHARK_TASK
+				exclusiveVolume(i);
+			}else{
+				exclusiveVolume(i);
+			}
+		}
+		SHARK_TASKWAIT
+		
+		double volume = 0;
+		for(double v: volumes){
+			volume += v;
 		}
 		return volume;
 	}
 
 	/// \brief Restrict the points to the area covered by point and remove all points which are then dominated
-	template<class Pointset, class Point>
-	void limitSet(Pointset& pointset, Point const& point) const{
+	///
+	/// Returns false if one of the restricted points is equal to point, i.e. the box of point is completely covered.
+	template<class Point>
+	bool limitSet(std::vector<RealVector>& pointset, Point const& point) const{
 		for(auto& p: pointset){
 			noalias(p) = max(p,point);
+			if(std::equal(p.begin(), p.end(), point.begin()))
+				return false;
 		}
 		std::vector<std::size_t> ranks(pointset.size());
 		nonDominatedSort(pointset,ranks);
@@ -126,9 +169,23 @@ private:
 			}
 		}
 		pointset.erase(pointset.begin() +end, pointset.end());
-		std::sort( pointset.begin(), pointset.end(), [ ](Point const& x, Point const& y){return x.front() > y.front();});
+		sortPoints(pointset);
+		return true;
+	}
 	
+	/// \brief Sorts the points in descending order of the objective with the largest range.
+	void sortPoints(std::vector<RealVector>& pointset)const{
+		if(pointset.size() < 2) return;
+		RealVector minimum = pointset[0];
+		RealVector maximum = pointset[0];
+		for(auto const& p: pointset){
+			noalias(minimum) = min(minimum,p);
+			noalias(maximum) = max(maximum,p);
+		}
+		std::size_t objective = arg_max(maximum - minimum);
+		std::sort( pointset.begin(), pointset.end(), [=](RealVector const& x, RealVector const& y){return x(objective) > y(objective);});
 	}
+	
 	template<class Point1, class Point2>
 	double boxVolume(Point1 const& p,Point2 const& ref) const {
 		double volume = 1;
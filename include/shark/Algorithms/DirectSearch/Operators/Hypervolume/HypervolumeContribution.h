@@ -54,6 +54,11 @@ struct HypervolumeContribution {
 		m_useApproximation = useApproximation;
 	}
 	
+	///\brief Returns whether the hypervolume approximation is used in dimensions > 3.
+	bool useApproximation()const{
+		return m_useApproximation;
+	}
+	
 	double approximationEpsilon()const{
 		return m_approximationAlgorithm.epsilon();
 	}
@@ -37,6 +37,9 @@
 
 #include <shark/Algorithms/DirectSearch/Operators/Domination/ParetoDominance.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/DominanceTestSet.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
 #include <algorithm>
 #include <limits>
 #include <vector>
@@ -61,12 +64,16 @@ namespace shark {
 /// the algorithm will run for many iterations, until the bound above holds. The same holds if the point with the smallest contribution
 /// has a very large potential contribution as many samples are required to establish that allmost all of the box is covered.
 ///
+/// The points are sampled in parallel. Every point has its own random number stream which is seeded from the global Rng,
+/// thus the result does not depend on the number of threads. The samples are tested against the influencing points
+/// of a box using a DominanceTestSet.
+///
 ///\tparam Rng The type of the Rng for sampling random points.
 struct HypervolumeContributionApproximator{
 	/// \brief Models a point and associated information for book-keeping purposes.
 	template<typename VectorType>
 	struct Point {
-		Point( VectorType const& point, VectorType const& reference ) 
+		Point( VectorType const& point, VectorType const& reference, unsigned int seed ) 
 		: point( point )
 		, sample( point.size() )
 		, boundingBox( reference )
@@ -77,12 +84,14 @@ struct HypervolumeContributionApproximator{
 		, computedExactly(false)
 		, noSamples( 0 )
 		, noSuccessfulSamples( 0 )
+		, rng( seed )
 		{}
 
 		VectorType point;
 		VectorType sample;
 		VectorType boundingBox;
 		std::vector< typename std::vector<Point>::const_iterator > influencingPoints;
+		DominanceTestSet influencingSet; ///< the influencing points, stored for fast dominance tests
 
 		double boundingBoxVolume;
 		double approximatedContribution;
@@ -92,6 +101,7 @@ struct HypervolumeContributionApproximator{
 		
 		std::size_t noSamples;
 		std::size_t noSuccessfulSamples;
+		DefaultRngType rng; ///< random number stream used for sampling the box
 	};
 
 	double m_startDeltaMultiplier;
@@ -149,7 +159,7 @@ struct HypervolumeContributionApproximator{
 				
 		std::vector< Point<VectorType> > front;
 		for(auto const& point: points) {
-			front.emplace_back( point, reference );
+			front.emplace_back( point, reference, Rng::globalRng() );
 		}
 		computeBoundingBoxes( front );
 		
@@ -195,7 +205,7 @@ struct HypervolumeContributionApproximator{
 		std::vector< Point<RealVector> > front;
 		front.reserve( points.size() );
 		for(auto const& point: points){
-			front.emplace_back( point, reference );
+			front.emplace_back( point, reference, Rng::globalRng() );
 		}
 		computeBoundingBoxes( front );
 		
@@ -245,8 +255,9 @@ private:
 			}
 			
 			//sample all active points so that their individual deviations are smaller than delta
-			for( auto point: activePoints )
-				sample( *point, round, delta, n );
+			SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)activePoints.size(); ++i){
+				sample( *activePoints[i], round, delta, n );
+			}
 
 			//find the current least contributor
 			auto minimalElement = std::min_element(
@@ -322,11 +333,10 @@ private:
 			//sample a point inside the box
 			point.sample.resize(point.point.size());
 			for( unsigned int i = 0; i < point.sample.size(); i++ ) {
-				point.sample[ i ] =  Rng::uni( point.point[ i ], point.boundingBox[ i ] );
+				point.sample[ i ] =  uni( point.rng, point.point[ i ], point.boundingBox[ i ] );
 			}
-			++point.noSamples;
 			//check if the point is not dominated by any of the influencing points
-			if( !isPointDominated( point.influencingPoints, point.sample ) )
+			if( !point.influencingSet.dominates( point.sample ) )
 				point.noSuccessfulSamples++;
 		}
 
@@ -338,25 +348,6 @@ private:
 		point.contributionUpperBound = point.approximatedContribution + deltaReached;
 	}
 	
-	/// \brief Checks whether a point is dominated by any point in a given set.
-	///
-	/// \tparam Set The type of the set of points.
-	///
-	/// \param [in] set The set of individuals to check the sampled point against.
-	/// \param [in] point Point to test
-	///
-	/// \returns true if the point was non-dominated
-	template<typename Set, typename VectorType>
-	bool isPointDominated( Set const& set, VectorType const& point )const{
-		
-		for( unsigned int i = 0; i < set.size(); i++ ) {
-			DominanceRelation rel = dominance(set[i]->point, point);
-			if (rel == LHS_DOMINATES_RHS)
-				return true;
-		}
-		return false;
-	}
-
 	/// \brief Computes bounding boxes and their volume for the range of points defined by the iterators.
 	template<class Set>
 	void computeBoundingBoxes(Set& set )const{
@@ -407,6 +398,11 @@ private:
 					it->influencingPoints.push_back( itt );
 				}
 			}
+			std::vector<RealVector> influencing;
+			for(auto const& influencingPoint: it->influencingPoints){
+				influencing.push_back(influencingPoint->point);
+			}
+			it->influencingSet = DominanceTestSet(influencing);
 		}
 	}
 	template<class VectorType>
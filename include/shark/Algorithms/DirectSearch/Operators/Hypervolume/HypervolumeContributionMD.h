@@ -54,7 +54,7 @@ struct HypervolumeContributionMD {
 		SHARK_RUNTIME_CHECK(points.size() >= k, "There must be at least k points in the set");
 		HypervolumeCalculator hv;
 		std::vector<KeyValuePair<double,std::size_t> > result( points.size() );
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			auto const& point = points[i];
 			
 			//compute restricted pointset
@@ -81,7 +81,7 @@ struct HypervolumeContributionMD {
 		SHARK_RUNTIME_CHECK(points.size() >= k, "There must be at least k points in the set");
 		HypervolumeCalculator hv;
 		std::vector<KeyValuePair<double,std::size_t> > result( points.size() );
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			auto const& point = points[i];
 			
 			//compute restricted pointset
@@ -123,7 +123,7 @@ struct HypervolumeContributionMD {
 		}
 		HypervolumeCalculator hv;
 		std::vector<KeyValuePair<double,std::size_t> > result;
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			if(std::find(minIndex.begin(),minIndex.end(),i) != minIndex.end())
 				continue;
 			
@@ -171,7 +171,7 @@ struct HypervolumeContributionMD {
 		
 		HypervolumeCalculator hv;
 		std::vector<KeyValuePair<double,std::size_t> > result;
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			if(std::find(minIndex.begin(),minIndex.end(),i) != minIndex.end())
 				continue;
 			auto const& point = points[i];
@@ -0,0 +1,208 @@
+/*!
+ *
+ * \brief       Hypervolume contributions of a set which changes by single points
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_HYPERVOLUME_INCREMENTAL_CONTRIBUTION_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_HYPERVOLUME_INCREMENTAL_CONTRIBUTION_H
+
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/utility/KeyValuePair.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContribution.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/NonDominatedSort.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace shark {
+/// \brief Maintains the hypervolume contributions of a set of points under insertion and removal of single points.
+///
+/// Inserting a point p into the set S lowers the contribution of every point q by the volume
+/// which is dominated by both p and q but by no other point of S, i.e. the contribution of the point
+/// max(p,q) to S without q. Removing p raises the contribution of q by the same volume w.r.t. S without p and q.
+/// As in HypervolumeContributionMD, this volume is computed by restricting the remaining points to the box
+/// [max(p,q),ref] and removing the points which are dominated afterwards.
+///
+/// An update still visits all n points of the set and tests each of them against all other points,
+/// thus it costs at least O(n^2 m). The saving over a full recomputation is that the restricted-set
+/// hypervolume is only computed for the neighbours of p, i.e. the points which share part of their
+/// exclusively dominated volume with p. For all other points, a point of the set covering the box
+/// is found by the cheap dominance test and the change is zero.
+///
+/// The contributions of the initial set are computed with HypervolumeContribution.
+struct IncrementalHypervolumeContribution {
+	/// \brief Removes all points and sets the reference point.
+	void init(RealVector const& reference){
+		m_reference = reference;
+		m_points.clear();
+		m_contributions.clear();
+	}
+
+	/// \brief Replaces the set by the given points and computes their contributions from scratch.
+	template<class Set>
+	void assign(Set const& points, RealVector const& reference){
+		init(reference);
+		m_points.assign(points.begin(), points.end());
+		m_contributions.resize(m_points.size());
+		if(m_points.empty()) return;
+		HypervolumeContribution algorithm;
+		auto contributions = algorithm.smallest(m_points, m_points.size(), m_reference);
+		for(auto const& contribution: contributions){
+			m_contributions[contribution.value] = contribution.key;
+		}
+	}
+
+	/// \brief Reference point of the hypervolume.
+	RealVector const& reference()const{
+		return m_reference;
+	}
+
+	/// \brief Number of points in the set.
+	std::size_t size()const{
+		return m_points.size();
+	}
+
+	/// \brief Returns the i-th point of the set. Points are stored in the order of insertion.
+	RealVector const& point(std::size_t i)const{
+		SIZE_CHECK(i < size());
+		return m_points[i];
+	}
+
+	/// \brief Returns the hypervolume contribution of the i-th point.
+	double contribution(std::size_t i)const{
+		SIZE_CHECK(i < size());
+		return m_contributions[i];
+	}
+
+	/// \brief Adds a point to the set and updates the contributions of all points.
+	///
+	/// The point is stored at the end of the set.
+	/// \param [in] point The new point, it needs to fulfill \f$ p \preceq \vec{r}\f$.
+	void insert(RealVector const& point){
+		SIZE_CHECK(point.size() == m_reference.size());
+		std::size_t n = m_points.size();
+		std::vector<double> changes(n, 0.0);
+		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( n ); i++ ) {
+			//a point without contribution can not lose volume
+			if(m_contributions[i] > 0)
+				changes[i] = exclusiveVolume(max(m_points[i], point), i, n);
+		}
+		for(std::size_t i = 0; i != n; ++i){
+			m_contributions[i] -= changes[i];
+		}
+		m_contributions.push_back(exclusiveVolume(point, n, n));
+		m_points.push_back(point);
+	}
+
+	/// \brief Removes the i-th point from the set and updates the contributions of all other points.
+	///
+	/// The order of the remaining points is unchanged.
+	void remove(std::size_t index){
+		SIZE_CHECK(index < size());
+		std::size_t n = m_points.size();
+		RealVector const& point = m_points[index];
+		std::vector<double> changes(n, 0.0);
+		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( n ); i++ ) {
+			if(static_cast<std::size_t>(i) != index)
+				changes[i] = exclusiveVolume(max(m_points[i], point), i, index);
+		}
+		for(std::size_t i = 0; i != n; ++i){
+			m_contributions[i] += changes[i];
+		}
+		m_points.erase(m_points.begin() + index);
+		m_contributions.erase(m_contributions.begin() + index);
+	}
+
+	/// \brief Returns the index of the points with smallest contribution as well as their contribution.
+	///
+	/// Ties are broken by the index of the points.
+	std::vector<KeyValuePair<double,std::size_t> > smallest(std::size_t k)const{
+		SHARK_RUNTIME_CHECK(size() >= k, "There must be at least k points in the set");
+		std::vector<KeyValuePair<double,std::size_t> > result;
+		for(std::size_t i = 0; i != size(); ++i){
+			result.emplace_back(m_contributions[i], i);
+		}
+		std::sort(result.begin(),result.end());
+		result.erase(result.begin()+k,result.end());
+		return result;
+	}
+
+private:
+	/// \brief Volume dominated by x but by no point of the set except the two skipped points.
+	double exclusiveVolume(RealVector const& x, std::size_t skip1, std::size_t skip2)const{
+		double volume = 1.0;
+		for(std::size_t j = 0; j != x.size(); ++j){
+			if(x(j) >= m_reference(j)) return 0.0;
+			volume *= m_reference(j) - x(j);
+		}
+
+		//if a point dominates x, it covers the whole box [x,ref] and nothing is left
+		for(std::size_t i = 0; i != m_points.size(); ++i){
+			if(i == skip1 || i == skip2) continue;
+			RealVector const& p = m_points[i];
+			bool covers = true;
+			for(std::size_t j = 0; j != x.size() && covers; ++j){
+				covers = p(j) <= x(j);
+			}
+			if(covers) return 0.0;
+		}
+
+		//restrict the points to the box [x,ref]
+		std::vector<RealVector> pointset;
+		for(std::size_t i = 0; i != m_points.size(); ++i){
+			if(i == skip1 || i == skip2) continue;
+			RealVector const& p = m_points[i];
+			bool inside = true;
+			for(std::size_t j = 0; j != x.size() && inside; ++j){
+				inside = p(j) < m_reference(j);
+			}
+			if(inside) pointset.push_back(max(p, x));
+		}
+		if(pointset.empty()) return volume;
+
+		//remove the points which are dominated after the restriction
+		std::vector<std::size_t> ranks(pointset.size());
+		nonDominatedSort(pointset,ranks);
+		std::size_t end = 0;
+		for(std::size_t i = 0; i != pointset.size(); ++i){
+			if(ranks[i] == 1)
+				std::swap(pointset[end++], pointset[i]);
+		}
+		pointset.erase(pointset.begin() + end, pointset.end());
+
+		HypervolumeCalculator hv;
+		return volume - hv(pointset, m_reference);
+	}
+
+	RealVector m_reference;
+	std::vector<RealVector> m_points;
+	std::vector<double> m_contributions;
+};
+
+}
+#endif
@@ -35,8 +35,10 @@
 #include <shark/Core/Exception.h>
 #include <shark/Core/OpenMP.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContribution.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/IncrementalHypervolumeContribution.h>
 
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 namespace shark {
@@ -50,13 +52,24 @@ namespace shark {
 /// Note, that for boundary points that are not extrema, this does not hold and they are selected.
 ///
 /// for problems with many objectives, an approximative algorithm can be used.
+///
+/// For four or more objectives, the exact contributions are kept between calls
+/// in an IncrementalHypervolumeContribution. If the front differs from the front of the previous
+/// call only by a few points, as in steady-state algorithms, the contributions are updated
+/// instead of recomputed. The points selected by leastContributor(s) are removed from the cache as well.
+/// With three objectives, the O(n log n) algorithm of HypervolumeContribution3D is faster than the updates.
+/// As the cache is modified, leastContributor(s) must not be called concurrently on the same object,
+/// even though they are const.
 struct HypervolumeIndicator {
+	HypervolumeIndicator():m_useIncrementalUpdates(true){}
+
 	/// \brief Determines the point contributing the least hypervolume to the overall front of points.
 	///
 	/// \param [in] front pareto front of points
 	template<typename ParetoFrontType, typename ParetoArchive>
 	std::size_t leastContributor( ParetoFrontType const& front, ParetoArchive const& /*archive*/)const{
-		HypervolumeContribution algorithm;
+		if(canUseCache(front))
+			return leastContributorsIncremental(std::vector<RealVector>(front.begin(),front.end()), 1)[0];
 		if(m_reference.size() != 0)
 			return m_algorithm.smallest(front,1,m_reference)[0].value;
 		else	
@@ -67,6 +80,8 @@ struct HypervolumeIndicator {
 	std::vector<std::size_t> leastContributors( ParetoFrontType const& front, ParetoArchive const& archive, std::size_t K)const{
 		std::vector<std::size_t> indices;
 		std::vector<RealVector> points(front.begin(),front.end());
+		if(canUseCache(points))
+			return leastContributorsIncremental(points, K);
 		std::vector<std::size_t> activeIndices(points.size());
 		std::iota(activeIndices.begin(),activeIndices.end(),0);
 		for(std::size_t k=0; k != K; ++k){
@@ -94,6 +109,17 @@ struct HypervolumeIndicator {
 		m_algorithm.useApproximation(useApproximation);
 	}
 	
+	/// \brief Whether the contributions are updated between calls instead of recomputed.
+	///
+	/// Only used for exact computations with four or more objectives.
+	void useIncrementalUpdates(bool useIncrementalUpdates){
+		m_useIncrementalUpdates = useIncrementalUpdates;
+		m_cache.init(RealVector());
+	}
+	bool useIncrementalUpdates()const{
+		return m_useIncrementalUpdates;
+	}
+	
 	///\brief Error bound for the approximative algorithm
 	double approximationEpsilon()const{
 		return m_algorithm.approximationEpsilon();
@@ -117,11 +143,118 @@ struct HypervolumeIndicator {
 	void serialize( Archive & archive, const unsigned int version ) {
 		archive & BOOST_SERIALIZATION_NVP( m_reference );
 		archive & BOOST_SERIALIZATION_NVP( m_algorithm );
+		archive & BOOST_SERIALIZATION_NVP( m_useIncrementalUpdates );
+		//the cached contributions belong to the front of the last call before loading
+		if(Archive::is_loading::value)
+			m_cache.init(RealVector());
 	}
 
 private:
+	/// \brief Maximum number of inserted and removed points for which the cached contributions are updated.
+	static const std::size_t maxIncrementalChanges = 2;
+
+	/// \brief Whether the cached contributions are used for the front.
+	template<class Front>
+	bool canUseCache(Front const& front)const{
+		return m_useIncrementalUpdates && !front.empty() && front.begin()->size() >= 4 && !m_algorithm.useApproximation();
+	}
+
+	/// \brief Removes the K least contributors one by one, keeping the cached contributions up to date.
+	std::vector<std::size_t> leastContributorsIncremental(std::vector<RealVector> points, std::size_t K)const{
+		std::vector<std::size_t> indices;
+		std::vector<std::size_t> activeIndices(points.size());
+		std::iota(activeIndices.begin(),activeIndices.end(),0);
+		for(std::size_t k=0; k != K; ++k){
+			std::vector<std::size_t> cacheIndices = synchronize(points);
+
+			//without reference point, the points with the smallest value of an objective are never selected
+			std::vector<bool> candidate(points.size(), true);
+			if(m_reference.size() == 0){
+				for(std::size_t j = 0; j != points[0].size(); ++j){
+					std::size_t minIndex = 0;
+					for(std::size_t i = 1; i != points.size(); ++i){
+						if(points[i](j) < points[minIndex](j))
+							minIndex = i;
+					}
+					candidate[minIndex] = false;
+				}
+				if(std::find(candidate.begin(), candidate.end(), true) == candidate.end())
+					std::fill(candidate.begin(), candidate.end(), true);
+			}
+			std::size_t index = points.size();
+			for(std::size_t i = 0; i != points.size(); ++i){
+				if(!candidate[i]) continue;
+				if(index == points.size() || m_cache.contribution(cacheIndices[i]) < m_cache.contribution(cacheIndices[index]))
+					index = i;
+			}
+
+			m_cache.remove(cacheIndices[index]);
+			points.erase(points.begin()+index);
+			indices.push_back(activeIndices[index]);
+			activeIndices.erase(activeIndices.begin()+index);
+		}
+		return indices;
+	}
+
+	/// \brief Brings the cache to the state of the given points and returns the position of each point in the cache.
+	std::vector<std::size_t> synchronize(std::vector<RealVector> const& points)const{
+		RealVector reference = m_reference;
+		if(reference.size() == 0){
+			reference = points[0];
+			for(auto const& point: points)
+				noalias(reference) = max(reference,point);
+		}
+
+		std::size_t n = points.size();
+		std::vector<std::size_t> cacheIndices(n, 0);
+		bool sameReference = m_cache.reference().size() == reference.size()
+			&& std::equal(reference.begin(), reference.end(), m_cache.reference().begin());
+		if(sameReference){
+			//match the points with the points in the cache
+			std::vector<bool> matched(m_cache.size(), false);
+			std::vector<bool> found(n, false);
+			std::size_t matches = 0;
+			for(std::size_t i = 0; i != n; ++i){
+				for(std::size_t c = 0; c != m_cache.size(); ++c){
+					if(!matched[c] && std::equal(points[i].begin(), points[i].end(), m_cache.point(c).begin())){
+						matched[c] = true;
+						found[i] = true;
+						cacheIndices[i] = c;
+						++matches;
+						break;
+					}
+				}
+			}
+			std::size_t changes = (m_cache.size() - matches) + (n - matches);
+			if(changes <= maxIncrementalChanges){
+				//remove the points which are not part of the front anymore, starting at the back of the cache
+				for(std::size_t c = m_cache.size(); c != 0; --c){
+					if(matched[c-1]) continue;
+					m_cache.remove(c-1);
+					for(std::size_t i = 0; i != n; ++i){
+						if(found[i] && cacheIndices[i] > c-1)
+							--cacheIndices[i];
+					}
+				}
+				//add the new points
+				for(std::size_t i = 0; i != n; ++i){
+					if(found[i]) continue;
+					cacheIndices[i] = m_cache.size();
+					m_cache.insert(points[i]);
+				}
+				return cacheIndices;
+			}
+		}
+		m_cache.assign(points, reference);
+		std::iota(cacheIndices.begin(), cacheIndices.end(), 0);
+		return cacheIndices;
+	}
+
 	RealVector m_reference;
 	HypervolumeContribution m_algorithm;
+	bool m_useIncrementalUpdates;
+	/// contributions of the front of the last call, changed by the const selection methods
+	mutable IncrementalHypervolumeContribution m_cache;
 };
 }
 
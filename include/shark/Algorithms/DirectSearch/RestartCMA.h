@@ -0,0 +1,481 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       IPOP and BIPOP restart strategies running several CMA-ES instances concurrently
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_RESTARTCMA_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_RESTARTCMA_H
+
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Rng/GlobalRng.h>
+#include <shark/Core/OpenMP.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace shark {
+
+/// \brief CMA-ES with IPOP or BIPOP restarts, running several instances concurrently.
+///
+/// A single run of the CMA-ES converges to a local optimum. On multimodal functions,
+/// restarting with a larger population makes it more likely to find the global optimum.
+/// The IPOP strategy increases the population size by a constant factor on every restart.
+/// The BIPOP strategy interleaves these runs with runs with small populations and small initial step sizes:
+/// a new run uses a small population if the small runs used fewer evaluations so far than the large ones.
+/// The population size of a small run is \f$ \lfloor \lambda_{def} (\lambda_{large}/(2\lambda_{def}))^{U^2} \rfloor\f$ and its step size is
+/// \f$ \sigma_{0} 10^{-2U} \f$ with U uniformly distributed on [0,1], where \f$ \lambda_{large} \f$ is the population size
+/// of the last large run.
+///
+/// Several runs are active at the same time and every step performs one generation of each of them.
+/// If the objective function is thread safe, the runs are stepped in parallel. This uses all cores
+/// on cheap objective functions, for which the evaluations of a single generation are too fast to be parallelized.
+/// The population size of the large runs grows in waves: the i-th large run uses the population size
+/// \f$ \lambda_{def} \cdot f^{\lfloor i/k \rfloor} \f$, where k is the number of concurrent instances and f the increase factor.
+///
+/// A run is restarted when its step size becomes tiny compared to the initial step size,
+/// the best function values of the last \f$ 10+\lceil 30n/\lambda \rceil \f$ generations do not differ anymore,
+/// the covariance matrix becomes ill-conditioned or after a maximum number of generations.
+/// No runs are started and no generations are performed after the evaluation budget is used up,
+/// but the generations of one step may exceed the budget by the evaluations of one generation per instance.
+/// The evaluations spent on a point are counted as in the CMA, i.e. lambda times the number of reevaluations per generation.
+///
+/// The first run starts at the starting point. If a search box is configured, all other runs
+/// start at points sampled uniformly from the box, otherwise they start at the starting point as well.
+/// Every run has its own random number stream which is seeded from the random number stream of this class
+/// when the run is started. Thus the result does not depend on the number of threads.
+/// The stream of this class is seeded from the generator passed to the constructor and is serialized
+/// together with the runs, so a restored optimizer continues exactly like the original one.
+/// The solution is the best point evaluated by any of the runs.
+///
+/// For details see
+/// A. Auger and N. Hansen: A Restart CMA Evolution Strategy With Increasing Population Size. CEC 2005.
+/// N. Hansen: Benchmarking a BI-Population CMA-ES on the BBOB-2009 Function Testbed. GECCO 2009.
+class RestartCMA : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	/// \brief The restart strategy.
+	enum RestartStrategy {
+		IPOP = 0,
+		BIPOP = 1
+	};
+
+	RestartCMA(DefaultRngType& rng = Rng::globalRng)
+	: m_strategy(BIPOP)
+	, m_numberOfInstances(SHARK_NUM_THREADS)
+	, m_maxEvaluations(std::numeric_limits<std::size_t>::max())
+	, m_increaseFactor(2)
+	, m_initialSigma(-1)
+	, m_configured(false)
+	, m_tolX(1.e-12)
+	, m_tolFun(1.e-12)
+	, m_maxCondition(1.e14)
+	, m_evaluations(0)
+	, m_runs(0)
+	, m_largeRuns(0)
+	, m_largeLambda(0)
+	, m_rng((unsigned int)rng()){
+		m_features |= REQUIRES_VALUE;
+		m_regimeEvaluations[0] = m_regimeEvaluations[1] = 0;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "RestartCMA"; }
+
+	/// \brief The restart strategy, BIPOP by default.
+	RestartStrategy strategy()const{
+		return m_strategy;
+	}
+	void setStrategy(RestartStrategy strategy){
+		m_strategy = strategy;
+	}
+
+	/// \brief Number of runs which are active at the same time.
+	///
+	/// By default, one instance per thread is used. The result depends on the number of instances,
+	/// thus it has to be set explicitly for results which are reproducible on different machines.
+	std::size_t numberOfInstances()const{
+		return m_numberOfInstances;
+	}
+	void setNumberOfInstances(std::size_t instances){
+		SHARK_RUNTIME_CHECK(instances > 0, "At least one instance must be run");
+		m_numberOfInstances = instances;
+	}
+
+	/// \brief Total number of evaluations of all runs, unlimited by default.
+	std::size_t maxEvaluations()const{
+		return m_maxEvaluations;
+	}
+	void setMaxEvaluations(std::size_t evaluations){
+		m_maxEvaluations = evaluations;
+	}
+
+	/// \brief Factor by which the population size of the large runs grows, 2 by default.
+	double increaseFactor()const{
+		return m_increaseFactor;
+	}
+	void setIncreaseFactor(double factor){
+		SHARK_RUNTIME_CHECK(factor >= 1, "The population size must not decrease");
+		m_increaseFactor = factor;
+	}
+
+	/// \brief Sets the initial step size of the large runs.
+	///
+	/// It is by default <=0 which means that a quarter of the average width of the search box is used if it is configured
+	/// and 1/sqrt(numVariables) otherwise.
+	void setInitialSigma(double initialSigma){
+		m_initialSigma = initialSigma;
+	}
+
+	//! samples the starting points of the restarts in the range [min,max]^parameters
+	void configure(std::size_t parameters, double min, double max){
+		RANGE_CHECK(min <= max);
+		m_minimum = std::vector<double>(parameters, min);
+		m_maximum = std::vector<double>(parameters, max);
+		m_configured = true;
+	}
+
+	//! individual definition of the sampling range for every parameter
+	void configure(std::vector<double> const& min, std::vector<double> const& max){
+		SIZE_CHECK(min.size() == max.size());
+		RANGE_CHECK(min <= max);
+		m_minimum = min;
+		m_maximum = max;
+		m_configured = true;
+	}
+
+	/// \brief Number of evaluations used by all runs so far.
+	std::size_t numberOfEvaluations()const{
+		return m_evaluations;
+	}
+
+	/// \brief Number of runs started so far, including the active ones.
+	std::size_t numberOfRuns()const{
+		return m_runs;
+	}
+
+	/// \brief Returns true if the evaluation budget is used up and step does nothing anymore.
+	bool budgetExhausted()const{
+		return m_evaluations >= m_maxEvaluations;
+	}
+
+	/// \brief Returns the CMA of the i-th active run.
+	CMA const& instance(std::size_t i)const{
+		SIZE_CHECK(i < m_instances.size());
+		return m_instances[i]->cma;
+	}
+
+	virtual void read( InArchive & archive ){
+		archive >> m_strategy;
+		archive >> m_numberOfInstances;
+		archive >> m_maxEvaluations;
+		archive >> m_increaseFactor;
+		archive >> m_initialSigma;
+		archive >> m_minimum;
+		archive >> m_maximum;
+		archive >> m_configured;
+		archive >> m_startingPoint;
+		archive >> m_sigma;
+		archive >> m_lambda;
+		archive >> m_evaluations;
+		archive >> m_regimeEvaluations[0];
+		archive >> m_regimeEvaluations[1];
+		archive >> m_runs;
+		archive >> m_largeRuns;
+		archive >> m_largeLambda;
+		archive >> m_best.point;
+		archive >> m_best.value;
+		std::string rngState;
+		archive >> rngState;
+		std::istringstream stream(rngState);
+		stream >> m_rng;
+		std::size_t instances = 0;
+		archive >> instances;
+		m_instances.clear();
+		for(std::size_t i = 0; i != instances; ++i){
+			boost::shared_ptr<Run> run(new Run(0));
+			run->read(archive);
+			m_instances.push_back(run);
+		}
+	}
+
+	virtual void write( OutArchive & archive ) const{
+		archive << m_strategy;
+		archive << m_numberOfInstances;
+		archive << m_maxEvaluations;
+		archive << m_increaseFactor;
+		archive << m_initialSigma;
+		archive << m_minimum;
+		archive << m_maximum;
+		archive << m_configured;
+		archive << m_startingPoint;
+		archive << m_sigma;
+		archive << m_lambda;
+		archive << m_evaluations;
+		archive << m_regimeEvaluations[0];
+		archive << m_regimeEvaluations[1];
+		archive << m_runs;
+		archive << m_largeRuns;
+		archive << m_largeLambda;
+		archive << m_best.point;
+		archive << m_best.value;
+		std::ostringstream stream;
+		stream << m_rng;
+		std::string rngState = stream.str();
+		archive << rngState;
+		std::size_t instances = m_instances.size();
+		archive << instances;
+		for(std::size_t i = 0; i != instances; ++i){
+			m_instances[i]->write(archive);
+		}
+	}
+
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	/// \brief Initializes the algorithm and starts the first runs.
+	void init(ObjectiveFunctionType& function, SearchPointType const& startingPoint) {
+		function.init();
+		checkFeatures(function);
+		std::size_t n = function.numberOfVariables();
+		SIZE_CHECK(startingPoint.size() == n);
+		SIZE_CHECK(!m_configured || m_minimum.size() == n);
+
+		m_startingPoint = startingPoint;
+		m_lambda = CMA::suggestLambda(n);
+		if(m_initialSigma > 0){
+			m_sigma = m_initialSigma;
+		}else if(m_configured){
+			double width = 0;
+			for(std::size_t i = 0; i != n; ++i){
+				width += m_maximum[i] - m_minimum[i];
+			}
+			m_sigma = 0.25 * width / n;
+		}else{
+			m_sigma = 1.0 / std::sqrt(double(n));
+		}
+		m_evaluations = 0;
+		m_regimeEvaluations[0] = m_regimeEvaluations[1] = 0;
+		m_runs = 0;
+		m_largeRuns = 0;
+		m_largeLambda = m_lambda;
+		m_best.point = startingPoint;
+		m_best.value = std::numeric_limits<double>::max();
+		m_instances.clear();
+		for(std::size_t i = 0; i != m_numberOfInstances && !budgetExhausted(); ++i){
+			m_instances.push_back(startRun(function));
+		}
+	}
+
+	/// \brief Performs one generation of every active run and restarts the runs which have converged.
+	void step(ObjectiveFunctionType const& function){
+		if(budgetExhausted()) return;
+
+		std::size_t instances = m_instances.size();
+		std::vector<std::size_t> evaluations(instances);
+		for(std::size_t i = 0; i != instances; ++i){
+			CMA const& cma = m_instances[i]->cma;
+			evaluations[i] = cma.lambda() * cma.numberOfEvaluations();
+		}
+		if(function.isThreadSafe()){
+			SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)instances; ++i){
+				m_instances[i]->step(function);
+			}
+		}else{
+			for(std::size_t i = 0; i != instances; ++i){
+				m_instances[i]->step(function);
+			}
+		}
+
+		//update the budget and the best point and restart the converged runs in a fixed order
+		for(std::size_t i = 0; i != instances; ++i){
+			Run& run = *m_instances[i];
+			m_evaluations += evaluations[i];
+			m_regimeEvaluations[run.regime] += evaluations[i];
+			updateBest(run);
+			if(converged(run) && !budgetExhausted())
+				m_instances[i] = startRun(function);
+		}
+	}
+
+private:
+	enum Regime{
+		LARGE = 0,
+		SMALL = 1
+	};
+
+	/// \brief CMA which can be initialized without a mutable objective function.
+	class RunCMA: public CMA{
+	public:
+		RunCMA(DefaultRngType& rng):CMA(rng){}
+		using CMA::doInit;
+	};
+
+	/// \brief A single run of the CMA with its own random number stream.
+	struct Run{
+		Run(unsigned int seed):rng(seed), cma(rng), regime(LARGE), initialSigma(0), generation(0){}
+
+		void step(ObjectiveFunctionType const& function){
+			cma.step(function);
+			history.push_back(cma.solution().value);
+			++generation;
+		}
+
+		void read(InArchive& archive){
+			int storedRegime = 0;
+			std::string rngState;
+			archive >> storedRegime;
+			archive >> initialSigma;
+			archive >> generation;
+			archive >> history;
+			archive >> rngState;
+			cma.read(archive);
+			regime = Regime(storedRegime);
+			std::istringstream stream(rngState);
+			stream >> rng;
+		}
+
+		void write(OutArchive& archive)const{
+			int storedRegime = regime;
+			std::ostringstream stream;
+			stream << rng;
+			std::string rngState = stream.str();
+			archive << storedRegime;
+			archive << initialSigma;
+			archive << generation;
+			archive << history;
+			archive << rngState;
+			cma.write(archive);
+		}
+
+		DefaultRngType rng;
+		RunCMA cma;
+		Regime regime;
+		double initialSigma;
+		std::size_t generation;
+		std::vector<double> history; ///< best function value of every generation
+	};
+
+	/// \brief Chooses the regime of the next run, samples its starting point and evaluates it.
+	boost::shared_ptr<Run> startRun(ObjectiveFunctionType const& function){
+		boost::shared_ptr<Run> run(new Run((unsigned int)m_rng()));
+		std::size_t lambda = m_lambda;
+		double sigma = m_sigma;
+		if(m_strategy == BIPOP && m_regimeEvaluations[SMALL] < m_regimeEvaluations[LARGE]){
+			run->regime = SMALL;
+			double u = uni(run->rng, 0, 1);
+			lambda = (std::size_t)std::floor(m_lambda * std::pow(0.5 * m_largeLambda / m_lambda, u * u));
+			lambda = std::max<std::size_t>(lambda, 2);
+			sigma *= std::pow(10.0, -2 * u);
+		}else{
+			run->regime = LARGE;
+			lambda = (std::size_t)std::floor(m_lambda * std::pow(m_increaseFactor, double(m_largeRuns / m_numberOfInstances)));
+			m_largeLambda = lambda;
+			++m_largeRuns;
+		}
+
+		SearchPointType point = m_startingPoint;
+		if(m_runs != 0 && m_configured){
+			for(std::size_t i = 0; i != point.size(); ++i){
+				point(i) = uni(run->rng, m_minimum[i], m_maximum[i]);
+			}
+			if(!function.isFeasible(point))
+				function.closestFeasible(point);
+		}
+		std::vector<SearchPointType> points(1, point);
+		std::vector<double> values(1, function.eval(point));
+		run->cma.doInit(points, values, lambda, CMA::suggestMu(lambda), sigma);
+		run->initialSigma = sigma;
+
+		++m_runs;
+		++m_evaluations;
+		++m_regimeEvaluations[run->regime];
+		updateBest(*run);
+		return run;
+	}
+
+	void updateBest(Run const& run){
+		if(run.cma.solution().value < m_best.value){
+			m_best.point = run.cma.solution().point;
+			m_best.value = run.cma.solution().value;
+		}
+	}
+
+	/// \brief Checks the restart criteria of the run.
+	bool converged(Run const& run)const{
+		CMA const& cma = run.cma;
+		double n = double(cma.mean().size());
+		double lambda = double(cma.lambda());
+		if(run.generation >= 100 + 50 * (n + 3) * (n + 3) / std::sqrt(lambda))
+			return true;
+		if(cma.sigma() * std::sqrt(max(cma.eigenValues())) < m_tolX * run.initialSigma)
+			return true;
+		if(cma.condition() > m_maxCondition)
+			return true;
+		std::size_t historyLength = 10 + (std::size_t)std::ceil(30 * n / lambda);
+		if(run.history.size() >= historyLength){
+			auto begin = run.history.end() - historyLength;
+			auto range = std::minmax_element(begin, run.history.end());
+			if(*range.second - *range.first < m_tolFun)
+				return true;
+		}
+		return false;
+	}
+
+	RestartStrategy m_strategy;
+	std::size_t m_numberOfInstances; ///< number of concurrent runs
+	std::size_t m_maxEvaluations; ///< evaluation budget of all runs
+	double m_increaseFactor; ///< growth of the population size of the large runs
+	double m_initialSigma; ///< user supplied initial step size, <=0 to choose it automatically
+	std::vector<double> m_minimum; ///< lower bounds of the starting points
+	std::vector<double> m_maximum; ///< upper bounds of the starting points
+	bool m_configured;
+	double m_tolX; ///< restart if the step size drops below this fraction of the initial step size
+	double m_tolFun; ///< restart if the best values of the last generations differ by less than this
+	double m_maxCondition; ///< restart if the condition of the covariance matrix exceeds this
+
+	SearchPointType m_startingPoint;
+	double m_sigma; ///< initial step size of the large runs
+	std::size_t m_lambda; ///< default population size
+	std::size_t m_evaluations; ///< evaluations of all runs so far
+	std::size_t m_regimeEvaluations[2]; ///< evaluations of the large and small runs so far
+	std::size_t m_runs; ///< number of runs started
+	std::size_t m_largeRuns; ///< number of large runs started
+	std::size_t m_largeLambda; ///< population size of the last large run
+	std::vector<boost::shared_ptr<Run> > m_instances; ///< active runs
+	DefaultRngType m_rng; ///< seeds the random number streams of the runs
+};
+
+}
+#endif
@@ -42,17 +42,24 @@
 
 #include <shark/Core/DLLSupport.h>
 #include <shark/Algorithms/GradientDescent/AbstractLineSearchOptimizer.h>
+#include <shark/Algorithms/GradientDescent/LimitedMemoryInverseHessian.h>
 #include <deque>
 
 namespace shark {
 
 //! \brief Limited-Memory Broyden, Fletcher, Goldfarb, Shannon algorithm for unconstrained optimization
+//!
+//! By default the search direction is computed with the two-loop recursion over the stored history.
+//! For problems with many variables the compact representation can be used instead, see
+//! setCompactRepresentation and LimitedMemoryInverseHessian. It stores the history in
+//! contiguous matrices and computes the direction with matrix-vector products that run in parallel.
+//! Both give the same direction up to rounding.
 class LBFGS : public AbstractLineSearchOptimizer{
 protected:
 	SHARK_EXPORT_SYMBOL void initModel();
 	SHARK_EXPORT_SYMBOL void computeSearchDirection();
 public:
-	LBFGS() :m_numHist(100){}
+	LBFGS() :m_numHist(100), m_compactRepresentation(false){}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -66,6 +73,18 @@ public:
 		m_numHist = numhist;
 	}
 
+	/// \brief Returns whether the compact representation is used to compute the search direction.
+	bool compactRepresentation()const{
+		return m_compactRepresentation;
+	}
+
+	/// \brief Sets whether the compact representation is used to compute the search direction.
+	///
+	/// The setting takes effect with the next call to init.
+	void setCompactRepresentation(bool compact = true){
+		m_compactRepresentation = compact;
+	}
+
 	//from ISerializable
 	SHARK_EXPORT_SYMBOL void read(InArchive &archive);
 	SHARK_EXPORT_SYMBOL void write(OutArchive &archive) const;
@@ -97,6 +116,9 @@ protected: // Instance vars
 	// gradientDifferences holds the values g_(k+1) - g_k
 	std::deque<RealVector> m_steps;
 	std::deque<RealVector> m_gradientDifferences;
+
+	bool m_compactRepresentation; ///< whether the history is stored in m_inverseHessian
+	LimitedMemoryInverseHessian m_inverseHessian; ///< history in compact representation
 };
 
 }
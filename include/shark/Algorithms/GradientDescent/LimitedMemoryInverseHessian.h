@@ -0,0 +1,121 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Compact representation of the limited memory BFGS inverse Hessian
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_GRADIENTDESCENT_LIMITEDMEMORYINVERSEHESSIAN_H
+#define SHARK_ALGORITHMS_GRADIENTDESCENT_LIMITEDMEMORYINVERSEHESSIAN_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Core/ISerializable.h>
+#include <shark/LinAlg/Base.h>
+
+namespace shark {
+
+/// \brief Limited memory BFGS approximation of the inverse Hessian in compact form.
+///
+/// Stores the last m steps \f$ s_i = x_{i+1}-x_i \f$ and gradient differences
+/// \f$ y_i = g_{i+1}-g_i \f$ as rows of two contiguous matrices S and Y. The inverse Hessian
+/// approximation of L-BFGS with initial matrix \f$ \gamma I \f$, \f$ \gamma = s^Ty/y^Ty \f$ of the
+/// latest pair, is then given by the compact representation of Byrd, Nocedal and Schnabel:
+/// \f[ H = \gamma I + \begin{pmatrix} S^T & \gamma Y^T \end{pmatrix}
+///  \begin{pmatrix} R^{-T}(D+\gamma Y Y^T)R^{-1} & -R^{-T} \\ -R^{-1} & 0 \end{pmatrix}
+///  \begin{pmatrix} S \\ \gamma Y\end{pmatrix}\f]
+/// where R is the upper triangular part of \f$ S Y^T \f$ and D its diagonal.
+/// The small m x m matrices \f$ S Y^T \f$ and \f$ Y Y^T\f$ are updated with every new pair.
+///
+/// A product Hg needs one pass over S and Y to compute Sg and Yg and a second pass to form the
+/// linear combination of the rows, compared to four passes of the two-loop recursion.
+/// Both passes are split into blocks of variables which are processed in parallel. The
+/// partial sums of the blocks are added in a fixed order, so the result does not depend on the number of threads.
+///
+/// The class can be used by every quasi-Newton method derived from AbstractLineSearchOptimizer,
+/// see LBFGS for an example.
+class LimitedMemoryInverseHessian : public ISerializable{
+public:
+	LimitedMemoryInverseHessian():m_historySize(0), m_start(0), m_size(0), m_gamma(1.0){}
+
+	/// \brief Removes all stored pairs and sets dimension and number of stored pairs.
+	SHARK_EXPORT_SYMBOL void init(std::size_t dimension, std::size_t historySize);
+
+	/// \brief Removes all stored pairs.
+	SHARK_EXPORT_SYMBOL void clear();
+
+	/// \brief Number of variables.
+	std::size_t dimension()const{
+		return m_steps.size2();
+	}
+	/// \brief Maximum number of stored pairs.
+	std::size_t historySize()const{
+		return m_historySize;
+	}
+	/// \brief Number of currently stored pairs.
+	std::size_t size()const{
+		return m_size;
+	}
+	/// \brief Scaling \f$ \gamma \f$ of the initial approximation.
+	double gamma()const{
+		return m_gamma;
+	}
+
+	/// \brief Adds a pair of step and gradient difference, replacing the oldest pair if the history is full.
+	///
+	/// The pair is only stored if \f$ s^Ty \f$ is larger than the threshold, which keeps the approximation
+	/// positive definite.
+	/// \returns whether the pair was stored.
+	SHARK_EXPORT_SYMBOL bool update(RealVector const& step, RealVector const& gradientDifference, double threshold = 1.e-10);
+
+	/// \brief Computes result = H * vector.
+	SHARK_EXPORT_SYMBOL void multiply(RealVector const& vector, RealVector& result)const;
+
+	//from ISerializable
+	SHARK_EXPORT_SYMBOL void read(InArchive &archive);
+	SHARK_EXPORT_SYMBOL void write(OutArchive &archive) const;
+private:
+	/// computes products = (S|Y) * trans(vectors) blockwise, the first m rows belong to S
+	void products(RealMatrix const& vectors, RealMatrix& products)const;
+	/// slot of the i-th pair in chronological order
+	std::size_t slot(std::size_t i)const{
+		return (m_start + i) % m_historySize;
+	}
+
+	std::size_t m_historySize;
+	std::size_t m_start;  ///< slot of the oldest pair
+	std::size_t m_size;   ///< number of stored pairs
+	double m_gamma;       ///< scaling of the initial approximation
+	RealMatrix m_steps;   ///< steps s_i, one per row
+	RealMatrix m_gradientDifferences; ///< gradient differences y_i, one per row
+	RealMatrix m_stepsTimesDifferences; ///< entry (i,j) is <s_i,y_j>, indexed by slot
+	RealMatrix m_differencesTimesDifferences; ///< entry (i,j) is <y_i,y_j>, indexed by slot
+};
+
+}
+#endif
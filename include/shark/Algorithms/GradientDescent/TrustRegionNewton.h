@@ -62,6 +62,12 @@ namespace shark {
 /// is set by a forcing-schedule so that accuracy increases in the vicinity of the
 /// optimum, enabling solutions with arbitrary precision.
 ///
+/// As conjugate gradient only needs products of the Hessian with vectors, the optimizer can run
+/// in a Hessian-free mode, see setHessianFree. Then the objective function only needs to provide
+/// the first derivative and evalHessianVectorProduct, and memory and time per CG iteration
+/// are linear in the number of variables instead of quadratic. This makes the method usable
+/// for models with millions of parameters, e.g. neural networks trained with an ErrorFunction.
+///
 /// The algorithm is based on 
 /// Jorge Nocedal, Stephen J. Wright
 /// Numerical Optimization, 2nd Edition
@@ -96,13 +102,29 @@ public:
 		return m_minImprovementRatio;
 	}
 
+	/// \brief Returns whether the Hessian is only used through Hessian-vector products.
+	bool hessianFree()const{
+		return m_hessianFree;
+	}
+
+	/// \brief Sets whether the Hessian is only used through Hessian-vector products.
+	///
+	/// In Hessian-free mode the objective function must provide evalHessianVectorProduct instead of
+	/// the second derivative. The setting takes effect with the next call to init.
+	SHARK_EXPORT_SYMBOL void setHessianFree(bool hessianFree = true);
+
 	/// \brief Perform one trust region Newton step, update point and trust region radius.
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
 protected:
+	/// \brief Evaluates the function value and the derivatives needed for the next step in the current point.
+	SHARK_EXPORT_SYMBOL void evalDerivatives(ObjectiveFunctionType const& objectiveFunction);
+
 	double m_delta;                                               ///< Current trust region size
 	double m_minImprovementRatio;                                 ///< Minimal improvement ratio (see the algorithm details in the class description).
 	ObjectiveFunctionType::SecondOrderDerivative m_derivatives;   ///< First and second derivative of the objective function in the current point.
+	bool m_hessianFree;                                           ///< Whether only Hessian-vector products are used instead of the Hessian.
+	bool m_useHessianVectorProduct;                               ///< Value of m_hessianFree at the last call to init, used by step.
 };
 }
 #endif
@@ -0,0 +1,192 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Incremental Principal Component Analysis
+ *
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_ALGORITHMS_TRAINER_INCREMENTALPCA_H
+#define SHARK_ALGORITHMS_TRAINER_INCREMENTALPCA_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+
+namespace shark{
+
+/*!
+ *  \brief Incremental Principal Component Analysis
+ *
+ *  Computes the first \f$ k \f$ principal components of a dataset
+ *  which is presented batch by batch (Ross et al., 2008). Instead of
+ *  the covariance matrix, the trainer stores a low rank factor
+ *  \f$ R = \Sigma V^T \f$ with \f$ k \f$ orthogonal rows such that
+ *  \f$ R^T R \f$ approximates the scatter matrix of the points seen
+ *  so far. A new batch \f$ X \f$ with mean \f$ \mu_X \f$ is incorporated by
+ *  computing the singular value decomposition of the stacked matrix
+ *
+ *  \f$
+ *      \begin{pmatrix} R \\ X - 1\mu_X^T \\ \sqrt{\frac{n m}{n+m}}(\mu - \mu_X)^T \end{pmatrix}
+ *  \f$
+ *
+ *  and keeping the first \f$ k \f$ singular vectors. Two partial
+ *  decompositions are merged the same way, which is used to process
+ *  the batches of a dataset in parallel. Memory is \f$ O(nk) \f$
+ *  for \f$ n \f$ input dimensions, independent of the number of points.
+ *  Thus the data does not need to be kept in memory and may be
+ *  streamed from disk.
+ *
+ *  The result is exact when \f$ k \f$ is at least the rank of the data,
+ *  otherwise it is an approximation of the leading components.
+ *
+ *  Usage is: call update() for every batch of data, call finalize() and
+ *  then obtain the encoder or decoder. train() does all of this for a dataset.
+ */
+class IncrementalPCA : public AbstractUnsupervisedTrainer<LinearModel<> >
+{
+private:
+	typedef AbstractUnsupervisedTrainer<LinearModel<> > base_type;
+public:
+	/// Constructor.
+	/// The first parameter defines the number of components to compute,
+	/// the second whether the model should also whiten the data.
+	/// If the number of components is 0, train() uses the output
+	/// dimension of the model.
+	IncrementalPCA(std::size_t components = 0, bool whitening = false)
+	: m_whitening(whitening), m_components(components){
+		reset();
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "IncrementalPCA"; }
+
+	/// If set to true, the encoded data has unit variance along
+	/// the new coordinates.
+	void setWhitening(bool whitening) {
+		m_whitening = whitening;
+	}
+
+	/// Returns the number of components that are computed.
+	std::size_t components()const{
+		return m_components;
+	}
+
+	/// Sets the number of components that are computed.
+	/// This resets the trainer.
+	void setComponents(std::size_t components){
+		m_components = components;
+		reset();
+	}
+
+	/// Returns the number of points seen since the last reset.
+	std::size_t numberOfPoints()const{
+		return m_l;
+	}
+
+	/// Removes all information about previously seen points.
+	SHARK_EXPORT_SYMBOL void reset();
+
+	/// \brief Incorporates a batch of points into the decomposition.
+	///
+	/// Every row of the batch is a point.
+	SHARK_EXPORT_SYMBOL void update(RealMatrix const& batch);
+
+	/// \brief Incorporates all batches of a dataset into the decomposition.
+	///
+	/// The batches are split evenly among the available threads. Every thread
+	/// computes a partial decomposition which are merged afterwards.
+	SHARK_EXPORT_SYMBOL void update(UnlabeledData<RealVector> const& inputs);
+
+	/// \brief Merges the decomposition of another trainer into this one.
+	///
+	/// The result is the decomposition of the union of the points seen by both.
+	SHARK_EXPORT_SYMBOL void merge(IncrementalPCA const& other);
+
+	/// \brief Computes eigenvalues and eigenvectors from the current decomposition.
+	///
+	/// This must be called before the eigenvectors or models can be obtained.
+	/// More batches can be incorporated afterwards by calling update() again.
+	SHARK_EXPORT_SYMBOL void finalize();
+
+	/// Train the model to perform PCA. The model must be a
+	/// LinearModel object with offset, and its output dimension
+	/// defines the number of principal components
+	/// represented if components() is 0.
+	SHARK_EXPORT_SYMBOL void train(LinearModel<>& model, UnlabeledData<RealVector> const& inputs);
+
+	//! Returns a model mapping the original data to the
+	//! m-dimensional PCA coordinate system.
+	SHARK_EXPORT_SYMBOL void encoder(LinearModel<>& model, std::size_t m = 0);
+
+	//! Returns a model mapping encoded data from the
+	//! m-dimensional PCA coordinate system back to the
+	//! n-dimensional original coordinate system.
+	SHARK_EXPORT_SYMBOL void decoder(LinearModel<>& model, std::size_t m = 0);
+
+	/// Eigenvalues computed by the last call to finalize().
+	RealVector const& eigenvalues() const {
+		return m_eigenvalues;
+	}
+	/// Returns ith eigenvalue.
+	double eigenvalue(std::size_t i) const {
+		if( i < m_eigenvalues.size())
+			return m_eigenvalues(i);
+		return 0.;
+	}
+
+	//! Eigenvectors computed by the last call to finalize(), stored as columns.
+	RealMatrix const& eigenvectors() const{
+		return m_eigenvectors;
+	}
+
+	/// mean of the points seen so far
+	RealVector const& mean() const{
+		return m_mean;
+	}
+
+protected:
+	bool m_whitening;          ///< normalize variance yes/no
+	std::size_t m_components;  ///< number of computed components
+	RealMatrix m_factor;       ///< low rank factor R of the scatter matrix with orthogonal rows
+	RealMatrix m_eigenvectors; ///< eigenvectors
+	RealVector m_eigenvalues;  ///< eigenvalues
+	RealVector m_mean;         ///< mean value
+
+	std::size_t m_l;           ///< number of points seen so far
+private:
+	void mergeFactor(std::size_t count, RealVector const& mean, RealMatrix const& factor);
+};
+
+
+}
+#endif
@@ -0,0 +1,198 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Selection of the landmarks of a Nystroem feature map
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_TRAINERS_NYSTROMTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_NYSTROMTRAINER_H
+
+#include <shark/Models/Kernels/NystromFeatureMap.h>
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Core/utility/functional.h>
+#include <shark/Rng/GlobalRng.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <cmath>
+
+namespace shark {
+
+///
+/// \brief Selects the landmarks of a NystromFeatureMap from a dataset.
+///
+/// Two strategies are supported. UNIFORM draws the landmarks uniformly without replacement.
+/// LEVERAGE_SCORES draws them proportional to their approximate ridge leverage scores
+/// \f[ \ell_i = k_i^T (K + \lambda I)^{-1} k_i \f]
+/// which measure how much a point is needed to represent the kernel matrix K.
+/// Landmarks drawn by leverage scores give a better approximation in particular for
+/// clustered or unbalanced data (Alaoui and Mahoney, 2015). The scores are estimated using a
+/// uniform pilot feature map \f$ \phi \f$ with the same number of landmarks, as
+/// \f$ \ell_i \approx \phi(x_i)^T(\Phi^T\Phi + \lambda I)^{-1}\phi(x_i) \f$. This takes two passes over the
+/// data and time O(n m^2) with m the number of landmarks. The landmarks are then sampled without
+/// replacement with probabilities proportional to the scores.
+///
+template<class InputType = RealVector>
+class NystromTrainer : public AbstractUnsupervisedTrainer<NystromFeatureMap<InputType> >
+{
+public:
+	typedef AbstractKernelFunction<InputType> KernelType;
+
+	enum LandmarkSelection{
+		UNIFORM,
+		LEVERAGE_SCORES
+	};
+
+	/// \param kernel Kernel to approximate
+	/// \param numberOfLandmarks Number of landmarks m
+	/// \param selection Strategy for selecting the landmarks
+	NystromTrainer(KernelType* kernel, std::size_t numberOfLandmarks, LandmarkSelection selection = UNIFORM)
+	: m_kernel(kernel)
+	, m_numberOfLandmarks(numberOfLandmarks)
+	, m_selection(selection)
+	, m_regularization(1.0){
+		SHARK_ASSERT(kernel != NULL);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "NystromTrainer"; }
+
+	std::size_t numberOfLandmarks()const{
+		return m_numberOfLandmarks;
+	}
+	void setNumberOfLandmarks(std::size_t numberOfLandmarks){
+		m_numberOfLandmarks = numberOfLandmarks;
+	}
+
+	LandmarkSelection landmarkSelection()const{
+		return m_selection;
+	}
+	void setLandmarkSelection(LandmarkSelection selection){
+		m_selection = selection;
+	}
+
+	/// \brief Returns the ridge parameter lambda of the leverage scores.
+	double regularization()const{
+		return m_regularization;
+	}
+	/// \brief Sets the ridge parameter lambda of the leverage scores.
+	///
+	/// Larger values favour points in dense regions, smaller values favour outliers.
+	void setRegularization(double lambda){
+		SHARK_RUNTIME_CHECK(lambda > 0, "[NystromTrainer::setRegularization] regularization must be positive");
+		m_regularization = lambda;
+	}
+
+	void train(NystromFeatureMap<InputType>& model, UnlabeledData<InputType> const& inputs){
+		SHARK_RUNTIME_CHECK(m_numberOfLandmarks > 0, "[NystromTrainer::train] number of landmarks must be positive");
+		std::size_t n = inputs.numberOfElements();
+		std::size_t m = std::min(m_numberOfLandmarks, n);
+
+		std::vector<std::size_t> indices = uniformLandmarks(n, m);
+		if(m_selection == LEVERAGE_SCORES && m < n){
+			model.setStructure(m_kernel, selectElements(inputs, indices));
+			indices = sampleByWeight(leverageScores(model, inputs), m);
+		}
+		model.setStructure(m_kernel, selectElements(inputs, indices));
+	}
+
+	/// \brief Computes the approximate ridge leverage score of every point given a pilot feature map.
+	RealVector leverageScores(NystromFeatureMap<InputType> const& pilot, UnlabeledData<InputType> const& inputs)const{
+		std::size_t r = pilot.outputSize();
+		//first pass: A = Phi^T Phi + lambda I
+		RealMatrix A = m_regularization * blas::identity_matrix<double>(r);
+		for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+			RealMatrix phi = pilot(inputs.batch(b));
+			noalias(A) += prod(trans(phi),phi);
+		}
+		blas::cholesky_decomposition<RealMatrix> cholesky(A);
+
+		//second pass: l_i = phi_i^T A^{-1} phi_i
+		RealVector scores(inputs.numberOfElements());
+		std::size_t start = 0;
+		for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+			RealMatrix phi = pilot(inputs.batch(b));
+			RealMatrix solution = trans(phi);
+			cholesky.solve(solution, blas::left());
+			for(std::size_t i = 0; i != phi.size1(); ++i){
+				scores(start + i) = inner_prod(row(phi,i), column(solution,i));
+			}
+			start += phi.size1();
+		}
+		return scores;
+	}
+
+private:
+	std::vector<std::size_t> uniformLandmarks(std::size_t n, std::size_t m)const{
+		std::vector<std::size_t> indices(n);
+		for(std::size_t i = 0; i != n; ++i) indices[i] = i;
+		partial_shuffle(indices.begin(), indices.begin() + m, indices.end());
+		indices.resize(m);
+		return indices;
+	}
+
+	/// weighted sampling without replacement using the keys u^(1/w) (Efraimidis and Spirakis, 2006).
+	std::vector<std::size_t> sampleByWeight(RealVector const& weights, std::size_t m)const{
+		std::size_t n = weights.size();
+		std::vector<std::pair<double, std::size_t> > keys(n);
+		for(std::size_t i = 0; i != n; ++i){
+			double u = Rng::uni(0,1);
+			double w = std::max(weights(i), 1.e-300);
+			//log(u^(1/w)) is monotone in the key; u = 0 yields -inf which is never selected first
+			keys[i] = std::make_pair(std::log(u) / w, i);
+		}
+		std::partial_sort(keys.begin(), keys.begin() + m, keys.end(), std::greater<std::pair<double, std::size_t> >());
+		std::vector<std::size_t> indices(m);
+		for(std::size_t i = 0; i != m; ++i){
+			indices[i] = keys[i].second;
+		}
+		std::sort(indices.begin(), indices.end());
+		return indices;
+	}
+
+	Data<InputType> selectElements(UnlabeledData<InputType> const& inputs, std::vector<std::size_t> const& indices)const{
+		std::vector<InputType> elements;
+		elements.reserve(indices.size());
+		for(std::size_t i = 0; i != indices.size(); ++i){
+			elements.push_back(inputs.element(indices[i]));
+		}
+		return createDataFromRange(elements);
+	}
+
+	KernelType* m_kernel;
+	std::size_t m_numberOfLandmarks;
+	LandmarkSelection m_selection;
+	double m_regularization;
+};
+
+}
+#endif
@@ -70,19 +70,31 @@ namespace shark{
  *  of dimensions by skipping the components with the least
  *  corresponding eigenvalues/variances. Furthermore, the eigenvalues
  *  may be rescaled to one, resulting in a whitening of the data.
+ *
+ *  Computing the full decomposition requires forming either the
+ *  \f$ n \times n \f$ covariance matrix or the \f$ \ell \times \ell \f$
+ *  Gram matrix of the data. When only the first \f$ k \f$ components
+ *  are needed, the RANDOMIZED algorithm can be used instead. It computes
+ *  a truncated decomposition by randomized subspace iteration
+ *  (Halko, Martinsson and Tropp, 2011), which only needs a few passes
+ *  over the batches of the dataset, \f$ O(n k) \f$ memory and
+ *  \f$ O(\ell n k) \f$ time per pass.
  */
 class PCA : public AbstractUnsupervisedTrainer<LinearModel<> >
 {
 private:
 	typedef AbstractUnsupervisedTrainer<LinearModel<> > base_type;
 public:
-	enum PCAAlgorithm { STANDARD, SMALL_SAMPLE, AUTO };
+	enum PCAAlgorithm { STANDARD, SMALL_SAMPLE, AUTO, RANDOMIZED };
 
 	/// Constructor.
 	/// The parameter defines whether the model should also
 	/// whiten the data.
 	PCA(bool whitening = false) 
-	: m_whitening(whitening){
+	: m_whitening(whitening)
+	, m_components(0)
+	, m_oversampling(10)
+	, m_powerIterations(2){
 		m_algorithm = AUTO;
 	};
 	/// Constructor.
@@ -90,7 +102,10 @@ public:
 	/// whiten the data.
 	/// The eigendecomposition of the data is stored inthe PCA object.
 	PCA(UnlabeledData<RealVector> const& inputs, bool whitening = false) 
-	: m_whitening(whitening){
+	: m_whitening(whitening)
+	, m_components(0)
+	, m_oversampling(10)
+	, m_powerIterations(2){
 		m_algorithm = AUTO;
 		setData(inputs);
 	};
@@ -105,6 +120,34 @@ public:
 		m_whitening = whitening;
 	}
 
+	/// Returns the algorithm used to compute the decomposition.
+	PCAAlgorithm algorithm() const{
+		return m_algorithm;
+	}
+	/// Sets the algorithm used to compute the decomposition.
+	///
+	/// AUTO chooses between STANDARD and SMALL_SAMPLE based on the
+	/// shape of the data. RANDOMIZED must be requested explicitly
+	/// and computes only the number of components set by setComponents().
+	void setAlgorithm(PCAAlgorithm algorithm){
+		m_algorithm = algorithm;
+	}
+
+	/// \brief Sets the number of components computed by the RANDOMIZED algorithm.
+	///
+	/// A value of 0 means that train() uses the output dimension of the model.
+	void setComponents(std::size_t components){
+		m_components = components;
+	}
+	/// \brief Configures the randomized subspace iteration.
+	///
+	/// \param oversampling number of additional random directions used to improve the accuracy of the subspace
+	/// \param powerIterations number of additional passes over the data to sharpen the spectrum
+	void setRandomizedParameters(std::size_t oversampling, std::size_t powerIterations){
+		m_oversampling = oversampling;
+		m_powerIterations = powerIterations;
+	}
+
 	/// Train the model to perform PCA. The model must be a
 	/// LinearModel object with offset, and its output dimension
 	/// defines the number of principal components
@@ -113,7 +156,11 @@ public:
 	/// space to the PCA coordinate system).
 	void train(LinearModel<>& model, UnlabeledData<RealVector> const& inputs) {
 		std::size_t m = model.outputSize(); ///< reduced dimensionality
+		std::size_t components = m_components;
+		if(m_algorithm == RANDOMIZED && !m_components)
+			m_components = m;
 		setData(inputs);   // compute PCs
+		m_components = components;
 		encoder(model, m); // define the model 
 	}
 
@@ -135,7 +182,8 @@ public:
 	/// Eigenvalues of last training. The number of eigenvalues
 	//! is equal to the minimum of the input dimensions (i.e.,
 	//! number of attributes) and the number of data points used
-	//! for training the PCA.
+	//! for training the PCA. For the RANDOMIZED algorithm only
+	//! the requested number of components is computed.
 	RealVector const& eigenvalues() const {
 		return m_eigenvalues;
 	}
@@ -170,6 +218,12 @@ protected:
 	std::size_t m_l;           ///< number of training data points
 
 	PCAAlgorithm m_algorithm;  ///< whether to use design matrix or its transpose for building covariance matrix
+
+	std::size_t m_components;      ///< number of components computed by the randomized algorithm
+	std::size_t m_oversampling;    ///< additional random directions of the randomized algorithm
+	std::size_t m_powerIterations; ///< number of power iterations of the randomized algorithm
+private:
+	void computeRandomized(UnlabeledData<RealVector> const& inputs);
 };
 
 
@@ -40,6 +40,8 @@
 
 #include <shark/Algorithms/Trainers/AbstractSvmTrainer.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/Algorithms/Trainers/NystromTrainer.h>
+#include <shark/LinAlg/IterativeKernelSolver.h>
 
 
 namespace shark {
@@ -81,6 +83,19 @@ namespace shark {
 /// of the noise. The variance of the noise is denoted by \f$
 /// \sigma_n^2 \f$ in the textbook by Rasmussen and
 /// Williams. Accordingly, \f$ C = 1/\sigma_n^2 \f$.
+///
+/// The exact solution requires the full kernel matrix and O(n^3) time.
+/// For large datasets, a number of landmarks m can be set. Then the kernel is
+/// replaced by its Nystroem approximation \f$ \phi(x)^T \phi(x') \f$ (see NystromFeatureMap)
+/// and the weights are obtained from the m x m system
+/// \f$ (\Phi^T \Phi + \sigma_n^2 I) w = \Phi^T y \f$, which is accumulated
+/// batchwise in O(n m^2) time and O(m^2) memory. The resulting model is a
+/// kernel expansion over the landmarks.
+///
+/// Alternatively, the exact system can be solved by the matrix-free
+/// preconditioned conjugate gradient method (see RegularizedKernelOperator).
+/// The kernel matrix is then never stored, the kernel blocks are recomputed
+/// in parallel in every iteration, and the memory drops to O(n).
 
 template <class InputType>
 class RegularizationNetworkTrainer : public AbstractSvmTrainer<InputType, RealVector,KernelExpansion<InputType> >
@@ -95,6 +110,11 @@ public:
 	/// \param unconstrained Indicates exponential encoding of the regularization parameter 
 	RegularizationNetworkTrainer(KernelType* kernel, double betaInv, bool unconstrained = false)
 	: base_type(kernel, 1.0 / betaInv, false, unconstrained)
+	, m_numberOfLandmarks(0)
+	, m_landmarkSelection(NystromTrainer<InputType>::UNIFORM)
+	, m_iterativeSolver(false)
+	, m_solverTolerance(1.e-8)
+	, m_preconditionerRank(0)
 	{ }
 
 	/// \brief From INameable: return the class name.
@@ -115,7 +135,39 @@ public:
 	void setPrecision(double beta)
 	{ this->C() = beta; }
 
+	/// \brief Returns the number of landmarks of the low-rank solver, 0 if the exact solver is used.
+	std::size_t numberOfLandmarks() const
+	{ return m_numberOfLandmarks; }
+	/// \brief Sets the number of landmarks of the low-rank solver. 0 selects the exact solver.
+	void setNumberOfLandmarks(std::size_t numberOfLandmarks, typename NystromTrainer<InputType>::LandmarkSelection selection = NystromTrainer<InputType>::UNIFORM){
+		m_numberOfLandmarks = numberOfLandmarks;
+		m_landmarkSelection = selection;
+	}
+
+	/// \brief Returns whether the matrix-free conjugate gradient solver is used.
+	bool iterativeSolver() const
+	{ return m_iterativeSolver; }
+	/// \brief Selects the matrix-free conjugate gradient solver instead of the Cholesky decomposition.
+	///
+	/// \param iterative whether the iterative solver is used
+	/// \param tolerance relative residual norm at which the iteration stops
+	/// \param preconditionerRank number of landmarks of the Nystroem preconditioner, 0 selects the Jacobi preconditioner
+	void setIterativeSolver(bool iterative, double tolerance = 1.e-8, std::size_t preconditionerRank = 0){
+		SHARK_RUNTIME_CHECK(tolerance > 0, "[RegularizationNetworkTrainer::setIterativeSolver] tolerance must be positive");
+		m_iterativeSolver = iterative;
+		m_solverTolerance = tolerance;
+		m_preconditionerRank = preconditionerRank;
+	}
+
 	void train(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset){
+		if(m_numberOfLandmarks != 0 && m_numberOfLandmarks < dataset.numberOfElements()){
+			trainLowRank(svm, dataset);
+			return;
+		}
+		if(m_iterativeSolver){
+			trainIterative(svm, dataset);
+			return;
+		}
 		svm.setStructure(base_type::m_kernel,dataset.inputs(),false);
 		
 		// Setup the kernel matrix
@@ -124,6 +176,44 @@ public:
 		//try a cholesky solver instead
 		noalias(column(svm.alpha(),0)) = solve(M,v,blas::symm_semi_pos_def(),blas::left());
 	}
+private:
+	void trainLowRank(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset){
+		NystromFeatureMap<InputType> featureMap;
+		NystromTrainer<InputType> nystrom(base_type::m_kernel, m_numberOfLandmarks, m_landmarkSelection);
+		nystrom.train(featureMap, dataset.inputs());
+
+		//accumulate Phi^T Phi + sigma^2 I and Phi^T y
+		std::size_t r = featureMap.outputSize();
+		RealMatrix A = noiseVariance() * blas::identity_matrix<double>(r);
+		RealVector b(r, 0.0);
+		for(std::size_t i = 0; i != dataset.numberOfBatches(); ++i){
+			RealMatrix phi = featureMap(dataset.batch(i).input);
+			noalias(A) += prod(trans(phi),phi);
+			noalias(b) += prod(trans(phi),column(dataset.batch(i).label,0));
+		}
+		RealVector w = solve(A,b,blas::symm_pos_def(),blas::left());
+
+		//f(x) = phi(x)^T w = k_m(x)^T P w
+		svm.setStructure(base_type::m_kernel,featureMap.landmarks(),false);
+		noalias(column(svm.alpha(),0)) = prod(featureMap.projection(),w);
+	}
+
+	void trainIterative(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset){
+		RegularizedKernelOperator<InputType> M(base_type::m_kernel, dataset.inputs(), noiseVariance());
+		RegularizedKernelPreconditioner<InputType> preconditioner(base_type::m_kernel, dataset.inputs(), M, m_preconditionerRank);
+		RealMatrix t = columns(createBatch<RealVector>(dataset.labels().elements()),0,1);
+		RealMatrix alpha;
+		conjugateGradientSolve(M, preconditioner, t, alpha, m_solverTolerance);
+
+		svm.setStructure(base_type::m_kernel,dataset.inputs(),false);
+		noalias(svm.alpha()) = alpha;
+	}
+
+	std::size_t m_numberOfLandmarks;
+	typename NystromTrainer<InputType>::LandmarkSelection m_landmarkSelection;
+	bool m_iterativeSolver;
+	double m_solverTolerance;
+	std::size_t m_preconditionerRank;
 };
 
 
@@ -43,6 +43,9 @@
 #define SHARK_PARALLEL_FOR __pragma(omp parallel for)\
 for
 
+#define SHARK_PARALLEL_FOR_DYNAMIC __pragma(omp parallel for schedule(dynamic))\
+for
+
 #define SHARK_CRITICAL_REGION __pragma(omp critical)
 
 #else
@@ -50,17 +53,46 @@ for
 _Pragma ( "omp parallel for" )\
 for
 
+#define SHARK_PARALLEL_FOR_DYNAMIC \
+_Pragma ( "omp parallel for schedule(dynamic)" )\
+for
+
 #define SHARK_CRITICAL_REGION _Pragma("omp critical (globalSharkLock)")
 #endif
 
+#if defined(BOOST_MSVC) && !defined(__INTEL_COMPILER)
+#define SHARK_PARALLEL_REGION __pragma(omp parallel)
+#define SHARK_SINGLE __pragma(omp single)
+//MSVC only supports OpenMP 2.0 which does not have tasks. They are executed immediately instead
+#define SHARK_TASK
+#define SHARK_TASKWAIT
+#elif defined(BOOST_MSVC) || defined(__INTEL_COMPILER)
+#define SHARK_PARALLEL_REGION __pragma(omp parallel)
+#define SHARK_SINGLE __pragma(omp single)
+#define SHARK_TASK __pragma(omp task)
+#define SHARK_TASKWAIT __pragma(omp taskwait)
+#else
+#define SHARK_PARALLEL_REGION _Pragma("omp parallel")
+#define SHARK_SINGLE _Pragma("omp single")
+#define SHARK_TASK _Pragma("omp task")
+#define SHARK_TASKWAIT _Pragma("omp taskwait")
+#endif
+
 #define SHARK_NUM_THREADS (std::size_t)(omp_in_parallel()?omp_get_num_threads():omp_get_max_threads())
 #define SHARK_THREAD_NUM (std::size_t)(omp_in_parallel()?omp_get_thread_num():0)
+#define SHARK_IN_PARALLEL (omp_in_parallel() != 0)
 
 #else
 #define SHARK_PARALLEL_FOR for
+#define SHARK_PARALLEL_FOR_DYNAMIC for
 #define SHARK_CRITICAL_REGION
+#define SHARK_PARALLEL_REGION
+#define SHARK_SINGLE
+#define SHARK_TASK
+#define SHARK_TASKWAIT
 #define SHARK_NUM_THREADS (std::size_t)1
 #define SHARK_THREAD_NUM (std::size_t)0
+#define SHARK_IN_PARALLEL false
 #endif
 
 #endif
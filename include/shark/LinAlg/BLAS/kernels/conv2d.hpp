@@ -32,11 +32,66 @@
 #define REMORA_KERNELS_CONV2D_HPP
 
 #include "default/conv2d.hpp"
+#include "default/conv2d_gemm.hpp"
+#include "default/conv2d_fft.hpp"
+#include <cmath>
 
 
 namespace remora{namespace kernels{
 	
 
+///\brief Algorithms implementing the conv2d kernel.
+enum class conv2d_algorithm{
+	automatic, ///< chosen by select_conv2d_algorithm
+	direct, ///< blocked direct convolution
+	gemm, ///< unrolls the image (im2col) and computes a matrix-matrix product
+	fft ///< pointwise products of the transformed image and filters
+};
+
+///\brief Chooses the fastest algorithm for the conv2d kernel based on a simple cost model.
+///
+/// The cost of the direct convolution and of the gemm based version is the number of multiply-adds
+/// including the padding of the direct kernel. The gemm kernel runs at a higher rate but needs to unroll the image first.
+/// The cost of the fft version is dominated by the C+F+CF transforms of size N, where N is the
+/// padded image size. The constants were measured with examples/Benchmark/BLAS/conv2d.cpp.
+template<class T>
+conv2d_algorithm select_conv2d_algorithm(
+	std::size_t image_size1, std::size_t image_size2,
+	std::size_t filter_size1, std::size_t filter_size2,
+	std::size_t num_channels, std::size_t num_filters
+){
+	double output_size1 = double(image_size1 - filter_size1 + 1);
+	double output_size2 = double(image_size2 - filter_size2 + 1);
+	double filter_size = double(filter_size1 * filter_size2);
+	double channels = double(num_channels);
+	double filters = double(num_filters);
+
+	//direct: filters and columns are computed in padded blocks
+	typedef bindings::conv2d_block_size<T> block_size;
+	double padded_filters = std::ceil(filters / block_size::num_filter_outputs) * block_size::num_filter_outputs;
+	double padded_output2 = std::ceil(output_size2 / block_size::col_block_size) * block_size::col_block_size;
+	double direct_cost = output_size1 * padded_output2 * filter_size * channels * padded_filters;
+
+	//gemm: faster multiply-adds, in single precision twice as many fit into a vector register.
+	//But the unrolled image is larger than the image by the filter size and copying an element is
+	//about as expensive as two multiply-adds of the direct kernel.
+	double gemm_rate = sizeof(T) <= 4? 0.15: 0.5;
+	double gemm_cost = gemm_rate * output_size1 * output_size2 * filter_size * channels * filters
+		+ 2 * output_size1 * output_size2 * filter_size * channels;
+
+	//fft: a transform of size N costs about N log N complex multiply-adds
+	//which are roughly 8 times as expensive as a multiply-add of the direct kernel.
+	double n = double(bindings::fft_size(image_size1) * bindings::fft_size(image_size2));
+	double transforms = channels + filters + channels * filters;
+	double fft_cost = 8 * (transforms * n * std::log2(n) + channels * filters * n);
+
+	if(fft_cost < direct_cost && fft_cost < gemm_cost)
+		return conv2d_algorithm::fft;
+	if(gemm_cost < direct_cost)
+		return conv2d_algorithm::gemm;
+	return conv2d_algorithm::direct;
+}
+
 ///\brief Computes the convolution of a multi-channel image with a set of filters. 
 ///
 /// Computes the result of applying k filters to an image where filters and image are allowed
@@ -51,14 +106,19 @@ namespace remora{namespace kernels{
 /// set of l filters of size n1 x m1 with k channels each. the n1 rows form a channel, k*n1 rows form
 /// a filter.
 /// the output format is stored in the same way as image just with size (l* (m-m1+1))x(n-n1+1).
-/// The caller must ensure that enough memory is stored.	
+/// The caller must ensure that enough memory is stored.
+///
+/// By default the algorithm is chosen by select_conv2d_algorithm. All algorithms are parallelized
+/// using OpenMP when it is enabled: the direct and fft versions compute the filters in parallel, the gemm
+/// version splits the matrix-matrix product.
 template<class E1, class E2, class M>
 void conv2d(
 	matrix_expression<E1, cpu_tag> const& image,
 	matrix_expression<E2, cpu_tag> const& filter,
 	matrix_expression<M, cpu_tag>& output,
 	std::size_t num_channels,
-	std::size_t num_filters
+	std::size_t num_filters,
+	conv2d_algorithm algorithm = conv2d_algorithm::automatic
 ){
 	SIZE_CHECK(filter().size1() % (num_filters * num_channels)  == 0);
 	SIZE_CHECK(image().size1() % num_channels  == 0);
@@ -66,9 +126,24 @@ void conv2d(
 	SIZE_CHECK(output().size1()/num_filters + filter().size1()/(num_filters * num_channels) -1 == image().size1() / num_channels);
 	SIZE_CHECK(output().size2() + filter().size2() -1 == image().size2());
 	
-	bindings::conv2d(
-		image, filter, output, num_channels, num_filters
-	);
+	if(algorithm == conv2d_algorithm::automatic){
+		typedef typename std::common_type<typename E1::value_type, typename E2::value_type>::type value_type;
+		algorithm = select_conv2d_algorithm<value_type>(
+			image().size1() / num_channels, image().size2(),
+			filter().size1()/(num_filters * num_channels), filter().size2(),
+			num_channels, num_filters
+		);
+	}
+	switch(algorithm){
+	case conv2d_algorithm::fft:
+		bindings::conv2d_fft(image, filter, output, num_channels, num_filters);
+		break;
+	case conv2d_algorithm::gemm:
+		bindings::conv2d_im2col(image, filter, output, num_channels, num_filters);
+		break;
+	default:
+		bindings::conv2d_direct(image, filter, output, num_channels, num_filters);
+	}
 }
 
 }}
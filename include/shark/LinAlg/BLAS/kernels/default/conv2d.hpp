@@ -173,8 +173,13 @@ void pack_image(
 	}
 }
 
+// direct convolution.
+//
+// The filters are packed in blocks of block_size::num_filter_outputs interleaved filters.
+// The blocks are processed in parallel, every block tiles the output and computes the
+// convolution of every tile using the micro kernel.
 template<class E1, class E2, class M>
-void conv2d(
+void conv2d_direct(
 	matrix_expression<E1, cpu_tag> const& image,
 	matrix_expression<E2, cpu_tag> const& filter,
 	matrix_expression<M, cpu_tag>& output,
@@ -202,30 +207,35 @@ void conv2d(
 
 	boost::alignment::aligned_allocator<value_type,block_size::block::align> allocator;
 	value_type* filter_temporary = allocator.allocate(filter_blocks * num_channels * size_filter_block);
-	value_type* image_temporary = allocator.allocate(num_channels * image_block_size * image_block_size);
-	value_type* output_temporary = allocator.allocate(num_filter_outputs * output_block_size * output_block_size);
 
 	//pack filter into temporary memory
 	pack_filter(filter_temporary,filter,num_channels, num_filters, block_size());
 
-	for(std::size_t i = 0; i != output_blocks1; ++i){
-		std::size_t cur_out_size1 = std::min(output_block_size, output_size1 - i * output_block_size);
-		std::size_t cur_image_size1 = cur_out_size1 + filter_size1 -1;//extend image area to fit the patch
-		std::size_t block_start1 = i * output_block_size;
-		for(std::size_t j = 0; j != output_blocks2; ++j){
-			std::size_t cur_out_size2 = std::min(output_block_size,output_size2 - j * output_block_size);
-			cur_out_size2 = (cur_out_size2 +col_block_size -1)/col_block_size * col_block_size;//take padding into account
-			std::size_t cur_image_size2 = cur_out_size2 + filter_size2 -1;//extend image area to fit the patch
-			std::size_t block_start2 = j * output_block_size;
+	#ifdef _OPENMP
+	#pragma omp parallel for
+	#endif
+	for(int block_index = 0; block_index < (int)filter_blocks; ++block_index){
+		std::size_t block = block_index;
+		boost::alignment::aligned_allocator<value_type,block_size::block::align> thread_allocator;
+		value_type* image_temporary = thread_allocator.allocate(num_channels * image_block_size * image_block_size);
+		value_type* output_temporary = thread_allocator.allocate(num_filter_outputs * output_block_size * output_block_size);
+		for(std::size_t i = 0; i != output_blocks1; ++i){
+			std::size_t cur_out_size1 = std::min(output_block_size, output_size1 - i * output_block_size);
+			std::size_t cur_image_size1 = cur_out_size1 + filter_size1 -1;//extend image area to fit the patch
+			std::size_t block_start1 = i * output_block_size;
+			for(std::size_t j = 0; j != output_blocks2; ++j){
+				std::size_t cur_out_size2 = std::min(output_block_size,output_size2 - j * output_block_size);
+				cur_out_size2 = (cur_out_size2 +col_block_size -1)/col_block_size * col_block_size;//take padding into account
+				std::size_t cur_image_size2 = cur_out_size2 + filter_size2 -1;//extend image area to fit the patch
+				std::size_t block_start2 = j * output_block_size;
 
-			pack_image(
-				image_temporary, image, num_channels,
-				block_start1,block_start2,
-				cur_image_size1, cur_image_size2,
-				block_size()
-			);
+				pack_image(
+					image_temporary, image, num_channels,
+					block_start1,block_start2,
+					cur_image_size1, cur_image_size2,
+					block_size()
+				);
 
-			for( std::size_t block = 0; block != filter_blocks; ++block){
 				//clear temporary output memory
 				for(std::size_t l = 0; l != num_filter_outputs * cur_out_size1 * cur_out_size2; ++l){
 					output_temporary[l] = value_type();
@@ -253,10 +263,10 @@ void conv2d(
 				}
 			}
 		}
+		thread_allocator.deallocate(image_temporary, num_channels * image_block_size * image_block_size);
+		thread_allocator.deallocate(output_temporary, num_filter_outputs * output_block_size * output_block_size);
 	}
 	allocator.deallocate(filter_temporary, filter_blocks * num_channels * size_filter_block);
-	allocator.deallocate(image_temporary, num_channels * image_block_size * image_block_size);
-	allocator.deallocate(output_temporary, num_filter_outputs * output_size1 * output_size2);
 }
 
 }}
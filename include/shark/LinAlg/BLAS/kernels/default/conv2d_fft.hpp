@@ -0,0 +1,190 @@
+/*!
+ *
+ *
+ * \brief       Implements the 2D convolution kernel for cpus using the fast fourier transform
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REMORA_KERNELS_DEFAULT_CONV2D_FFT_HPP
+#define REMORA_KERNELS_DEFAULT_CONV2D_FFT_HPP
+
+#include "../../expression_types.hpp"//for matrix_expression
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <type_traits> //std::common_type
+
+namespace remora{namespace bindings {
+
+//smallest power of two which is at least n
+inline std::size_t fft_size(std::size_t n){
+	std::size_t size = 1;
+	while(size < n) size *= 2;
+	return size;
+}
+
+//precomputed tables for the radix-2 transform of a fixed length n.
+template<class T>
+struct fft_plan{
+	std::size_t n;
+	std::vector<std::size_t> bit_reverse;
+	std::vector<std::complex<T> > twiddle;//twiddle[k] = exp(-2 pi i k/n), k < n/2
+
+	explicit fft_plan(std::size_t size):n(size), bit_reverse(size), twiddle(size/2){
+		std::size_t log_n = 0;
+		while((std::size_t(1) << log_n) < n) ++log_n;
+		for(std::size_t i = 0; i != n; ++i){
+			std::size_t r = 0;
+			for(std::size_t b = 0; b != log_n; ++b){
+				if(i & (std::size_t(1) << b))
+					r |= std::size_t(1) << (log_n - 1 - b);
+			}
+			bit_reverse[i] = r;
+		}
+		T const pi = T(3.14159265358979323846);
+		for(std::size_t k = 0; k != n/2; ++k){
+			twiddle[k] = std::polar(T(1), -2 * pi * T(k) / T(n));
+		}
+	}
+};
+
+//in-place iterative radix-2 transform of n elements with the given stride.
+//the inverse transform is not normalized.
+template<class T>
+void fft(std::complex<T>* x, std::size_t stride, fft_plan<T> const& plan, bool inverse){
+	std::size_t n = plan.n;
+	for(std::size_t i = 0; i != n; ++i){
+		std::size_t r = plan.bit_reverse[i];
+		if(i < r) std::swap(x[i * stride], x[r * stride]);
+	}
+	for(std::size_t len = 2; len <= n; len *= 2){
+		std::size_t half = len / 2;
+		std::size_t step = n / len;
+		for(std::size_t start = 0; start < n; start += len){
+			for(std::size_t k = 0; k != half; ++k){
+				std::complex<T> w = plan.twiddle[k * step];
+				if(inverse) w = std::conj(w);
+				std::complex<T>& a = x[(start + k) * stride];
+				std::complex<T>& b = x[(start + k + half) * stride];
+				std::complex<T> t = w * b;
+				b = a - t;
+				a += t;
+			}
+		}
+	}
+}
+
+//transforms a size1 x size2 row-major array in place.
+//Only the first nonzero_rows rows are transformed in the first pass, the others must be zero.
+template<class T>
+void fft2d(std::complex<T>* x, fft_plan<T> const& plan1, fft_plan<T> const& plan2, bool inverse, std::size_t nonzero_rows){
+	for(std::size_t i = 0; i != nonzero_rows; ++i){
+		fft(x + i * plan2.n, 1, plan2, inverse);
+	}
+	for(std::size_t j = 0; j != plan2.n; ++j){
+		fft(x + j, plan2.n, plan1, inverse);
+	}
+}
+
+// FFT based convolution.
+//
+// The channels of the image and the filters are zero padded to the next power of two
+// which is at least the image size. As the filter is not mirrored, the product of the
+// transformed image with the conjugate of the transformed filter computes the correlation.
+// As only shifts which do not leave the image are computed, the circular boundary
+// of the transform does not affect the result.
+// The cost is O((C+F+CF) N log N + CF N) with N the padded image size, compared to O(CF N K)
+// of the direct convolution with filters of size K. Thus it pays off for large filters.
+//
+// The image is transformed once and the filters are processed in parallel.
+template<class E1, class E2, class M>
+void conv2d_fft(
+	matrix_expression<E1, cpu_tag> const& image,
+	matrix_expression<E2, cpu_tag> const& filter,
+	matrix_expression<M, cpu_tag>& output,
+	std::size_t num_channels,
+	std::size_t num_filters
+){
+	typedef typename std::common_type<typename E1::value_type, typename E2::value_type>::type value_type;
+	typedef std::complex<value_type> complex_type;
+
+	std::size_t filter_size1 = filter().size1()/(num_channels * num_filters);
+	std::size_t filter_size2 = filter().size2();
+	std::size_t image_size1 = image().size1()/num_channels;
+	std::size_t image_size2 = image().size2();
+	std::size_t output_size1 = image_size1 +1 - filter_size1;
+	std::size_t output_size2 = image_size2 +1 - filter_size2;
+
+	fft_plan<value_type> plan1(fft_size(image_size1));
+	fft_plan<value_type> plan2(fft_size(image_size2));
+	std::size_t n = plan1.n * plan2.n;
+
+	//transform the image channels
+	std::vector<complex_type> image_transformed(num_channels * n, complex_type());
+	for(std::size_t c = 0; c != num_channels; ++c){
+		complex_type* channel = image_transformed.data() + c * n;
+		for(std::size_t i = 0; i != image_size1; ++i){
+			for(std::size_t j = 0; j != image_size2; ++j){
+				channel[i * plan2.n + j] = image()(c * image_size1 + i, j);
+			}
+		}
+		fft2d(channel, plan1, plan2, false, image_size1);
+	}
+
+	value_type scaling = value_type(1) / value_type(n);
+	#ifdef _OPENMP
+	#pragma omp parallel for
+	#endif
+	for(int fi = 0; fi < (int)num_filters; ++fi){
+		std::size_t f = fi;
+		std::vector<complex_type> result(n, complex_type());
+		std::vector<complex_type> buffer(n);
+		for(std::size_t c = 0; c != num_channels; ++c){
+			std::fill(buffer.begin(), buffer.end(), complex_type());
+			std::size_t filter_start = (f * num_channels + c) * filter_size1;
+			for(std::size_t i = 0; i != filter_size1; ++i){
+				for(std::size_t j = 0; j != filter_size2; ++j){
+					buffer[i * plan2.n + j] = filter()(filter_start + i, j);
+				}
+			}
+			fft2d(buffer.data(), plan1, plan2, false, filter_size1);
+			complex_type const* channel = image_transformed.data() + c * n;
+			for(std::size_t k = 0; k != n; ++k){
+				result[k] += channel[k] * std::conj(buffer[k]);
+			}
+		}
+		fft2d(result.data(), plan1, plan2, true, plan1.n);
+		for(std::size_t i = 0; i != output_size1; ++i){
+			for(std::size_t j = 0; j != output_size2; ++j){
+				output()(f * output_size1 + i, j) = scaling * result[i * plan2.n + j].real();
+			}
+		}
+	}
+}
+
+}}
+
+#endif
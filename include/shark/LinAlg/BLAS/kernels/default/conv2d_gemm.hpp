@@ -0,0 +1,141 @@
+/*!
+ *
+ *
+ * \brief       Implements the 2D convolution kernel for cpus by reduction to a matrix-matrix product
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REMORA_KERNELS_DEFAULT_CONV2D_GEMM_HPP
+#define REMORA_KERNELS_DEFAULT_CONV2D_GEMM_HPP
+
+#include "../gemm.hpp" //gemm kernel
+#include "../../detail/matrix_proxy_classes.hpp"//matrix_range, dense_matrix_adaptor
+#include <vector>
+#include <algorithm>
+#include <type_traits> //std::common_type
+
+namespace remora{namespace bindings {
+
+//maximum number of elements of the unrolled image tile
+static const std::size_t conv2d_im2col_max_tile = 1 << 20;
+
+// im2col based convolution.
+//
+// Unrolls every receptive field of the image into a column of a matrix P of size
+// (C*K1*K2) x (O1*O2). The filters form a matrix W of size F x (C*K1*K2) and the
+// output is given by the product W P, which is computed by the gemm kernel.
+// To bound the memory of P, the output is computed in tiles of full output rows.
+// The columns of every tile are split in blocks which are multiplied in parallel.
+template<class E1, class E2, class M>
+void conv2d_im2col(
+	matrix_expression<E1, cpu_tag> const& image,
+	matrix_expression<E2, cpu_tag> const& filter,
+	matrix_expression<M, cpu_tag>& output,
+	std::size_t num_channels,
+	std::size_t num_filters
+){
+	typedef typename std::common_type<typename E1::value_type, typename E2::value_type>::type value_type;
+	typedef dense_matrix_adaptor<value_type, row_major> adaptor;
+
+	std::size_t filter_size1 = filter().size1()/(num_channels * num_filters);
+	std::size_t filter_size2 = filter().size2();
+	std::size_t image_size1 = image().size1()/num_channels;
+	std::size_t output_size1 = output().size1()/num_filters;
+	std::size_t output_size2 = output().size2();
+	std::size_t patch_size = num_channels * filter_size1 * filter_size2;
+
+	//rows of output computed per tile
+	std::size_t tile_rows = std::max<std::size_t>(1,conv2d_im2col_max_tile / (patch_size * output_size2));
+	tile_rows = std::min(tile_rows, output_size1);
+	std::size_t tile_size = tile_rows * output_size2;
+
+	//store filters as matrix with one filter per row
+	std::vector<value_type> filter_storage(num_filters * patch_size);
+	adaptor filter_matrix(filter_storage.data(), num_filters, patch_size);
+	for(std::size_t f = 0; f != num_filters; ++f){
+		for(std::size_t c = 0; c != num_channels; ++c){
+			for(std::size_t i = 0; i != filter_size1; ++i){
+				std::size_t filter_row = (f * num_channels + c) * filter_size1 + i;
+				std::size_t col = (c * filter_size1 + i) * filter_size2;
+				for(std::size_t j = 0; j != filter_size2; ++j){
+					filter_matrix(f, col + j) = filter()(filter_row, j);
+				}
+			}
+		}
+	}
+
+	std::vector<value_type> patch_storage(patch_size * tile_size);
+	std::vector<value_type> result_storage(num_filters * tile_size);
+	for(std::size_t tile_start = 0; tile_start < output_size1; tile_start += tile_rows){
+		std::size_t cur_rows = std::min(tile_rows, output_size1 - tile_start);
+		std::size_t cur_size = cur_rows * output_size2;
+		adaptor patches(patch_storage.data(), patch_size, cur_size);
+		adaptor result(result_storage.data(), num_filters, cur_size);
+
+		//im2col: row (c,i,j) of the patch matrix holds the pixels image(c, x1 + i, x2 + j) for all outputs (x1,x2)
+		for(std::size_t c = 0; c != num_channels; ++c){
+			for(std::size_t i = 0; i != filter_size1; ++i){
+				for(std::size_t j = 0; j != filter_size2; ++j){
+					std::size_t patch_row = (c * filter_size1 + i) * filter_size2 + j;
+					for(std::size_t x1 = 0; x1 != cur_rows; ++x1){
+						std::size_t image_row = c * image_size1 + tile_start + x1 + i;
+						for(std::size_t x2 = 0; x2 != output_size2; ++x2){
+							patches(patch_row, x1 * output_size2 + x2) = image()(image_row, x2 + j);
+						}
+					}
+				}
+			}
+		}
+
+		//multiply column blocks in parallel
+		std::size_t block_size = 256;
+		std::size_t num_blocks = (cur_size + block_size - 1) / block_size;
+		#ifdef _OPENMP
+		#pragma omp parallel for
+		#endif
+		for(int bi = 0; bi < (int)num_blocks; ++bi){
+			std::size_t start = bi * block_size;
+			std::size_t end = std::min(start + block_size, cur_size);
+			matrix_range<adaptor> result_block(result, 0, num_filters, start, end);
+			matrix_range<adaptor> patch_block(patches, 0, patch_size, start, end);
+			result_block.clear();
+			kernels::gemm(filter_matrix, patch_block, result_block, value_type(1));
+		}
+
+		//copy result to output
+		for(std::size_t f = 0; f != num_filters; ++f){
+			for(std::size_t x1 = 0; x1 != cur_rows; ++x1){
+				for(std::size_t x2 = 0; x2 != output_size2; ++x2){
+					output()(f * output_size1 + tile_start + x1, x2) = result(f, x1 * output_size2 + x2);
+				}
+			}
+		}
+	}
+}
+
+}}
+
+#endif
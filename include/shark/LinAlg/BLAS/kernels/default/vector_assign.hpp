@@ -29,8 +29,16 @@
 #define REMORA_KERNELS_DEFAULT_VECTOR_ASSIGN_HPP
 
 #include "../../expression_types.hpp"
+#include "../../detail/functional.hpp"
+#include "simd_math.hpp"
+#include <type_traits>
 
-namespace remora{namespace bindings{
+namespace remora{
+
+template<class E, class F>
+class vector_unary;
+
+namespace bindings{
 
 template<class F, class V>
 void assign(vector_expression<V, cpu_tag>& v, typename V::value_type t) {
@@ -56,6 +64,80 @@ void vector_assign(
 		v()(i) = static_cast<typename V::value_type>(e()(i));
 	}
 }
+
+#ifdef REMORA_USE_SIMD
+//elementwise functions with vectorized kernels in simd_math.hpp
+template<class F>
+struct simd_math_function: public std::false_type{};
+template<>
+struct simd_math_function<functors::scalar_exp<double> >: public std::true_type{
+	typedef simd_math::exp_function type;
+};
+//with two values per block the log kernel is slower than the standard library
+#if REMORA_VECTOR_LENGTH >= 32
+template<>
+struct simd_math_function<functors::scalar_log<double> >: public std::true_type{
+	typedef simd_math::log_function type;
+};
+#endif
+template<>
+struct simd_math_function<functors::scalar_tanh<double> >: public std::true_type{
+	typedef simd_math::tanh_function type;
+};
+template<>
+struct simd_math_function<functors::scalar_sigmoid<double> >: public std::true_type{
+	typedef simd_math::sigmoid_function type;
+};
+
+//the argument is stored densely: the kernel reads it directly
+template< class V, class E, class Function, class Storage>
+void simd_math_apply(
+	vector_expression<V, cpu_tag>& v, E const& e, Function const& f, Storage const& v_storage, std::true_type
+) {
+	auto e_storage = e.raw_storage();
+	simd_math::apply(f, e_storage.values, e_storage.stride, v_storage.values, v_storage.stride, v().size());
+}
+//otherwise the argument is evaluated into v first and then transformed in-place
+template< class V, class E, class Function, class Storage>
+void simd_math_apply(
+	vector_expression<V, cpu_tag>& v, E const& e, Function const& f, Storage const& v_storage, std::false_type
+) {
+	vector_assign(v, e, dense_tag(), dense_tag());
+	simd_math::apply(f, v_storage.values, v_storage.stride, v_storage.values, v_storage.stride, v().size());
+}
+
+template< class V, class E, class F>
+void vector_assign_simd_math(
+	vector_expression<V, cpu_tag>& v, vector_unary<E, F> const& e, std::false_type
+) {
+	for(std::size_t i = 0; i != v().size(); ++i){
+		v()(i) = static_cast<typename V::value_type>(e(i));
+	}
+}
+
+template< class V, class E, class F>
+void vector_assign_simd_math(
+	vector_expression<V, cpu_tag>& v, vector_unary<E, F> const& e, std::true_type
+) {
+	typename simd_math_function<F>::type f;
+	auto v_storage = v().raw_storage();
+	simd_math_apply(v, e.expression(), f, v_storage, std::is_same<typename E::const_storage_type::storage_tag, dense_tag>());
+}
+
+// Dense-Dense case for elementwise functions. exp, log, tanh and sigmoid
+// of double vectors are computed by the vectorized kernels
+template< class V, class E, class F>
+void vector_assign(
+	vector_expression<V, cpu_tag>& v, vector_expression<vector_unary<E, F>, cpu_tag> const& e,
+	dense_tag, dense_tag
+) {
+	typedef std::integral_constant<bool,
+		simd_math_function<F>::value
+		&& std::is_same<typename V::storage_type, dense_vector_storage<double> >::value
+	> use_simd_math;
+	vector_assign_simd_math(v, e(), use_simd_math());
+}
+#endif
 // Dense-packed case
 template< class V, class E>
 void vector_assign(
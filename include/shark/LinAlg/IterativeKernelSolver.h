@@ -0,0 +1,352 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Matrix-free solvers for regularized kernel matrices
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_LINALG_ITERATIVEKERNELSOLVER_H
+#define SHARK_LINALG_ITERATIVEKERNELSOLVER_H
+
+#include <shark/LinAlg/Base.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/Models/Kernels/NystromFeatureMap.h>
+#include <shark/Algorithms/Trainers/NystromTrainer.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <vector>
+#include <cmath>
+
+namespace shark {
+
+///
+/// \brief Matrix-free representation of the regularized kernel matrix \f$ M = K + \sigma^2 I \f$.
+///
+/// The matrix is never stored. Products with M are computed blockwise from the batches
+/// of the dataset, evaluating every kernel block on the fly. The row blocks are
+/// processed in parallel, each thread writing only its own rows of the result. Thus the memory
+/// is O(n) per right hand side plus one kernel block per thread.
+///
+template<class InputType>
+class RegularizedKernelOperator{
+public:
+	typedef AbstractKernelFunction<InputType> KernelType;
+
+	RegularizedKernelOperator(KernelType const* kernel, Data<InputType> const& data, double regularizer)
+	: mep_kernel(kernel), m_data(data), m_regularizer(regularizer), m_batchStart(data.numberOfBatches()+1,0){
+		SHARK_RUNTIME_CHECK(regularizer >= 0, "[RegularizedKernelOperator] regularizer must be >=0");
+		for(std::size_t i = 0; i != data.numberOfBatches(); ++i){
+			m_batchStart[i+1] = m_batchStart[i] + batchSize(data.batch(i));
+		}
+	}
+
+	/// \brief Dimension n of the matrix.
+	std::size_t size()const{
+		return m_batchStart.back();
+	}
+
+	double regularizer()const{
+		return m_regularizer;
+	}
+
+	/// \brief Computes Y = M X for a matrix X with one right hand side per column.
+	void multiply(RealMatrix const& X, RealMatrix& Y)const{
+		SIZE_CHECK(X.size1() == size());
+		Y.resize(X.size1(),X.size2());
+		std::size_t B = m_data.numberOfBatches();
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)B; ++i){
+			std::size_t startX = m_batchStart[i];
+			std::size_t endX = m_batchStart[i+1];
+			auto Yi = rows(Y,startX,endX);
+			noalias(Yi) = m_regularizer * rows(X,startX,endX);
+			for(std::size_t j = 0; j != B; ++j){
+				RealMatrix block = (*mep_kernel)(m_data.batch(i), m_data.batch(j));
+				noalias(Yi) += prod(block,rows(X,m_batchStart[j],m_batchStart[j+1]));
+			}
+		}
+	}
+
+	/// \brief Returns the diagonal of M.
+	RealVector diagonal()const{
+		RealVector diag(size());
+		for(std::size_t i = 0; i != m_data.numberOfBatches(); ++i){
+			RealMatrix block = (*mep_kernel)(m_data.batch(i), m_data.batch(i));
+			noalias(subrange(diag,m_batchStart[i],m_batchStart[i+1])) = blas::diag(block);
+		}
+		diag += m_regularizer;
+		return diag;
+	}
+
+	/// \brief Computes the weighted derivative of K w.r.t. the kernel parameters for the low-rank weights \f$ W = A B^T \f$.
+	///
+	/// The result is \f$ \sum_{ij} (AB^T)_{ij} \partial k(x_i,x_j)/\partial \theta \f$. W is never formed,
+	/// only one block of it per thread. The row blocks are processed in parallel and summed in a fixed order.
+	RealVector weightedParameterDerivative(RealMatrix const& A, RealMatrix const& Bmat)const{
+		SIZE_CHECK(A.size1() == size());
+		SIZE_CHECK(Bmat.size1() == size());
+		SIZE_CHECK(A.size2() == Bmat.size2());
+		std::size_t B = m_data.numberOfBatches();
+		std::size_t kp = mep_kernel->numberOfParameters();
+		RealMatrix rowGradients(B,kp,0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)B; ++i){
+			boost::shared_ptr<State> state = mep_kernel->createState();
+			RealMatrix block;
+			RealVector blockGradient(kp);
+			auto Ai = rows(A,m_batchStart[i],m_batchStart[i+1]);
+			for(std::size_t j = 0; j != B; ++j){
+				RealMatrix weights = prod(Ai,trans(rows(Bmat,m_batchStart[j],m_batchStart[j+1])));
+				mep_kernel->eval(m_data.batch(i), m_data.batch(j),block,*state);
+				mep_kernel->weightedParameterDerivative(m_data.batch(i), m_data.batch(j),weights,*state,blockGradient);
+				noalias(row(rowGradients,i)) += blockGradient;
+			}
+		}
+		RealVector gradient(kp,0.0);
+		for(std::size_t i = 0; i != B; ++i){
+			noalias(gradient) += row(rowGradients,i);
+		}
+		return gradient;
+	}
+
+private:
+	KernelType const* mep_kernel;
+	Data<InputType> m_data;
+	double m_regularizer;
+	std::vector<std::size_t> m_batchStart;
+};
+
+///
+/// \brief Preconditioner for the regularized kernel matrix.
+///
+/// With rank 0, the Jacobi preconditioner \f$ diag(M)^{-1} \f$ is used.
+/// Otherwise the kernel matrix is approximated by a uniform Nystroem approximation \f$ \Phi \Phi^T \f$
+/// with the given number of landmarks and \f$ (\Phi \Phi^T + \sigma^2 I)^{-1} \f$
+/// is applied by the Woodbury identity in O(n r) time and memory. This clusters the spectrum of
+/// the preconditioned matrix around one for kernels with fast decaying spectrum, e.g. Gaussian kernels, for which
+/// the Jacobi preconditioner is useless.
+///
+template<class InputType>
+class RegularizedKernelPreconditioner{
+public:
+	RegularizedKernelPreconditioner(
+		AbstractKernelFunction<InputType>* kernel,
+		Data<InputType> const& data,
+		RegularizedKernelOperator<InputType> const& op,
+		std::size_t rank
+	):m_regularizer(op.regularizer()){
+		if(rank == 0 || m_regularizer <= 0){
+			m_diagonal = op.diagonal();
+			return;
+		}
+		NystromFeatureMap<InputType> featureMap;
+		NystromTrainer<InputType> trainer(kernel, rank);
+		trainer.train(featureMap,data);
+		m_features = createBatch<RealVector>(featureMap(data).elements());
+		RealMatrix inner = m_regularizer * blas::identity_matrix<double>(m_features.size2());
+		noalias(inner) += prod(trans(m_features),m_features);
+		m_cholesky.decompose(inner);
+	}
+
+	/// \brief Replaces R by the preconditioned residuals.
+	void apply(RealMatrix& R)const{
+		if(m_features.size1() == 0){
+			for(std::size_t i = 0; i != R.size1(); ++i){
+				row(R,i) /= m_diagonal(i);
+			}
+			return;
+		}
+		//(Phi Phi^T + s I)^{-1} = (I - Phi(s I + Phi^T Phi)^{-1} Phi^T)/s
+		RealMatrix T = prod(trans(m_features),R);
+		m_cholesky.solve(T,blas::left());
+		noalias(R) -= prod(m_features,T);
+		R /= m_regularizer;
+	}
+private:
+	double m_regularizer;
+	RealVector m_diagonal;
+	RealMatrix m_features;
+	blas::cholesky_decomposition<RealMatrix> m_cholesky;
+};
+
+/// \brief Solves M X = B for symmetric positive definite M by preconditioned conjugate gradients.
+///
+/// Every column of B is an independent system, but all share the products with M so
+/// that the kernel is evaluated only once per iteration for all right hand sides.
+/// A column is converged when its residual norm is below tolerance times the norm of its right hand side.
+/// X is used as starting point if it has the right size, otherwise the iteration starts at 0.
+/// \return the number of iterations
+template<class Operator, class Preconditioner>
+std::size_t conjugateGradientSolve(
+	Operator const& op, Preconditioner const& preconditioner,
+	RealMatrix const& B, RealMatrix& X,
+	double tolerance = 1.e-8, std::size_t maxIterations = 0
+){
+	std::size_t n = B.size1();
+	std::size_t k = B.size2();
+	if(maxIterations == 0) maxIterations = n;
+	RealMatrix R = B;
+	if(X.size1() == n && X.size2() == k){
+		RealMatrix MX;
+		op.multiply(X,MX);
+		noalias(R) -= MX;
+	}else{
+		X.resize(n,k);
+		X.clear();
+	}
+	RealVector threshold(k);
+	std::vector<bool> active(k,true);
+	for(std::size_t c = 0; c != k; ++c){
+		threshold(c) = tolerance * norm_2(column(B,c));
+	}
+	RealMatrix Z = R;
+	preconditioner.apply(Z);
+	RealMatrix P = Z;
+	RealVector rz(k);
+	for(std::size_t c = 0; c != k; ++c){
+		rz(c) = inner_prod(column(R,c),column(Z,c));
+	}
+
+	RealMatrix MP;
+	std::size_t iter = 0;
+	for(; iter != maxIterations; ++iter){
+		bool anyActive = false;
+		for(std::size_t c = 0; c != k; ++c){
+			if(active[c] && norm_2(column(R,c)) <= threshold(c))
+				active[c] = false;
+			anyActive |= active[c];
+		}
+		if(!anyActive) break;
+
+		op.multiply(P,MP);
+		for(std::size_t c = 0; c != k; ++c){
+			if(!active[c]) continue;
+			double alpha = rz(c) / inner_prod(column(P,c),column(MP,c));
+			noalias(column(X,c)) += alpha * column(P,c);
+			noalias(column(R,c)) -= alpha * column(MP,c);
+		}
+		noalias(Z) = R;
+		preconditioner.apply(Z);
+		for(std::size_t c = 0; c != k; ++c){
+			if(!active[c]) continue;
+			double rzNew = inner_prod(column(R,c),column(Z,c));
+			double beta = rzNew / rz(c);
+			rz(c) = rzNew;
+			noalias(column(P,c)) = column(Z,c) + beta * column(P,c);
+		}
+	}
+	return iter;
+}
+
+/// \brief Estimates \f$ \log \det M \f$ by stochastic Lanczos quadrature.
+///
+/// For every probe vector v, a Lanczos run of at most the given number of steps
+/// computes a tridiagonal matrix T whose Gauss quadrature gives \f$ v^T \log(M) v \approx \|v\|^2 e_1^T \log(T) e_1 \f$.
+/// Averaging over Rademacher probes gives an unbiased estimate of \f$ tr(\log M) = \log \det M \f$
+/// (Ubaru, Chen and Saad, 2017). All probes share the products with M.
+/// \param op the matrix
+/// \param probes probe vectors, one per column
+/// \param steps maximum number of Lanczos steps
+template<class Operator>
+double stochasticLogDeterminant(Operator const& op, RealMatrix const& probes, std::size_t steps){
+	std::size_t n = probes.size1();
+	std::size_t k = probes.size2();
+	steps = std::min(steps,n);
+	RealVector probeNorm(k);
+	RealMatrix Q = probes;
+	for(std::size_t c = 0; c != k; ++c){
+		probeNorm(c) = norm_2(column(probes,c));
+		column(Q,c) /= probeNorm(c);
+	}
+	RealMatrix QPrev(n,k,0.0);
+	RealMatrix alpha(k,steps,0.0);
+	RealMatrix beta(k,steps,0.0);
+	std::vector<std::size_t> length(k,0);
+	std::vector<bool> active(k,true);
+
+	RealMatrix W;
+	for(std::size_t j = 0; j != steps; ++j){
+		op.multiply(Q,W);
+		bool anyActive = false;
+		for(std::size_t c = 0; c != k; ++c){
+			if(!active[c]) continue;
+			double a = inner_prod(column(Q,c),column(W,c));
+			alpha(c,j) = a;
+			length[c] = j+1;
+			noalias(column(W,c)) -= a * column(Q,c);
+			if(j > 0)
+				noalias(column(W,c)) -= beta(c,j-1) * column(QPrev,c);
+			double b = norm_2(column(W,c));
+			beta(c,j) = b;
+			//invariant subspace found, the quadrature is exact
+			if(b <= 1.e-12 * std::abs(a)){
+				active[c] = false;
+				continue;
+			}
+			anyActive = true;
+			noalias(column(QPrev,c)) = column(Q,c);
+			noalias(column(Q,c)) = column(W,c) / b;
+		}
+		if(!anyActive) break;
+	}
+
+	double logDet = 0;
+	for(std::size_t c = 0; c != k; ++c){
+		std::size_t m = length[c];
+		RealMatrix T(m,m,0.0);
+		for(std::size_t i = 0; i != m; ++i){
+			T(i,i) = alpha(c,i);
+			if(i+1 != m){
+				T(i,i+1) = T(i+1,i) = beta(c,i);
+			}
+		}
+		blas::symm_eigenvalue_decomposition<RealMatrix> eigen(T);
+		double quadrature = 0;
+		for(std::size_t i = 0; i != m; ++i){
+			double tau = eigen.Q()(0,i);
+			quadrature += tau * tau * std::log(eigen.D()(i));
+		}
+		logDet += sqr(probeNorm(c)) * quadrature;
+	}
+	return logDet / k;
+}
+
+/// \brief Draws k Rademacher probe vectors of dimension n for stochastic trace estimation.
+inline RealMatrix rademacherProbes(std::size_t n, std::size_t k){
+	RealMatrix probes(n,k);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t c = 0; c != k; ++c){
+			probes(i,c) = Rng::coinToss() ? 1.0 : -1.0;
+		}
+	}
+	return probes;
+}
+
+}
+#endif
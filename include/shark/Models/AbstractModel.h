@@ -101,7 +101,8 @@ public:
 		HAS_SECOND_PARAMETER_DERIVATIVE = 2,
 		HAS_FIRST_INPUT_DERIVATIVE      = 4,
 		HAS_SECOND_INPUT_DERIVATIVE     = 8,
-		IS_SEQUENTIAL = 16
+		IS_SEQUENTIAL = 16,
+		HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT = 32
 	};
 	SHARK_FEATURE_INTERFACE;
 
@@ -121,6 +122,10 @@ public:
 	bool hasSecondInputDerivative()const{
 		return m_features & HAS_SECOND_INPUT_DERIVATIVE;
 	}
+	/// \brief Returns true when directional derivatives and Hessian-vector products w.r.t. the parameters are implemented.
+	bool hasParameterHessianVectorProduct()const{
+		return m_features & HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
+	}
 	bool isSequential()const{
 		return m_features & IS_SEQUENTIAL;
 	}
@@ -255,6 +260,48 @@ public:
 		SHARK_FEATURE_EXCEPTION(HAS_SECOND_PARAMETER_DERIVATIVE);
 	}
 
+	/// \brief calculates the derivative of the outputs in a direction of the parameter space.
+	///
+	/// For every pattern x, this is the product of the jacobian of the output w.r.t. the parameters
+	/// with the direction, that is \f$ J(x) v \f$. The jacobian is never formed.
+	/// \param  patterns      the patterns to evaluate
+	/// \param  direction     the direction in parameter space
+	/// \param  state intermediate results stored by eval to speed up calculations of the derivatives
+	/// \param  derivative    the directional derivative of the output of every pattern
+	virtual void parameterDirectionalDerivative(
+		BatchInputType const & patterns,
+		RealVector const& direction,
+		State const& state,
+		BatchOutputType& derivative
+	)const{
+		SHARK_FEATURE_EXCEPTION(HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT);
+	}
+
+	/// \brief calculates the directional derivative of the weighted parameter derivative.
+	///
+	/// Let \f$ c(x) \f$ be the coefficients of weightedParameterDerivative, which may themselves depend on the parameters,
+	/// and let \f$ \dot c(x) \f$ be their derivative in the direction v. Then this method computes the derivative
+	/// of the weighted parameter derivative in direction v:
+	/// \f[ \sum_x J(x)^T \dot c(x) + \sum_x \sum_k c_k(x) \nabla^2 y_k(x) v \f]
+	/// For an error function, c is the derivative of the loss and \f$ \dot c \f$ the product of the hessian of the loss with
+	/// the output of parameterDirectionalDerivative. Then the result is the product of the Hessian of the error with v.
+	/// \param  patterns      the patterns to evaluate
+	/// \param  coefficients  the coefficients which are used to calculate the weighted sum for every pattern
+	/// \param  coefficientDerivative  the derivative of the coefficients in the direction
+	/// \param  direction     the direction in parameter space
+	/// \param  state intermediate results stored by eval to speed up calculations of the derivatives
+	/// \param  result        the directional derivative of the weighted parameter derivative
+	virtual void weightedParameterHessianVectorProduct(
+		BatchInputType const & patterns,
+		BatchOutputType const & coefficients,
+		BatchOutputType const & coefficientDerivative,
+		RealVector const& direction,
+		State const& state,
+		RealVector& result
+	)const{
+		SHARK_FEATURE_EXCEPTION(HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT);
+	}
+
 	///\brief calculates the weighted sum of derivatives w.r.t the inputs
 	///
 	/// \param  pattern       the patterns to evaluate
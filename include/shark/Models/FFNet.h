@@ -65,9 +65,27 @@ struct FFNetStructures{
 //! an input-output shortcut is used, that is a shortcut that connects the input neurons directly 
 //! with the output using linear weights. But also a fully connected structure is possible, where
 //! every layer is fed as input to every successive layer instead of only the next one.
-template<class HiddenNeuron,class OutputNeuron>
-class FFNet :public AbstractModel<RealVector,RealVector>
+//!
+//! The third template argument is the vector type of inputs and outputs, which also determines the
+//! precision of the weights and of all computations. Using FloatVector halves the memory traffic
+//! and doubles the width of the vector instructions compared to the default RealVector.
+//! The parameter vector and the parameter derivative are always in double precision. Thus optimizers
+//! keep their state in double precision and the derivatives of the batches are summed in double precision.
+template<class HiddenNeuron,class OutputNeuron, class VectorType = RealVector>
+class FFNet :public AbstractModel<VectorType,VectorType>
 {
+public:
+	typedef typename VectorType::value_type value_type;
+	typedef blas::matrix<value_type, blas::row_major> MatrixType;
+	typedef AbstractModel<VectorType,VectorType> base_type;
+	typedef typename base_type::BatchInputType BatchInputType;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+private:
+	//! \brief Whether the neurons allow Hessian-vector products, which need their second derivatives.
+	typedef std::integral_constant<bool,
+		HasSecondDerivativeNeuron<HiddenNeuron>::value && HasSecondDerivativeNeuron<OutputNeuron>::value
+	> NeuronsHaveSecondDerivative;
+
 	struct InternalState: public State{
 		//!  \brief Used to store the current results of the activation
 		//!         function for all neurons for the last batch of patterns \f$x\f$.
@@ -83,9 +101,16 @@ class FFNet :public AbstractModel<RealVector,RealVector>
 		//!     <li>\f$z_i = y_{i-M+n} = g_{output}(x),\ \mbox{for\ } M - n \leq
 		//!                  i < M\f$</li>
 		//! </ul>
-		RealMatrix responses;
+		MatrixType responses;
+		
+		//! \brief Workspace for the backpropagated errors of all neurons.
+		//!
+		//! It is kept with the state so that repeated derivative computations
+		//! for batches of the same size do not allocate memory.
+		mutable MatrixType delta;
 		
 		void resize(std::size_t neurons, std::size_t patterns){
+			//resize does not reallocate if the size does not grow
 			responses.resize(neurons,patterns);
 		}
 	};
@@ -98,8 +123,10 @@ public:
 	//! to define the network topology.
 	FFNet()
 	:m_numberOfNeurons(0),m_inputNeurons(0),m_outputNeurons(0){
-		m_features|=HAS_FIRST_PARAMETER_DERIVATIVE;
-		m_features|=HAS_FIRST_INPUT_DERIVATIVE;
+		this->m_features|=base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		this->m_features|=base_type::HAS_FIRST_INPUT_DERIVATIVE;
+		if(NeuronsHaveSecondDerivative::value)
+			this->m_features|=base_type::HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
 	}
 
 	//! \brief From INameable: return the class name.
@@ -124,16 +151,16 @@ public:
 	}
 
 	//! \brief Returns the matrices for every layer used by eval.
-	std::vector<RealMatrix> const& layerMatrices()const{
+	std::vector<MatrixType> const& layerMatrices()const{
 		return m_layerMatrix;
 	}
 	
 	//! \brief Returns the weight matrix of the i-th layer.
-	RealMatrix const& layerMatrix(std::size_t layer)const{
+	MatrixType const& layerMatrix(std::size_t layer)const{
 		return m_layerMatrix[layer];
 	}
 	
-	void setLayer(std::size_t layerNumber, RealMatrix const& m, RealVector const& bias){
+	void setLayer(std::size_t layerNumber, MatrixType const& m, VectorType const& bias){
 		SIZE_CHECK(m.size1() == bias.size());
 		SIZE_CHECK(m.size1() == m_layerMatrix[layerNumber].size1());
 		SIZE_CHECK(m.size2() == m_layerMatrix[layerNumber].size2());
@@ -148,14 +175,14 @@ public:
 	}
 
 	//! \brief Returns the matrices for every layer used by backpropagation.
-	std::vector<RealMatrix> const& backpropMatrices()const{
+	std::vector<MatrixType> const& backpropMatrices()const{
 		return m_backpropMatrix;
 	}
 	
 	//! \brief Returns the direct shortcuts between input and output neurons.
 	//!
 	//! This does not necessarily exist.
-	RealMatrix const& inputOutputShortcut() const{
+	MatrixType const& inputOutputShortcut() const{
 		return m_inputOutputShortcut;
 	}
 	
@@ -182,12 +209,12 @@ public:
 	//! This is either empty or a vector of size numberOfNeurons()-inputSize().
 	//! the first entry is the value of the first hidden unit while the last outputSize() units
 	//! are the values of the output units.
-	const RealVector& bias()const{
+	const VectorType& bias()const{
 		return m_bias;
 	}
 	
 	///\brief Returns the portion of the bias vector of the i-th layer.
-	RealVector bias(std::size_t layer)const{
+	VectorType bias(std::size_t layer)const{
 		std::size_t start = 0;
 		for(std::size_t i = 0; i != layer; ++i){
 			start +=layerMatrices()[i].size1();
@@ -255,7 +282,7 @@ public:
 	//!
 	//!     \param  state last result of eval
 	//!     \return Output value of the neurons.
-	RealMatrix const& neuronResponses(State const& state)const{
+	MatrixType const& neuronResponses(State const& state)const{
 		InternalState const& s = state.toState<InternalState>();
 		return s.responses;
 	}
@@ -268,7 +295,7 @@ public:
 	///
 	/// this is useful if only a portion of the network needs to be evaluated
 	/// be aware that this only works without shortcuts in the network
-	void evalLayer(std::size_t layer,RealMatrix const& patterns,RealMatrix& outputs)const{
+	void evalLayer(std::size_t layer,MatrixType const& patterns,MatrixType& outputs)const{
 		std::size_t numPatterns = patterns.size1();
 		std::size_t numOutputs = m_layerMatrix[layer].size1();
 		outputs.resize(numPatterns,numOutputs);
@@ -293,26 +320,25 @@ public:
 	///
 	/// this is useful if only a portion of the network needs to be evaluated
 	/// be aware that this only works without shortcuts in the network
-	Data<RealVector> evalLayer(std::size_t layer, Data<RealVector> const& patterns)const{
+	Data<VectorType> evalLayer(std::size_t layer, Data<VectorType> const& patterns)const{
 		int batches = (int) patterns.numberOfBatches();
-		Data<RealVector> result(batches);
+		Data<VectorType> result(batches);
 		SHARK_PARALLEL_FOR(int i = 0; i < batches; ++i){
 			evalLayer(layer,patterns.batch(i),result.batch(i));
 		}
 		return result;
 	}
 	
-	void eval(RealMatrix const& patterns,RealMatrix& output, State& state)const{
+	void eval(MatrixType const& patterns,MatrixType& output, State& state)const{
 		InternalState& s = state.toState<InternalState>();
 		std::size_t numPatterns = patterns.size1();
 		//initialize the input layer using the patterns.
 		s.resize(numberOfNeurons(),numPatterns);
-		s.responses.clear();
 		noalias(rows(s.responses,0,m_inputNeurons)) = trans(patterns);
 		std::size_t beginNeuron = m_inputNeurons;
 		
 		for(std::size_t layer = 0; layer != m_layerMatrix.size();++layer){
-			RealMatrix const& weights = m_layerMatrix[layer];
+			MatrixType const& weights = m_layerMatrix[layer];
 			//number of rows of the layer is also the number of neurons
 			std::size_t endNeuron = beginNeuron + weights.size1();
 			//some subranges of vectors
@@ -321,26 +347,20 @@ public:
 			//the neurons responses
 			auto responses = rows(s.responses,beginNeuron,endNeuron);
 
-			//calculate activation. first compute the linear part and the optional bias and then apply
-			// the non-linearity
+			//calculate activation. first compute the linear part and then add the optional bias
+			//and apply the non-linearity in a single pass.
+			//the bias of the layer is shifted as input units can not have bias.
 			noalias(responses) = prod(weights,input);
-			if(!bias().empty()){
-				//the bias of the layer is shifted as input units can not have bias.
-				auto bias = subrange(m_bias,beginNeuron-inputSize(),endNeuron-inputSize());
-				noalias(responses) += trans(repeat(bias,numPatterns));
+			// if this is the last layer, use output neuron response instead
+			if(layer < m_layerMatrix.size()-1) {
+				activateLayer(responses,beginNeuron-inputSize(),m_hiddenNeuron);
 			}
-			SHARK_CRITICAL_REGION{//beware Dropout Neurons!
-				// if this is the last layer, use output neuron response instead
-				if(layer < m_layerMatrix.size()-1) {
-					noalias(responses) = m_hiddenNeuron(responses);
-				}
-				else {
-					//add shortcuts if necessary
-					if(m_inputOutputShortcut.size1() != 0){
-						noalias(responses) += prod(m_inputOutputShortcut,trans(patterns));
-					}
-					noalias(responses) = m_outputNeuron(responses);
+			else {
+				//add shortcuts if necessary
+				if(m_inputOutputShortcut.size1() != 0){
+					noalias(responses) += prod(m_inputOutputShortcut,trans(patterns));
 				}
+				activateLayer(responses,beginNeuron-inputSize(),m_outputNeuron);
 			}
 			//go to the next layer
 			beginNeuron = endNeuron;
@@ -352,20 +372,17 @@ public:
 		output.resize(numPatterns,m_outputNeurons);
 		noalias(output) = trans(rows(s.responses,m_numberOfNeurons-outputSize(),m_numberOfNeurons));
 	}
-	using AbstractModel<RealVector,RealVector>::eval;
+	using base_type::eval;
 
 	void weightedParameterDerivative(
-		BatchInputType const& patterns, RealMatrix const& coefficients, State const& state, RealVector& gradient
+		BatchInputType const& patterns, MatrixType const& coefficients, State const& state, RealVector& gradient
 	)const{
 		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
 		SIZE_CHECK(coefficients.size1() == patterns.size1());
-		std::size_t numPatterns=patterns.size1();
 		
 		//initialize delta using coefficients and clear the rest. also don't compute the delta for
 		// the input neurons as they are not needed.
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
+		MatrixType& delta = initDelta(coefficients,state);
 
 		computeDelta(delta,state,false);
 		computeParameterDerivative(delta,state,gradient);
@@ -373,7 +390,7 @@ public:
 	}
 	
 	void weightedInputDerivative(
-		BatchInputType const& patterns, RealMatrix const& coefficients, State const& state, BatchInputType& inputDerivative
+		BatchInputType const& patterns, MatrixType const& coefficients, State const& state, BatchInputType& inputDerivative
 	)const{
 		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
 		SIZE_CHECK(coefficients.size1() == patterns.size1());
@@ -381,9 +398,7 @@ public:
 		
 		//initialize delta using coefficients and clear the rest
 		//we compute the full set of delta values here. the delta values of the inputs are the inputDerivative
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
+		MatrixType& delta = initDelta(coefficients,state);
 
 		computeDelta(delta,state,true);
 		inputDerivative.resize(numPatterns,inputSize());
@@ -403,9 +418,7 @@ public:
 		
 		
 		//compute full delta and thus the input derivative
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
+		MatrixType& delta = initDelta(coefficients,state);
 		
 		computeDelta(delta,state,true);
 		inputDerivative.resize(numPatterns,inputSize());
@@ -415,13 +428,49 @@ public:
 		computeParameterDerivative(delta,state,parameterDerivative);
 	}
 	
+	//! \brief Calculates the derivative of the outputs in the direction of the parameters.
+	//!
+	//! This is the forward pass of the R-operator of Pearlmutter (1994): the derivatives of the
+	//! activations of all neurons in the direction are propagated alongside the responses stored by eval.
+	void parameterDirectionalDerivative(
+		BatchInputType const& patterns, RealVector const& direction, State const& state, BatchOutputType& derivative
+	)const{
+		SIZE_CHECK(direction.size() == numberOfParameters());
+		SIZE_CHECK(patterns.size1() == neuronResponses(state).size2());
+		MatrixType activationDerivative;
+		MatrixType responseDerivative;
+		computeDirectionalResponses(unpackDirection(direction), state, activationDerivative, responseDerivative);
+		derivative.resize(patterns.size1(),outputSize());
+		noalias(derivative) = trans(rows(responseDerivative,numberOfNeurons()-outputSize(),numberOfNeurons()));
+	}
+
+	//! \brief Calculates the product of the Hessian of the weighted outputs with a direction.
+	//!
+	//! This is the backward pass of the R-operator of Pearlmutter (1994). The backpropagation
+	//! of the coefficients is differentiated in the direction, which requires the directional derivatives
+	//! of the forward pass and the second derivative of the neurons. The cost is about two gradient evaluations
+	//! and no matrix of the size of the number of parameters is formed.
+	//! It is only available if both neuron types provide functionSecondDerivative().
+	void weightedParameterHessianVectorProduct(
+		BatchInputType const& patterns,
+		MatrixType const& coefficients,
+		MatrixType const& coefficientDerivative,
+		RealVector const& direction,
+		State const& state,
+		RealVector& result
+	)const{
+		weightedParameterHessianVectorProduct(
+			patterns, coefficients, coefficientDerivative, direction, state, result, NeuronsHaveSecondDerivative()
+		);
+	}
+	
 	//! \brief Calculates the derivative for the special case, when error terms for all neurons of the network exist.
 	//!
 	//! This is useful when the hidden neurons need to meet additional requirements.
 	//! The value of delta is changed during computation and holds the results of the backpropagation steps.
 	//! The format is such that the rows of delta are the neurons and the columns the patterns.
 	void weightedParameterDerivativeFullDelta(
-		RealMatrix const& patterns, RealMatrix& delta, State const& state, RealVector& gradient
+		MatrixType const& patterns, MatrixType& delta, State const& state, RealVector& gradient
 	)const{
 		InternalState const& s = state.toState<InternalState>();
 		SIZE_CHECK(delta.size1() == m_numberOfNeurons);
@@ -593,8 +642,127 @@ public:
 
 private:
 	
+	//! \brief Hessian-vector product for neurons providing functionSecondDerivative().
+	void weightedParameterHessianVectorProduct(
+		BatchInputType const& patterns,
+		MatrixType const& coefficients,
+		MatrixType const& coefficientDerivative,
+		RealVector const& direction,
+		State const& state,
+		RealVector& result,
+		std::true_type
+	)const{
+		SIZE_CHECK(direction.size() == numberOfParameters());
+		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
+		SIZE_CHECK(coefficients.size1() == patterns.size1());
+		SIZE_CHECK(coefficientDerivative.size2() == m_outputNeurons);
+		SIZE_CHECK(coefficientDerivative.size1() == patterns.size1());
+		InternalState const& s = state.toState<InternalState>();
+		Direction dir = unpackDirection(direction);
+		MatrixType activationDerivative;
+		MatrixType responseDerivative;
+		computeDirectionalResponses(dir, state, activationDerivative, responseDerivative);
+		
+		//backpropagate delta and its directional derivative together.
+		//Before the layer is processed, the rows of a layer hold the error propagated from the later layers
+		std::size_t numPatterns = patterns.size1();
+		MatrixType& delta = initDelta(coefficients,state);
+		MatrixType deltaDerivative(numberOfNeurons(),numPatterns,0.0);
+		noalias(rows(deltaDerivative,numberOfNeurons()-outputSize(),numberOfNeurons())) = trans(coefficientDerivative);
+		std::size_t endNeuron = numberOfNeurons();
+		for(std::size_t layer = m_layerMatrix.size(); layer != 0; --layer){
+			MatrixType const& weights = m_layerMatrix[layer-1];
+			MatrixType const& directionWeights = dir.layers[layer-1];
+			std::size_t beginNeuron = endNeuron - weights.size1();
+			auto layerDelta = rows(delta,beginNeuron,endNeuron);
+			auto layerDeltaDerivative = rows(deltaDerivative,beginNeuron,endNeuron);
+			auto layerResponse = rows(s.responses,beginNeuron,endNeuron);
+			auto layerActivationDerivative = rows(activationDerivative,beginNeuron,endNeuron);
+			if(layer == m_layerMatrix.size())
+				applyDeltaDerivatives(layerDelta, layerDeltaDerivative, layerResponse, layerActivationDerivative, m_outputNeuron);
+			else
+				applyDeltaDerivatives(layerDelta, layerDeltaDerivative, layerResponse, layerActivationDerivative, m_hiddenNeuron);
+			
+			//propagate to the inputs of the layer. input neurons don't need error values
+			std::size_t inputBegin = std::max(beginNeuron - weights.size2(),inputSize());
+			if(inputBegin < beginNeuron){
+				std::size_t weightBegin = inputBegin - (beginNeuron - weights.size2());
+				auto inputDelta = rows(delta,inputBegin,beginNeuron);
+				auto inputDeltaDerivative = rows(deltaDerivative,inputBegin,beginNeuron);
+				noalias(inputDelta) += prod(trans(columns(weights,weightBegin,weights.size2())),layerDelta);
+				noalias(inputDeltaDerivative) += prod(trans(columns(weights,weightBegin,weights.size2())),layerDeltaDerivative);
+				noalias(inputDeltaDerivative) += prod(trans(columns(directionWeights,weightBegin,weights.size2())),layerDelta);
+			}
+			endNeuron = beginNeuron;
+		}
+		
+		//the derivative of delta gives the gradient with respect to the responses of the inputs
+		//which are completed by the derivative of the responses with respect to the direction.
+		//the bias and the shortcut have constant inputs, so this term vanishes for them.
+		computeParameterDerivative(deltaDerivative,state,result);
+		std::size_t pos = 0;
+		std::size_t layerStart = inputSize();
+		for(std::size_t layer = 0; layer != m_layerMatrix.size(); ++layer){
+			std::size_t layerRows = m_layerMatrix[layer].size1();
+			std::size_t layerColumns = m_layerMatrix[layer].size2();
+			std::size_t params = layerRows*layerColumns;
+			//the inputs of the first layer do not depend on the parameters
+			if(layer != 0){
+				auto gradMatrix  = to_matrix(subrange(result,pos,pos+params),layerRows,layerColumns);
+				auto deltaLayer = rows(delta,layerStart,layerStart+layerRows);
+				auto inputDerivative = rows(responseDerivative,layerStart-layerColumns,layerStart);
+				addProduct(gradMatrix, deltaLayer, trans(inputDerivative));
+			}
+			pos += params;
+			layerStart += layerRows;
+		}
+	}
+	
+	//! \brief The neurons can not compute the second derivative, thus the Hessian-vector product is not available.
+	void weightedParameterHessianVectorProduct(
+		BatchInputType const&, MatrixType const&, MatrixType const&,
+		RealVector const&, State const&, RealVector&,
+		std::false_type
+	)const{
+		SHARK_FEATURE_EXCEPTION_DERIVED(HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT);
+	}
+	
+	//! \brief Adds the bias to the linear responses of a layer and applies the activation function.
+	//!
+	//! Both are done row by row right after the matrix product, while the row is in cache.
+	//! The activation is evaluated by the neuron on the whole row which allows vectorized kernels.
+	//! Neurons which are not threadsafe, e.g. DropoutNeuron, are evaluated in a critical region.
+	template<class Responses, class Neuron>
+	void activateLayer(Responses& responses, std::size_t biasStart, Neuron const& neuron)const{
+		auto apply = [&](){
+			for(std::size_t i = 0; i != responses.size1(); ++i){
+				auto neuronResponses = row(responses,i);
+				if(!m_bias.empty())
+					neuronResponses += m_bias(biasStart + i);
+				noalias(neuronResponses) = neuron(neuronResponses);
+			}
+		};
+		if(IsThreadsafeNeuron<Neuron>::value){
+			apply();
+		}else{
+			SHARK_CRITICAL_REGION{
+				apply();
+			}
+		}
+	}
+	
+	//! \brief Returns the delta workspace of the state with the output deltas set to the coefficients and all other deltas cleared.
+	MatrixType& initDelta(MatrixType const& coefficients, State const& state)const{
+		InternalState const& s = state.toState<InternalState>();
+		std::size_t numPatterns = coefficients.size1();
+		s.delta.resize(numberOfNeurons(),numPatterns);
+		rows(s.delta,0,numberOfNeurons()-outputSize()).clear();
+		noalias(rows(s.delta,numberOfNeurons()-outputSize(),numberOfNeurons())) = trans(coefficients);
+		return s.delta;
+	}
+	
 	void computeDelta(
-		RealMatrix& delta, State const& state, bool computeInputDelta
+		MatrixType& delta, State const& state, bool computeInputDelta
 	)const{
 		SIZE_CHECK(delta.size1() == numberOfNeurons());
 		InternalState const& s = state.toState<InternalState>();
@@ -614,7 +782,7 @@ private:
 		std::size_t endIndex = computeInputDelta? 0: inputSize();
 		while(endNeuron > endIndex){
 			
-			RealMatrix const& weights = m_backpropMatrix[layer];
+			MatrixType const& weights = m_backpropMatrix[layer];
 			std::size_t beginNeuron = endNeuron - weights.size1();//first neuron of the current layer
 			//get the delta and response values of this layer
 			auto layerDelta = rows(delta,beginNeuron,endNeuron);
@@ -635,7 +803,119 @@ private:
 			noalias(rows(delta,0,inputSize())) += prod(trans(inputOutputShortcut()),outputDelta);
 	}
 	
-	void computeParameterDerivative(RealMatrix const& delta, State const& state, RealVector& gradient)const{
+	//! \brief Computes the product of two matrices of the network and stores it in a part of the double precision gradient.
+	//!
+	//! For single precision networks, the product is computed in single precision and converted afterwards.
+	template<class Result, class MatA, class MatB>
+	void assignProduct(Result& result, MatA const& A, MatB const& B)const{
+		assignProduct(result, A, B, std::is_same<value_type, double>());
+	}
+	template<class Result, class MatA, class MatB>
+	void assignProduct(Result& result, MatA const& A, MatB const& B, std::true_type)const{
+		noalias(result) = prod(A, B);
+	}
+	template<class Result, class MatA, class MatB>
+	void assignProduct(Result& result, MatA const& A, MatB const& B, std::false_type)const{
+		MatrixType product = prod(A, B);
+		noalias(result) = product;
+	}
+
+	//! \brief Adds the product of two matrices of the network to a part of the double precision gradient.
+	template<class Result, class MatA, class MatB>
+	void addProduct(Result& result, MatA const& A, MatB const& B)const{
+		addProduct(result, A, B, std::is_same<value_type, double>());
+	}
+	template<class Result, class MatA, class MatB>
+	void addProduct(Result& result, MatA const& A, MatB const& B, std::true_type)const{
+		noalias(result) += prod(A, B);
+	}
+	template<class Result, class MatA, class MatB>
+	void addProduct(Result& result, MatA const& A, MatB const& B, std::false_type)const{
+		MatrixType product = prod(A, B);
+		noalias(result) += product;
+	}
+	
+	//! \brief A direction in parameter space in the same layout as the weights of the network.
+	struct Direction{
+		std::vector<MatrixType> layers;
+		VectorType bias;
+		MatrixType inputOutputShortcut;
+	};
+	
+	Direction unpackDirection(RealVector const& direction)const{
+		Direction dir;
+		dir.layers.resize(m_layerMatrix.size());
+		for(std::size_t i = 0; i != m_layerMatrix.size(); ++i){
+			dir.layers[i].resize(m_layerMatrix[i].size1(),m_layerMatrix[i].size2());
+		}
+		dir.bias.resize(m_bias.size());
+		dir.inputOutputShortcut.resize(m_inputOutputShortcut.size1(),m_inputOutputShortcut.size2());
+		init(direction) >> matrixSet(dir.layers),dir.bias,toVector(dir.inputOutputShortcut);
+		return dir;
+	}
+	
+	//! \brief Computes the derivatives of the linear activations and the responses of all neurons in a direction.
+	//!
+	//! The rows of the input neurons are zero, as the inputs do not depend on the parameters.
+	void computeDirectionalResponses(
+		Direction const& dir, State const& state,
+		MatrixType& activationDerivative, MatrixType& responseDerivative
+	)const{
+		InternalState const& s = state.toState<InternalState>();
+		std::size_t numPatterns = s.responses.size2();
+		activationDerivative.resize(numberOfNeurons(),numPatterns);
+		responseDerivative.resize(numberOfNeurons(),numPatterns);
+		rows(activationDerivative,0,inputSize()).clear();
+		rows(responseDerivative,0,inputSize()).clear();
+		std::size_t beginNeuron = inputSize();
+		for(std::size_t layer = 0; layer != m_layerMatrix.size();++layer){
+			MatrixType const& weights = m_layerMatrix[layer];
+			std::size_t endNeuron = beginNeuron + weights.size1();
+			std::size_t inputBegin = beginNeuron - weights.size2();
+			auto input = rows(s.responses,inputBegin,beginNeuron);
+			auto layerActivation = rows(activationDerivative,beginNeuron,endNeuron);
+			
+			//the activation is linear in the weights and the inputs.
+			//the responses of the input neurons do not depend on the parameters, so their columns are skipped
+			noalias(layerActivation) = prod(dir.layers[layer],input);
+			std::size_t dependentBegin = std::max(inputBegin,inputSize());
+			if(dependentBegin < beginNeuron){
+				auto dependentWeights = columns(weights,dependentBegin - inputBegin,weights.size2());
+				noalias(layerActivation) += prod(dependentWeights,rows(responseDerivative,dependentBegin,beginNeuron));
+			}
+			if(!m_bias.empty()){
+				for(std::size_t i = 0; i != weights.size1(); ++i){
+					row(layerActivation,i) += dir.bias(beginNeuron - inputSize() + i);
+				}
+			}
+			auto layerResponse = rows(s.responses,beginNeuron,endNeuron);
+			auto layerResponseDerivative = rows(responseDerivative,beginNeuron,endNeuron);
+			if(layer < m_layerMatrix.size()-1) {
+				noalias(layerResponseDerivative) = m_hiddenNeuron.derivative(layerResponse) * layerActivation;
+			}
+			else {
+				if(m_inputOutputShortcut.size1() != 0){
+					noalias(layerActivation) += prod(dir.inputOutputShortcut,rows(s.responses,0,inputSize()));
+				}
+				noalias(layerResponseDerivative) = m_outputNeuron.derivative(layerResponse) * layerActivation;
+			}
+			beginNeuron = endNeuron;
+		}
+	}
+	
+	//! \brief Multiplies the propagated errors of a layer with the derivative of the neurons and computes the directional derivative of the result.
+	template<class Delta, class DeltaDerivative, class Response, class ActivationDerivative, class Neuron>
+	void applyDeltaDerivatives(
+		Delta& delta, DeltaDerivative& deltaDerivative,
+		Response const& responses, ActivationDerivative const& activationDerivative,
+		Neuron const& neuron
+	)const{
+		noalias(deltaDerivative) *= neuron.derivative(responses);
+		noalias(deltaDerivative) += neuron.secondDerivative(responses) * activationDerivative * delta;
+		noalias(delta) *= neuron.derivative(responses);
+	}
+
+	void computeParameterDerivative(MatrixType const& delta, State const& state, RealVector& gradient)const{
 		SIZE_CHECK(delta.size1() == numberOfNeurons());
 		InternalState const& s = state.toState<InternalState>();
 		// calculate error gradient
@@ -651,7 +931,7 @@ private:
 			auto gradMatrix  = to_matrix(subrange(gradient,pos,pos+params),layerRows,layerColumns);
 			auto deltaLayer = rows(delta,layerStart,layerStart+layerRows);
 			auto inputLayer = rows(s.responses,layerStart-layerColumns,layerStart);
-			noalias(gradMatrix) = prod(deltaLayer, trans(inputLayer));
+			assignProduct(gradMatrix, deltaLayer, trans(inputLayer));
 			
 			pos += params;
 			layerStart += layerRows;
@@ -670,7 +950,7 @@ private:
 			auto gradMatrix  = to_matrix(subrange(gradient,pos,pos+params),outputSize(),inputSize());
 			auto deltaLayer = rows(delta,delta.size1()-outputSize(),delta.size1());
 			auto inputLayer = rows(s.responses,0,inputSize());
-			noalias(gradMatrix) = prod(deltaLayer, trans(inputLayer));
+			assignProduct(gradMatrix, deltaLayer, trans(inputLayer));
 		}
 		
 	}
@@ -691,21 +971,21 @@ private:
 	//! that C(i,k) = 1 or C(k,j) = 1 or C(j,i) = 1 than the neurons i,j are not in the same layer.
 	//! This is the forward view, meaning that the layers holds the weights which are used to calculate
 	//! the activation of the neurons of the layer.
-	std::vector<RealMatrix> m_layerMatrix;
+	std::vector<MatrixType> m_layerMatrix;
 	
 	//! \brief optional matrix directly connecting input to output
 	//!
 	//! This is only filled when the network has an input-output shortcut but not a full layer connection.
-	RealMatrix m_inputOutputShortcut;
+	MatrixType m_inputOutputShortcut;
 	
 	//!\brief represents the backwards view of the network as layered structure.
 	//!
 	//! This is the backward view of the Network which is used for the backpropagation step. So every
 	//! Matrix contains the weights of the neurons which are activated by the layer.
-	std::vector<RealMatrix> m_backpropMatrix;
+	std::vector<MatrixType> m_backpropMatrix;
 
 	//! bias weights of the neurons
-	RealVector m_bias;
+	VectorType m_bias;
 
 	//!Type of hidden neuron. See Models/Neurons.h for a few choices
 	HiddenNeuron m_hiddenNeuron;
@@ -43,8 +43,11 @@
 
 #include <shark/Models/Converter.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
+#include <algorithm>
+#include <functional>
 
 namespace shark {
 
@@ -190,6 +193,60 @@ public:
 		swap(m_alpha,a);
 	}
 
+	/// \brief Replaces the basis by a subset of the given size (reduced set compression).
+	///
+	/// The basis vectors with the largest coefficients (in 2-norm over the outputs) are kept.
+	/// The new coefficients \f$ \beta \f$ are given by the orthogonal projection of the expansion onto
+	/// the span of the kept vectors in the feature space,
+	/// \f[ K_{zz} \beta = K_{zx} \alpha \f]
+	/// which minimizes the distance of the old and new expansion in the kernel induced Hilbert space.
+	/// This takes O(s n) kernel evaluations and O(s^3) time for s kept vectors and n basis vectors.
+	/// The offset is not changed. Nothing happens if the basis is not larger than size.
+	void reduceBasis(std::size_t size){
+		SHARK_RUNTIME_CHECK(size > 0, "[KernelExpansion::reduceBasis] size must be positive");
+		SHARK_ASSERT(mep_kernel != NULL);
+		std::size_t ic = m_basis.numberOfElements();
+		if(size >= ic) return;
+
+		//select the vectors with largest coefficients
+		std::vector<std::pair<double,std::size_t> > weights(ic);
+		for (std::size_t i=0; i != ic; ++i){
+			weights[i] = std::make_pair(norm_2(row(m_alpha, i)),i);
+		}
+		std::partial_sort(weights.begin(),weights.begin()+size,weights.end(),std::greater<std::pair<double,std::size_t> >());
+		std::vector<std::size_t> indices(size);
+		for (std::size_t i=0; i != size; ++i){
+			indices[i] = weights[i].second;
+		}
+		std::sort(indices.begin(),indices.end());
+		Data<InputType> reduced = toDataset(subset(toView(m_basis),indices));
+
+		//right hand side K_zx alpha computed blockwise
+		RealMatrix rhs(size, outputSize(),0.0);
+		std::size_t reducedStart = 0;
+		for (std::size_t r=0; r != reduced.numberOfBatches(); r++){
+			std::size_t reducedEnd = reducedStart+batchSize(reduced.batch(r));
+			auto rhsBlock = rows(rhs,reducedStart,reducedEnd);
+			std::size_t batchStart = 0;
+			for (std::size_t i=0; i != m_basis.numberOfBatches(); i++){
+				std::size_t batchEnd = batchStart+batchSize(m_basis.batch(i));
+				RealMatrix kernelEvaluations = (*mep_kernel)(reduced.batch(r),m_basis.batch(i));
+				noalias(rhsBlock) += prod(kernelEvaluations,rows(m_alpha,batchStart,batchEnd));
+				batchStart = batchEnd;
+			}
+			reducedStart = reducedEnd;
+		}
+
+		//project; a small ridge guards against (nearly) identical basis vectors
+		RealMatrix K = calculateRegularizedKernelMatrix(*mep_kernel,reduced);
+		double ridge = 1.e-10 * std::max(trace(K)/size,1.e-300);
+		for (std::size_t i=0; i != size; ++i){
+			K(i,i) += ridge;
+		}
+		m_alpha = solve(K,rhs,blas::symm_pos_def(),blas::left());
+		m_basis = reduced;
+	}
+
 	// //////////////////////////////////////////////////////////
 	// ////////    ALL THINGS KERNEL PARAMETERS    //////////////
 	// //////////////////////////////////////////////////////////
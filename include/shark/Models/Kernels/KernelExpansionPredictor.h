@@ -0,0 +1,173 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Fast prediction with kernel expansions of dense vectors
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_KERNELS_KERNELEXPANSIONPREDICTOR_H
+#define SHARK_MODELS_KERNELS_KERNELEXPANSIONPREDICTOR_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Models/Kernels/KernelExpansion.h>
+
+namespace shark {
+
+///
+/// \brief Prediction-time version of a KernelExpansion on dense vectors.
+///
+/// A trained KernelExpansion evaluates its kernel through the generic kernel interface,
+/// batch by batch of the basis. This model is created from such an expansion when its
+/// kernel is a GaussianRbfKernel, PolynomialKernel or LinearKernel on RealVector and is
+/// meant for serving predictions. It stores the basis as a single matrix together with
+/// the precomputed squared norms of the basis vectors. The kernel values of a batch of
+/// patterns are then obtained from one inner product matrix, computed by a matrix-matrix product,
+/// followed by the elementwise kernel function, e.g.
+/// \f[ k(x,z) = \exp(-\gamma (\|x\|^2 + \|z\|^2 - 2 \langle x,z \rangle)) \f]
+///
+/// The basis is processed in tiles of a fixed number of vectors so that
+/// the kernel values of a tile stay in cache before they are multiplied with the coefficients.
+/// Large batches of patterns are split into blocks of rows which are processed in parallel.
+/// Small batches, e.g. single predictions, are instead parallelized over the tiles of the basis
+/// to reduce latency. The results do not depend on the number of threads.
+///
+/// Models with many basis vectors can be compressed with KernelExpansion::reduceBasis before
+/// they are converted.
+///
+/// The model has no trainable parameters, changes to the original expansion are not reflected.
+///
+class KernelExpansionPredictor : public AbstractModel<RealVector,RealVector>
+{
+public:
+	enum KernelFunction{
+		GAUSSIAN,
+		POLYNOMIAL,
+		LINEAR
+	};
+
+	/// Constructor of an empty model; use setExpansion later
+	KernelExpansionPredictor()
+	: m_kernelFunction(LINEAR), m_gamma(0), m_degree(1), m_kernelOffset(0), m_tileSize(512){}
+
+	/// \brief Creates the predictor for the given expansion.
+	KernelExpansionPredictor(KernelExpansion<RealVector> const& expansion)
+	: m_kernelFunction(LINEAR), m_gamma(0), m_degree(1), m_kernelOffset(0), m_tileSize(512){
+		setExpansion(expansion);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "KernelExpansionPredictor"; }
+
+	/// \brief Copies basis, coefficients, offset and kernel parameters from the expansion.
+	///
+	/// Throws an exception if the kernel is not supported.
+	SHARK_EXPORT_SYMBOL void setExpansion(KernelExpansion<RealVector> const& expansion);
+
+	/// \brief Number of basis vectors processed together.
+	std::size_t tileSize()const{
+		return m_tileSize;
+	}
+	void setTileSize(std::size_t size){
+		SHARK_RUNTIME_CHECK(size > 0, "[KernelExpansionPredictor::setTileSize] tile size must be positive");
+		m_tileSize = size;
+	}
+
+	KernelFunction kernelFunction()const{
+		return m_kernelFunction;
+	}
+
+	/// \brief Basis vectors, one per row.
+	RealMatrix const& basis()const{
+		return m_basis;
+	}
+	RealMatrix const& alpha()const{
+		return m_alpha;
+	}
+	bool hasOffset()const{
+		return m_offset.size() != 0;
+	}
+	RealVector const& offset()const{
+		return m_offset;
+	}
+
+	std::size_t inputSize()const{
+		return m_basis.size2();
+	}
+	std::size_t outputSize()const{
+		return m_alpha.size2();
+	}
+
+	RealVector parameterVector()const{
+		return RealVector();
+	}
+
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+
+	std::size_t numberOfParameters()const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	using AbstractModel<RealVector,RealVector>::eval;
+	SHARK_EXPORT_SYMBOL void eval(BatchInputType const& patterns, BatchOutputType& outputs)const;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns,outputs);
+	}
+
+	SHARK_EXPORT_SYMBOL void read( InArchive & archive );
+	SHARK_EXPORT_SYMBOL void write( OutArchive & archive ) const;
+private:
+	/// computes the kernel values of the given patterns and a tile of the basis
+	void evalTile(
+		RealMatrix const& patterns, RealVector const& patternNorms,
+		std::size_t rowStart, std::size_t rowEnd,
+		std::size_t tileStart, std::size_t tileEnd,
+		RealMatrix& kernelValues
+	)const;
+
+	RealMatrix m_basis;        ///< basis vectors stored as rows
+	RealVector m_basisNorms;   ///< squared norms of the basis vectors
+	RealMatrix m_alpha;        ///< coefficients
+	RealVector m_offset;       ///< offset, empty if not used
+	KernelFunction m_kernelFunction;
+	double m_gamma;            ///< bandwidth of the Gaussian kernel
+	unsigned int m_degree;     ///< degree of the polynomial kernel
+	double m_kernelOffset;     ///< offset of the polynomial kernel
+	std::size_t m_tileSize;
+};
+
+}
+#endif
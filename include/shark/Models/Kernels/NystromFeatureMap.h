@@ -0,0 +1,188 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Nystroem feature map approximating a kernel by a set of landmarks
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_KERNELS_NYSTROMFEATUREMAP_H
+#define SHARK_MODELS_KERNELS_NYSTROMFEATUREMAP_H
+
+#include <shark/Models/AbstractModel.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/Data/Dataset.h>
+
+namespace shark {
+
+///
+/// \brief Explicit feature map approximating a kernel by its restriction to a set of landmarks.
+///
+/// Given landmarks \f$ z_1,\dots,z_m \f$ with kernel matrix \f$ K_{mm} = U \Lambda U^T \f$, the
+/// Nystroem approximation of the kernel is \f$ k(x,x') \approx k_m(x)^T K_{mm}^{+} k_m(x') \f$ where
+/// \f$ k_m(x) = (k(z_1,x),\dots,k(z_m,x))^T \f$. The model computes the corresponding feature map
+/// \f[ \phi(x) = P^T k_m(x), \quad P = U_r \Lambda_r^{-1/2} \f]
+/// where only the r eigenvalues which are not negligible are kept. Thus the output dimension is at most m.
+///
+/// Transform the inputs of a dataset with this model and train a linear model, e.g. with LinearSAGTrainer,
+/// LinearCSvmTrainer or LinearRegression. The model is usually created by the NystromTrainer, which selects the landmarks.
+///
+/// The model has no trainable parameters.
+///
+/// \tparam InputType Type of the landmarks supplied to the kernel
+///
+template<class InputType>
+class NystromFeatureMap : public AbstractModel<InputType, RealVector>
+{
+public:
+	typedef AbstractKernelFunction<InputType> KernelType;
+	typedef AbstractModel<InputType, RealVector> base_type;
+	typedef typename base_type::BatchInputType BatchInputType;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+
+	NystromFeatureMap():mep_kernel(NULL){}
+
+	NystromFeatureMap(KernelType* kernel):mep_kernel(kernel){
+		SHARK_ASSERT(kernel != NULL);
+	}
+
+	NystromFeatureMap(KernelType* kernel, Data<InputType> const& landmarks){
+		setStructure(kernel, landmarks);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "NystromFeatureMap"; }
+
+	/// \brief Sets kernel and landmarks and computes the projection.
+	///
+	/// Eigenvalues of the kernel matrix of the landmarks which are smaller than
+	/// relativeTolerance times the largest eigenvalue are discarded.
+	void setStructure(KernelType* kernel, Data<InputType> const& landmarks, double relativeTolerance = 1.e-10){
+		SHARK_ASSERT(kernel != NULL);
+		SHARK_RUNTIME_CHECK(landmarks.numberOfElements() > 0, "[NystromFeatureMap::setStructure] at least one landmark is needed");
+		mep_kernel = kernel;
+		m_landmarks = landmarks;
+
+		RealMatrix K = calculateRegularizedKernelMatrix(*mep_kernel, m_landmarks, 0.0);
+		blas::symm_eigenvalue_decomposition<RealMatrix> eigen(K);
+		RealVector const& lambda = eigen.D();
+		double threshold = relativeTolerance * std::max(lambda(0),0.0);
+		std::size_t rank = 0;
+		while(rank != lambda.size() && lambda(rank) > threshold)
+			++rank;
+		SHARK_RUNTIME_CHECK(rank > 0, "[NystromFeatureMap::setStructure] kernel matrix of the landmarks is zero");
+
+		m_projection = columns(eigen.Q(),0,rank);
+		for(std::size_t j = 0; j != rank; ++j){
+			column(m_projection,j) /= std::sqrt(lambda(j));
+		}
+	}
+
+	KernelType const* kernel() const{
+		return mep_kernel;
+	}
+	KernelType* kernel(){
+		return mep_kernel;
+	}
+
+	/// \brief Returns the landmarks.
+	Data<InputType> const& landmarks() const {
+		return m_landmarks;
+	}
+
+	/// \brief Returns the matrix P mapping the kernel evaluations of the landmarks to the features.
+	RealMatrix const& projection() const {
+		return m_projection;
+	}
+
+	/// \brief Dimensionality of the feature space.
+	std::size_t outputSize() const{
+		return m_projection.size2();
+	}
+
+	RealVector parameterVector()const{
+		return RealVector();
+	}
+
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+
+	std::size_t numberOfParameters()const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	using base_type::eval;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+		SHARK_ASSERT(mep_kernel != NULL);
+		std::size_t numPatterns = batchSize(patterns);
+		outputs.resize(numPatterns,outputSize());
+		outputs.clear();
+
+		std::size_t batchStart = 0;
+		for (std::size_t i=0; i != m_landmarks.numberOfBatches(); i++){
+			std::size_t batchEnd = batchStart+batchSize(m_landmarks.batch(i));
+			RealMatrix kernelEvaluations = (*mep_kernel)(patterns,m_landmarks.batch(i));
+			noalias(outputs) += prod(kernelEvaluations,rows(m_projection,batchStart,batchEnd));
+			batchStart = batchEnd;
+		}
+	}
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns, outputs);
+	}
+
+	/// From ISerializable, reads a model from an archive
+	void read( InArchive & archive ){
+		SHARK_ASSERT(mep_kernel != NULL);
+		archive >> m_landmarks;
+		archive >> m_projection;
+		archive >> (*mep_kernel);
+	}
+
+	/// From ISerializable, writes a model to an archive
+	void write( OutArchive & archive ) const{
+		SHARK_ASSERT(mep_kernel != NULL);
+		archive << m_landmarks;
+		archive << m_projection;
+		archive << const_cast<KernelType const&>(*mep_kernel);//prevent compilation warning
+	}
+
+private:
+	KernelType* mep_kernel;      ///< kernel function
+	Data<InputType> m_landmarks; ///< landmarks z_1,...,z_m
+	RealMatrix m_projection;     ///< projection P such that phi(x) = P^T k_m(x)
+};
+
+}
+#endif
@@ -100,6 +100,11 @@ public:
 		return m_degree;
 	}
 
+	/// \brief Returns the offset added to the inner product.
+	double offset() const {
+		return m_offset;
+	}
+
 	RealVector parameterVector() const {
 		if ( m_degreeIsParam ) {
 			RealVector ret(2);
@@ -0,0 +1,139 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Random Fourier feature map approximating Gaussian kernels
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_KERNELS_RANDOMFOURIERFEATURES_H
+#define SHARK_MODELS_KERNELS_RANDOMFOURIERFEATURES_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Models/AbstractModel.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/ArdKernel.h>
+
+namespace shark {
+
+///
+/// \brief Explicit feature map approximating a Gaussian kernel by random Fourier features.
+///
+/// By Bochner's theorem, a shift invariant kernel is the Fourier transform of a probability
+/// distribution. For the Gaussian kernel \f$ k(x,z) = \exp(-\sum_i \gamma_i (x_i - z_i)^2) \f$ this
+/// is the normal distribution with variance \f$ 2\gamma_i \f$ along dimension i. The model maps a point to
+///  \f[ \phi(x) = \sqrt{2/D}\left(\cos(\omega_1^T x + b_1), \dots, \cos(\omega_D^T x + b_D)\right) \f]
+/// with frequencies \f$ \omega_j \f$ drawn from this distribution and phases \f$ b_j \f$ uniform in \f$ [0,2\pi] \f$.
+/// Then \f$ \langle \phi(x), \phi(z)\rangle \f$ is an unbiased estimate of \f$ k(x,z) \f$ with variance \f$ O(1/D) \f$
+/// (Rahimi and Recht, 2007).
+///
+/// The feature map turns a kernel method into a linear one. Transform the inputs of a dataset with
+/// this model and train a linear model, e.g. with LinearSAGTrainer, LinearCSvmTrainer or LinearRegression.
+/// Prediction is then the concatenation of both models. Training and prediction take time linear in the number
+/// of points, instead of quadratic or cubic as for the exact kernel methods.
+///
+/// The model has no trainable parameters.
+///
+class RandomFourierFeatures : public AbstractModel<RealVector,RealVector>
+{
+public:
+	/// Constructor of an invalid model; use setStructure later
+	RandomFourierFeatures(){}
+
+	/// \brief Draws numFeatures features for the Gaussian kernel with the given bandwidth per input dimension.
+	RandomFourierFeatures(RealVector const& gammas, std::size_t numFeatures){
+		setStructure(gammas, numFeatures);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "RandomFourierFeatures"; }
+
+	/// \brief Draws numFeatures features for the Gaussian kernel with the given bandwidth per input dimension.
+	SHARK_EXPORT_SYMBOL void setStructure(RealVector const& gammas, std::size_t numFeatures);
+
+	/// \brief Draws numFeatures features approximating a GaussianRbfKernel on inputs of the given dimension.
+	void setStructure(GaussianRbfKernel<RealVector> const& kernel, std::size_t inputDimension, std::size_t numFeatures){
+		setStructure(RealVector(inputDimension, kernel.gamma()), numFeatures);
+	}
+
+	/// \brief Draws numFeatures features approximating an ARD kernel.
+	void setStructure(ARDKernelUnconstrained<RealVector> const& kernel, std::size_t numFeatures){
+		setStructure(kernel.gammaVector(), numFeatures);
+	}
+
+	std::size_t inputSize()const{
+		return m_frequencies.size2();
+	}
+
+	std::size_t outputSize()const{
+		return m_frequencies.size1();
+	}
+
+	/// \brief Returns the frequencies, one per row.
+	RealMatrix const& frequencies()const{
+		return m_frequencies;
+	}
+
+	/// \brief Returns the phase shifts.
+	RealVector const& phases()const{
+		return m_phases;
+	}
+
+	RealVector parameterVector()const{
+		return RealVector();
+	}
+
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+
+	std::size_t numberOfParameters()const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	using AbstractModel<RealVector,RealVector>::eval;
+	SHARK_EXPORT_SYMBOL void eval(BatchInputType const& patterns, BatchOutputType& outputs)const;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns,outputs);
+	}
+
+	SHARK_EXPORT_SYMBOL void read( InArchive & archive );
+	SHARK_EXPORT_SYMBOL void write( OutArchive & archive ) const;
+private:
+	RealMatrix m_frequencies; ///< frequencies omega_j stored as rows
+	RealVector m_phases;      ///< phase shifts b_j
+};
+
+}
+#endif
@@ -49,15 +49,21 @@ namespace shark {
 /// the weight matrix and the ouputs are dense. There are some cases where this is not
 /// good behavior. Check for example Normalizer for a class which is designed for sparse
 /// inputs and outputs.
+///
+/// The weights and outputs have the same value type as the inputs, thus a LinearModel<FloatVector>
+/// computes in single precision. The parameter vector and its derivative are always double precision.
 template <class InputType = RealVector>
-class LinearModel : public AbstractModel<InputType,RealVector>
+class LinearModel : public AbstractModel<InputType,blas::vector<typename InputType::value_type> >
 {
+public:
+	typedef blas::vector<typename InputType::value_type> VectorType;
+	typedef blas::matrix<typename InputType::value_type> MatrixType;
 private:
-	typedef AbstractModel<InputType,RealVector> base_type;
+	typedef AbstractModel<InputType,VectorType> base_type;
 	typedef LinearModel<InputType> self_type;
 	/// Wrapper for the type erasure
-	RealMatrix m_matrix;
-	RealVector m_offset;
+	MatrixType m_matrix;
+	VectorType m_offset;
 public:
 	typedef typename base_type::BatchInputType BatchInputType;
 	typedef typename base_type::BatchOutputType BatchOutputType;
@@ -65,6 +71,7 @@ public:
 	/// CDefault Constructor; use setStructure later
 	LinearModel(){
 		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		base_type::m_features |= base_type::HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
 		if(std::is_same<typename InputType::storage_type::storage_tag, blas::dense_tag>::value){
 			base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
 		}
@@ -73,12 +80,14 @@ public:
 	LinearModel(std::size_t inputs, std::size_t outputs = 1, bool offset = false)
 	: m_matrix(outputs,inputs,0.0),m_offset(offset?outputs:0,0.0){
 		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		base_type::m_features |= base_type::HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
 		base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
 	}
 	///copy constructor
 	LinearModel(LinearModel const& model)
 	:m_matrix(model.m_matrix),m_offset(model.m_offset){
 		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		base_type::m_features |= base_type::HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
 		base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
 	}
 
@@ -100,9 +109,10 @@ public:
 	}
 
 	/// Construction from matrix (and vector)
-	LinearModel(RealMatrix const& matrix, RealVector const& offset = RealVector())
+	LinearModel(MatrixType const& matrix, VectorType const& offset = VectorType())
 	:m_matrix(matrix),m_offset(offset){
 		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		base_type::m_features |= base_type::HAS_PARAMETER_HESSIAN_VECTOR_PRODUCT;
 		base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
 	}
 
@@ -147,25 +157,25 @@ public:
 	}
 
 	/// overwrite structure and parameters
-	void setStructure(RealMatrix const& matrix, RealVector const& offset = RealVector()){
+	void setStructure(MatrixType const& matrix, VectorType const& offset = VectorType()){
 		m_matrix = matrix;
 		m_offset = offset;
 	}
 
 	/// return a copy of the matrix in dense format
-	RealMatrix const& matrix() const{
+	MatrixType const& matrix() const{
 		return m_matrix;
 	}
 
-	RealMatrix& matrix(){
+	MatrixType& matrix(){
 		return m_matrix;
 	}
 
 	/// return the offset
-	RealVector const& offset() const{
+	VectorType const& offset() const{
 		return m_offset;
 	}
-	RealVector& offset(){
+	VectorType& offset(){
 		return m_offset;
 	}
 
@@ -185,7 +195,7 @@ public:
 		}
 	}
 
-	void eval(InputType const& input, RealVector& output)const {
+	void eval(InputType const& input, VectorType& output)const {
 		output.resize(m_matrix.size1());
 		//we multiply with a set of row vectors from the left
 		noalias(output) = m_matrix % input;
@@ -200,7 +210,7 @@ public:
 
 	///\brief Calculates the first derivative w.r.t the parameters and summing them up over all patterns of the last computed batch
 	void weightedParameterDerivative(
-		BatchInputType const& patterns, RealMatrix const& coefficients, State const& state, RealVector& gradient
+		BatchInputType const& patterns, BatchOutputType const& coefficients, State const& state, RealVector& gradient
 	)const{
 		SIZE_CHECK(coefficients.size2()==outputSize());
 		SIZE_CHECK(coefficients.size1()==patterns.size1());
@@ -219,9 +229,36 @@ public:
 			noalias(subrange(gradient, start, start + outputs)) = sum_rows(coefficients);
 		}
 	}
+	///\brief Calculates the derivative of the outputs in the direction of the parameters.
+	///
+	/// As the model is linear in its parameters, this is the output of the model with the direction as parameters.
+	void parameterDirectionalDerivative(
+		BatchInputType const& patterns, RealVector const& direction, State const& state, BatchOutputType& derivative
+	)const{
+		SIZE_CHECK(direction.size() == numberOfParameters());
+		LinearModel<InputType> directionModel(*this);
+		directionModel.setParameterVector(direction);
+		directionModel.eval(patterns,derivative);
+	}
+
+	///\brief Calculates the product of the hessian of the weighted outputs with a direction.
+	///
+	/// The second derivative of the outputs vanishes, thus only the weighted derivative with the derivative of the coefficients remains.
+	void weightedParameterHessianVectorProduct(
+		BatchInputType const& patterns,
+		BatchOutputType const& coefficients,
+		BatchOutputType const& coefficientDerivative,
+		RealVector const& direction,
+		State const& state,
+		RealVector& result
+	)const{
+		SIZE_CHECK(direction.size() == numberOfParameters());
+		weightedParameterDerivative(patterns,coefficientDerivative,state,result);
+	}
+
 	///\brief Calculates the first derivative w.r.t the inputs and summs them up over all patterns of the last computed batch
 	void weightedInputDerivative(
-		RealMatrix const & patterns,
+		MatrixType const & patterns,
 		BatchOutputType const & coefficients,
 		State const& state,
 		BatchInputType& derivative
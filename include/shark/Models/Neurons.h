@@ -31,6 +31,8 @@
 #define MODELS_NEURONS_H
  
 #include <shark/LinAlg/Base.h>
+#include <type_traits>
+#include <utility>
 
  
 namespace shark{
@@ -39,6 +41,8 @@ namespace detail{
 	///
 	///You need to provide a public member function function() and functionDerivative() in the derived class.
 	///Those functions calculate value and derivative for a single input.
+	///Neurons used with second order methods additionally provide functionSecondDerivative(), which
+	///computes the second derivative, again given the response of the neuron.
 	///Due to template magic, the neurons can either use vectors or matrices as input.
 	///Additionally, they avoid temporary values completely using ublas magic.
 	///Usage: 
@@ -76,6 +80,19 @@ namespace detail{
 			}
 			Derived const* m_self;
 		};
+		template<class T>
+		struct FunctionSecondDerivative{
+			typedef T argument_type;
+			typedef argument_type result_type;
+			static const bool zero_identity = false;
+
+			FunctionSecondDerivative(NeuronBase<Derived> const* self):m_self(static_cast<Derived const*>(self)){}
+
+			result_type operator()(argument_type x)const{
+				return m_self->functionSecondDerivative(x);
+			}
+			Derived const* m_self;
+		};
 	public:
 		
 		///for a given input vector, calculates the elementwise application of the sigmoid function defined by Derived.
@@ -104,6 +121,13 @@ namespace detail{
 			typedef FunctionDerivative<typename E::value_type> functor_type;
 			return blas::matrix_unary<E, functor_type >(x(),functor_type(this));
 		}
+		///Calculates the elementwise application of the second derivative of the sigmoid function defined by Derived.
+		///It's input is a matrix of previously calculated neuron responses generated by operator()
+		template<class E, class Device>
+		blas::matrix_unary<E, FunctionSecondDerivative<typename E::value_type> > secondDerivative(blas::matrix_expression<E, Device> const& x)const{
+			typedef FunctionSecondDerivative<typename E::value_type> functor_type;
+			return blas::matrix_unary<E, functor_type >(x(),functor_type(this));
+		}
 	};
 }
 	
@@ -118,10 +142,25 @@ struct LogisticNeuron : public detail::NeuronBase<LogisticNeuron>{
 	T function(T x)const{
 		return sigmoid(x);
 	}
+#ifdef REMORA_USE_SIMD
+	//use the vectorized sigmoid of the linear algebra library for dense vectors and matrices
+	template<class E, class Device>
+	auto operator()(blas::vector_expression<E, Device> const& x)const -> decltype(blas::sigmoid(x)){
+		return blas::sigmoid(x);
+	}
+	template<class E, class Device>
+	auto operator()(blas::matrix_expression<E, Device> const& x)const -> decltype(blas::sigmoid(x)){
+		return blas::sigmoid(x);
+	}
+#endif
 	template<class T>
 	T functionDerivative(T y)const{
 		return y * (1 - y);
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		return y * (1 - y) * (1 - 2 * y);
+	}
 };
 ///\brief Neuron which computes the hyperbolic tangenst with range [-1,1].
 ///
@@ -134,10 +173,24 @@ struct TanhNeuron: public detail::NeuronBase<TanhNeuron>{
 	T function(T x)const{
 		return std::tanh(x);
 	}
+#ifdef REMORA_USE_SIMD
+	template<class E, class Device>
+	auto operator()(blas::vector_expression<E, Device> const& x)const -> decltype(blas::tanh(x)){
+		return blas::tanh(x);
+	}
+	template<class E, class Device>
+	auto operator()(blas::matrix_expression<E, Device> const& x)const -> decltype(blas::tanh(x)){
+		return blas::tanh(x);
+	}
+#endif
 	template<class T>
 	T functionDerivative(T y)const{
 		return 1.0 - y*y;
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		return -2 * y * (1 - y*y);
+	}
 };
 ///\brief Linear activation Neuron. 
 struct LinearNeuron: public detail::NeuronBase<LinearNeuron>{
@@ -149,6 +202,10 @@ struct LinearNeuron: public detail::NeuronBase<LinearNeuron>{
 	T functionDerivative(T y)const{
 		return 1.0;
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		return T(0);
+	}
 };
 
 ///\brief Rectifier Neuron f(x) = max(0,x)
@@ -163,6 +220,10 @@ struct RectifierNeuron: public detail::NeuronBase<RectifierNeuron>{
 			return T(0);
 		return T(1);
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		return T(0);
+	}
 };
 
 ///\brief Fast sigmoidal function, which does not need to compute an exponential function.
@@ -180,6 +241,11 @@ struct FastSigmoidNeuron: public detail::NeuronBase<FastSigmoidNeuron>{
 	T functionDerivative(T y)const{
 		return sqr(1.0 - std::abs(y));
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		T t = 1 - std::abs(y);
+		return y < 0? 2 * t * t * t: -2 * t * t * t;
+	}
 };
 
 
@@ -211,6 +277,14 @@ struct DropoutNeuron: public detail::NeuronBase<DropoutNeuron<Neuron> >{
 			return m_neuron.functionDerivative(y);
 		}
 	}
+	template<class T>
+	T functionSecondDerivative(T y)const{
+		if(!m_stochastic){
+			return (1-m_probability)*m_neuron.functionSecondDerivative(y/ (1-m_probability));
+		}else{
+			return m_neuron.functionSecondDerivative(y);
+		}
+	}
 	
 	void setProbability(double probability){m_probability = probability;}
 	void setStochastic(bool stochastic){m_stochastic = stochastic;}
@@ -221,6 +295,33 @@ private:
 	Neuron m_neuron;
 };
 
+///\brief Whether the activation function of a neuron can be evaluated concurrently by several threads.
+///
+/// DropoutNeuron draws from the global random number generator and is therefore not threadsafe.
+template<class Neuron>
+struct IsThreadsafeNeuron{
+	static const bool value = true;
+};
+template<class Neuron>
+struct IsThreadsafeNeuron<DropoutNeuron<Neuron> >{
+	static const bool value = false;
+};
+
+///\brief Whether a neuron provides functionSecondDerivative().
+///
+/// Models only offer second order information, e.g. Hessian-vector products, if all of their neurons do.
+template<class Neuron>
+class HasSecondDerivativeNeuron{
+	template<class N>
+	static std::true_type test(decltype(std::declval<N const&>().functionSecondDerivative(0.0))*);
+	template<class N>
+	static std::false_type test(...);
+public:
+	static const bool value = decltype(test<Neuron>(0))::value;
+};
+template<class Neuron>
+class HasSecondDerivativeNeuron<DropoutNeuron<Neuron> >: public HasSecondDerivativeNeuron<Neuron>{};
+
 }
 
 #endif
@@ -42,38 +42,48 @@ namespace shark{
 //!  \brief A recurrent neural network regression model optimized
 //!         for online learning. 
 //!
-//! The OnlineRNNet can only process a single input at a time. Internally
+//! The OnlineRNNet processes one time step at a time. Internally
 //! it stores the last activation as well as the derivatives which get updated 
 //! over the course of the sequence. Instead of feeding in the whole sequence,
 //! the inputs must be given one after another. However if the whole sequence is
 //! available in advance, this implementation is not advisable, since it is a lot slower
 //! than RNNet which is targeted to whole sequences. 
+//!
+//! The network can advance several independent sequences (streams) at once. Every row
+//! of the batch given to eval is the next input of one stream, so a batch of size K advances
+//! K streams by one time step. The time step of all streams is computed with matrix-matrix products.
+//! The number of streams is fixed by the first call to eval or setOutputActivation
+//! and the following batches must have the same size.
 //! 
 //! All network state is stored in the State structure which can be created by createState()
 //! which has to be supplied to eval.
 //! A new time sequence is started by generating a new state object.
 //! When the network is created the user has to decide whether gradients
-//! are needed. In this case additional ressources are allocated in the state object on creation
+//! are needed. In this case additional ressources are allocated in the state object
 //! and eval makes sure that the gradient is properly updated between steps, this is costly.
 //! It is possible to skip steps updating the parameters, e.g. when no reward signal is available.
 //!
-//! Note that eval can only work with batches of size one and eval without  a state object can not
-//! be called.
+//! Two methods for the gradient are available, both need a fixed amount of memory per stream
+//! that does not grow with the length of the sequence:
+//! - Real time recurrent learning (RTRL), the default, computes the exact gradient. It needs O(pn)
+//!   memory per stream and O(pn^2) computations per step, where p is the number of parameters and
+//!   n the number of neurons.
+//! - Truncated backpropagation through time, see setTruncation, propagates the error
+//!   only through the last k time steps. It needs O(kn) memory per stream and O(kp) computations
+//!   per step and is an approximation of the gradient.
+//!
+//! Note that eval without a state object can not be called.
 class OnlineRNNet:public AbstractModel<RealVector,RealVector>
 {
 private:
 	struct InternalState: public State{
-		
-		InternalState(RecurrentStructure const& structure)
-		: activation(structure.numberOfUnits(),0.0)
-		, lastActivation(structure.numberOfUnits(),0.0)
-		, unitGradient(structure.parameters(),structure.numberOfNeurons(),0.0){}
-		//!the activation of the network at time t (after evaluation)
-		RealVector activation;
-		//!the activation of the network at time t-1 (before evaluation)
-		RealVector lastActivation;
-
-		//!\brief the gradient of the hidden units with respect to every weight
+		InternalState():steps(0), truncation(0){}
+		//!the activation of the network at time t (after evaluation), one row per stream
+		RealMatrix activation;
+		//!the activation of the network at time t-1 (before evaluation), one row per stream
+		RealMatrix lastActivation;
+
+		//!\brief the gradient of the hidden units with respect to every weight, used by RTRL
 		//!
 		//!The gradient \f$ \frac{\delta y_k(t)}{\delta w_{ij}} \f$ is stored in this
 		//!structure. Using this gradient, the derivative of the Network can be calculated as
@@ -82,7 +92,19 @@ private:
 		//!the gradient needs to be updated after every timestep using the formula
 		//!\f[ \frac{\delta y_k(t+1)}{\delta w_{ij}}= y'_k(t)= \left[\sum_{l=1}^n w_{il}\frac{\delta y_l(t)}{\delta w_{ij}} +\delta_{kl}y_l(t-1)\right]\f]
 		//!so if the gradient is needed, don't forget to call weightedParameterDerivative at every timestep!
+		//!The rows s*p,...,(s+1)*p-1 belong to the s-th stream, where p is the number of parameters.
 		RealMatrix unitGradient;
+
+		//!\brief the last activations used by truncated BPTT, stored as a ring buffer.
+		//!
+		//! lastActivationHistory[h] and activationHistory[h] store lastActivation and
+		//! activation of the time step t with t%k=h, where k is the length of the truncation window.
+		std::vector<RealMatrix> lastActivationHistory;
+		std::vector<RealMatrix> activationHistory;
+		//! the number of time steps processed so far
+		std::size_t steps;
+		//! the length of the truncation window when the state was initialized, 0 for RTRL
+		std::size_t truncation;
 	};
 public:
 	//! creates a configured neural network
@@ -91,14 +113,28 @@ public:
 	//! \brief computeGradient Whether the network will be used to compute gradients
 	SHARK_EXPORT_SYMBOL OnlineRNNet(RecurrentStructure* structure, bool computeGradient);
 
+	//! \brief Sets the window length of truncated BPTT.
+	//!
+	//! With a length k>0 the gradient is computed by propagating the error backwards
+	//! through the last k time steps. With k=0, the default, RTRL is used to compute
+	//! the exact gradient. The setting must not be changed while a state is in use.
+	void setTruncation(std::size_t windowLength = 0){
+		m_truncation = windowLength;
+	}
+
+	//! \brief Returns the window length of truncated BPTT, 0 if RTRL is used.
+	std::size_t truncation()const{
+		return m_truncation;
+	}
+
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "OnlineRNNet"; }
 
 	//!  \brief Feeds a timestep of a time series to the model and
-	//!         calculates it's output. The batches must have size 1.
+	//!         calculates it's output. Every row is the next input of one stream.
 	//!
-	//!  \param  pattern Input patterns for the network.
+	//!  \param  pattern Input patterns for the network, one row per stream.
 	//!  \param  output Used to store the outputs of the network.
 	//!  \param  state the current state of the RNN that is updated by eval
 	SHARK_EXPORT_SYMBOL void eval(RealMatrix const& pattern,RealMatrix& output, State& state)const;
@@ -122,12 +158,13 @@ public:
 
 	//!\brief calculates the weighted sum of gradients w.r.t the parameters
 	//!
-	//!Uses an iterative update scheme to calculate the gradient at timestep t from the gradient
-	//!at timestep t-1 using forward propagation. This Methods requires O(n^3) Memory and O(n^4) computations,
-	//!where n is the number of neurons. So if the network is very large, RNNet should be used!
+	//!With RTRL, uses an iterative update scheme to calculate the gradient at timestep t from the gradient
+	//!at timestep t-1 using forward propagation. This Methods requires O(n^3) Memory and O(n^4) computations
+	//!per stream, where n is the number of neurons. So if the network is very large, truncated BPTT or RNNet should be used!
+	//!The gradient is summed over all streams.
 	//!
 	//! \param pattern the pattern to evaluate
-	//! \param coefficients the oefficients which are used to calculate the weighted sum
+	//! \param coefficients the coefficients which are used to calculate the weighted sum, one row per stream
 	//! \param gradient the calculated gradient
 	//! \param state the current state of the RNN
 	SHARK_EXPORT_SYMBOL void weightedParameterDerivative(
@@ -150,7 +187,7 @@ public:
 	}
 	
 	boost::shared_ptr<State> createState()const{
-		return boost::shared_ptr<State>(new InternalState( *mpe_structure));
+		return boost::shared_ptr<State>(new InternalState());
 	}
 	
 
@@ -166,12 +203,17 @@ public:
 	//!  \param  state  The current state of the network
 	//!  \param  activation  Input patterns for the network.
 	void setOutputActivation(State& state, RealVector const& activation){
-		InternalState& s = state.toState<InternalState>();
-		s.activation.resize(mpe_structure->numberOfUnits());
-		subrange(s.activation,mpe_structure->numberOfUnits()-outputSize(),mpe_structure->numberOfUnits()) = activation;
+		RealMatrix activations(1,activation.size());
+		noalias(row(activations,0)) = activation;
+		setOutputActivation(state,activations);
 	}
+
+	//!  \brief Sets the activation of the output neurons of several streams, one row per stream.
+	SHARK_EXPORT_SYMBOL void setOutputActivation(State& state, RealMatrix const& activations);
 	
-	
+private:
+	//! prepares the state for the given number of streams if this is the first time step
+	void initializeState(InternalState& state, std::size_t streams)const;
 	
 protected:
 	
@@ -180,6 +222,9 @@ protected:
 	
 	//! stores whether the network should compute a gradient
 	bool m_computeGradient;
+
+	//! window length of truncated BPTT, 0 for RTRL
+	std::size_t m_truncation;
 	
 };
 }
@@ -52,24 +52,30 @@ namespace shark{
 //! neurons are.
 //!
 //!  This class is optimized for batch learning. See OnlineRNNet for an online
-//!  version.
+//!  version. Sequences of the same length in a batch are grouped into blocks and
+//!  all sequences of a block are processed together, such that every time step
+//!  of eval and BPTT is a matrix-matrix product. The blocks are processed in parallel.
+//!  The result does not depend on the number of threads.
+//!
+//!  Long sequences can be trained with truncated BPTT, see setTruncation.
 class RNNet:public AbstractModel<Sequence,Sequence >
 {
 private:
 	struct InternalState: public State{
-		//! Activation of the neurons after processing the time series.
-		//! m_timeActivation(b,t,i) is a 3-dimensional array, the first dimension
-		//! returns the i-th element of the batch, the second dimension returns
-		//! the activation for timestep t, the third dimension the activation
-		//! of the neuron at the timestep of the batch element.
-		std::vector<Sequence> timeActivation;
+		//! Sequences of equal length are processed together in blocks.
+		//! blockSequences[k] stores the indices of the sequences in the k-th block.
+		std::vector<std::vector<std::size_t> > blockSequences;
+		//! Activation of the units after processing the time series.
+		//! blockActivation[k][t] is the matrix of activations at timestep t
+		//! of the k-th block, the i-th row belongs to the i-th sequence of the block.
+		std::vector<std::vector<RealMatrix> > blockActivation;
 	};
 public:
 
 	//! creates a neural network with a potentially shared structure
 	//! \param structure the structure of this neural network. It can be shared between multiple instances or with then
 	//!                  online version of this net.
-	RNNet(RecurrentStructure* structure):mpe_structure(structure){
+	RNNet(RecurrentStructure* structure):mpe_structure(structure), m_truncation(0){
 		SHARK_RUNTIME_CHECK(mpe_structure,"[RNNet] structure is not allowed to be empty");
 		m_features|=HAS_FIRST_PARAMETER_DERIVATIVE;
 	}
@@ -101,6 +107,22 @@ public:
 		m_warmUpSequence = warmUpSequence;
 	}
 	
+	//! \brief Sets the window length of truncated BPTT.
+	//!
+	//! The time steps are divided into consecutive windows of the given length,
+	//! starting with the first step of the warm up sequence. The error is propagated
+	//! backwards only within a window, the forward pass is not affected.
+	//! This limits the cost of the backward pass for long sequences, the gradient
+	//! is then an approximation. A length of 0, the default, computes the exact gradient.
+	void setTruncation(std::size_t windowLength = 0){
+		m_truncation = windowLength;
+	}
+
+	//! \brief Returns the window length of truncated BPTT, 0 if no truncation is used.
+	std::size_t truncation()const{
+		return m_truncation;
+	}
+	
 	boost::shared_ptr<State> createState()const{
 		return boost::shared_ptr<State>(new InternalState());
 	}
@@ -172,7 +194,8 @@ protected:
 	//! the topology of the network.
 	RecurrentStructure* mpe_structure;
 
-	RealMatrix m_errorDerivative;
+	//! window length of truncated BPTT, 0 for no truncation
+	std::size_t m_truncation;
 };
 }
 
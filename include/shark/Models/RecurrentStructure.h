@@ -187,6 +187,44 @@ public:
 	//! Computes the derivative of the neuron.
 	SHARK_EXPORT_SYMBOL double neuronDerivative(double activation);
 
+	//! Applies the activation function elementwise to a block of activations,
+	//! e.g. the neurons of several sequences at one time step.
+	template<class MatrixType>
+	void applyNeuron(MatrixType&& activations)const{
+		switch(m_sigmoidType){
+			case Tanh:
+				noalias(activations) = tanh(activations);
+			break;
+			case Logistic:
+				noalias(activations) = sigmoid(activations);
+			break;
+			case Linear:
+			break;
+			case FastSigmoid:
+				noalias(activations) = activations / (1.0 + abs(activations));
+			break;
+		}
+	}
+
+	//! Multiplies a block of errors elementwise with the derivative of the neurons.
+	//! The derivative is computed from the neuron responses as in neuronDerivative.
+	template<class MatrixType, class ResponseType>
+	void multiplyNeuronDerivative(MatrixType&& errors, ResponseType const& responses)const{
+		switch(m_sigmoidType){
+			case Tanh:
+				noalias(errors) *= 1.0 - sqr(responses);
+			break;
+			case Logistic:
+				noalias(errors) *= responses * (1.0 - responses);
+			break;
+			case Linear:
+			break;
+			case FastSigmoid:
+				noalias(errors) *= sqr(1.0 - abs(responses));
+			break;
+		}
+	}
+
 protected:
 
 	//================Convenience index variables=====================
@@ -36,7 +36,6 @@
 #ifndef SHARK_MODELS_SOFTMAX_H
 #define SHARK_MODELS_SOFTMAX_H
 
-#include <shark/Core/DLLSupport.h>
 #include <shark/Models/AbstractModel.h>
 namespace shark {
 
@@ -61,12 +60,17 @@ namespace shark {
 /// This convention ensures that all models that are trained via CrossEntropy
 /// can be used as input to this model and the output will be the probability
 /// of the labels.
-	
-class Softmax : public AbstractModel<RealVector,RealVector>
+///
+/// The template argument is the vector type of inputs and outputs, e.g. FloatVector
+/// for single precision. Softmax is the double precision version.
+template<class VectorType>
+class BasicSoftmax : public AbstractModel<VectorType,VectorType>
 {
 private:
+	typedef AbstractModel<VectorType,VectorType> base_type;
+	typedef typename VectorType::value_type value_type;
 	struct InternalState : public State{
-		RealMatrix results;
+		typename base_type::BatchOutputType results;
 
 		void resize(std::size_t numPatterns,std::size_t inputs){
 			results.resize(numPatterns,inputs);
@@ -74,10 +78,20 @@ private:
 	};
 
 public:
+	typedef typename base_type::BatchInputType BatchInputType;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+
 	/// Constructor
-	SHARK_EXPORT_SYMBOL Softmax(size_t inputs);
+	BasicSoftmax(std::size_t inputs){
+		this->m_features|=base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		this->m_features|=base_type::HAS_FIRST_INPUT_DERIVATIVE;
+		setStructure(inputs);
+	}
 	/// Constructor
-	SHARK_EXPORT_SYMBOL Softmax();
+	BasicSoftmax(){
+		this->m_features|=base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		this->m_features|=base_type::HAS_FIRST_INPUT_DERIVATIVE;
+	}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -90,13 +104,13 @@ public:
 		SIZE_CHECK(newParameters.size()==0);
 	}
 
-	size_t inputSize()const{
+	std::size_t inputSize()const{
 		return m_inputSize;
 	}
-	size_t outputSize()const{
+	std::size_t outputSize()const{
 		return m_inputSize==1?2:m_inputSize;
 	}
-	size_t numberOfParameters()const{
+	std::size_t numberOfParameters()const{
 		return 0;
 	}
 
@@ -104,30 +118,83 @@ public:
 		return boost::shared_ptr<State>(new InternalState());
 	}
 
-	SHARK_EXPORT_SYMBOL void eval(BatchInputType const& patterns,BatchOutputType& output)const;
-	SHARK_EXPORT_SYMBOL void eval(BatchInputType const& patterns,BatchOutputType& output, State & state)const;
-	using AbstractModel<RealVector,RealVector>::eval;
-	
-	SHARK_EXPORT_SYMBOL void weightedParameterDerivative(
+	void eval(BatchInputType const& patterns,BatchOutputType& outputs)const{
+		SIZE_CHECK(patterns.size2() == inputSize());
+		if(inputSize() == 1){
+			outputs.resize(patterns.size1(),2);
+			for(std::size_t i = 0; i != patterns.size1();++i){
+				outputs(i,0) = std::exp(patterns(i,0));
+				outputs(i,1) = 1/outputs(i,0);
+			}
+		}else{
+			outputs.resize(patterns.size1(),inputSize());
+			noalias(outputs) = exp(patterns);
+		}
+
+		for(std::size_t i = 0; i != patterns.size1(); ++i){
+			row(outputs,i) /= sum(row(outputs,i));
+		}
+	}
+	void eval(BatchInputType const& patterns,BatchOutputType& outputs, State & state)const{
+		eval(patterns,outputs);
+		InternalState& s = state.toState<InternalState>();
+		s.resize(patterns.size1(),outputSize());
+		noalias(s.results) = outputs;
+	}
+	using base_type::eval;
+
+	void weightedParameterDerivative(
 		BatchInputType const& patterns, BatchOutputType const& coefficients,  State const& state, RealVector& gradient
-	)const;
-	SHARK_EXPORT_SYMBOL void weightedInputDerivative(
-		BatchInputType const& patterns, RealMatrix const& coefficients,  State const& state, BatchOutputType& gradient
-	)const;
+	)const{
+		SIZE_CHECK(patterns.size2() == inputSize());
+		SIZE_CHECK(coefficients.size2()==outputSize());
+		SIZE_CHECK(coefficients.size1()==patterns.size1());
+
+		gradient.resize(0);
+	}
+	void weightedInputDerivative(
+		BatchInputType const& patterns, BatchOutputType const& coefficients,  State const& state, BatchOutputType& gradient
+	)const{
+		SIZE_CHECK(patterns.size2() == inputSize());
+		SIZE_CHECK(coefficients.size2()==patterns.size2());
+		SIZE_CHECK(coefficients.size1()==patterns.size1());
+		InternalState const& s = state.toState<InternalState>();
+		gradient.resize(patterns.size1(),inputSize());
+		gradient.clear();
+		if(inputSize() ==1){
+			for(std::size_t i = 0; i != patterns.size1(); ++i){
+				value_type sdx= s.results(i,0)*(1-s.results(i,0));
+				gradient(i,0) = coefficients(i,1)+(coefficients(i,0)-coefficients(i,1))*sdx;
+			}
+		}
+		else{
+			for(std::size_t i = 0; i != patterns.size1(); ++i){
+				value_type mass=inner_prod(row(coefficients,i),row(s.results,i));
+				//(c_k-m)*f_k
+				noalias(row(gradient,i)) = (row(coefficients,i) - mass) *row(s.results,i);
+			}
+		}
+	}
 
 	void setStructure(std::size_t inputSize){
 		m_inputSize = inputSize;
 	}
-	
+
 	/// From ISerializable, reads a model from an archive
-	SHARK_EXPORT_SYMBOL void read( InArchive & archive );
+	void read( InArchive & archive ){
+		archive >> m_inputSize;
+	}
 
 	/// From ISerializable, writes a model to an archive
-	SHARK_EXPORT_SYMBOL void write( OutArchive & archive ) const;
-	
+	void write( OutArchive & archive ) const{
+		archive << m_inputSize;
+	}
+
 private:
 	std::size_t m_inputSize;
 };
 
+typedef BasicSoftmax<RealVector> Softmax;
+
 }
 #endif
@@ -0,0 +1,64 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Objective functions which can be evaluated with a reduced budget
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_OBJECTIVEFUNCTIONS_ABSTRACTBUDGETEDOBJECTIVEFUNCTION_H
+#define SHARK_OBJECTIVEFUNCTIONS_ABSTRACTBUDGETEDOBJECTIVEFUNCTION_H
+
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+namespace shark{
+
+/// \brief Objective function which can be evaluated with a fraction of the resources of a full evaluation.
+///
+/// Typical examples are model selection criteria, where the budget is the number of
+/// training iterations, the fraction of the training data or the number of folds
+/// used for cross-validation. An evaluation with a smaller budget is cheaper
+/// but only approximates the full evaluation.
+/// The budget is given as a number in (0,1], where 1 corresponds to the full evaluation
+/// as returned by eval.
+///
+/// Optimizers such as SuccessiveHalving and Hyperband use the budget to
+/// stop the evaluation of poor points early.
+class AbstractBudgetedObjectiveFunction : public SingleObjectiveFunction{
+public:
+	/// \brief Evaluates the function with the given fraction of the resources of a full evaluation.
+	virtual double evalBudgeted(SearchPointType const& input, double budget)const = 0;
+
+	/// \brief Evaluates the function with the full budget.
+	double eval(SearchPointType const& input)const{
+		return evalBudgeted(input, 1.0);
+	}
+};
+
+}
+#endif
@@ -81,6 +81,7 @@ public:
 		HAS_FIRST_DERIVATIVE = 1,
 		HAS_SECOND_DERIVATIVE = 2,
 		IS_LOSS_FUNCTION = 4,
+		HAS_HESSIAN_VECTOR_PRODUCT = 8,
 	};
 
 	SHARK_FEATURE_INTERFACE;
@@ -94,6 +95,11 @@ public:
 		//~ return m_features & HAS_SECOND_DERIVATIVE; 
 	//~ }
 	
+	/// returns true when products of the hessian w.r.t. the predictions with a vector are implemented
+	bool hasHessianVectorProduct() const{ 
+		return m_features & HAS_HESSIAN_VECTOR_PRODUCT; 
+	}
+	
 	/// returns true when the cost function is in fact a loss function
 	bool isLossFunction() const{ 
 		return m_features & IS_LOSS_FUNCTION; 
@@ -64,6 +64,8 @@ namespace shark {
 /// HAS_FIRST_DERIVATIVE: evalDerivative can be called for the FirstOrderDerivative.
 /// The Derivative is defined and as exact as possible;
 /// HAS_SECOND_DERIVATIVE: evalDerivative can be called for the second derivative.
+/// HAS_HESSIAN_VECTOR_PRODUCT: evalHessianVectorProduct computes the product of the Hessian with a vector
+/// without forming the Hessian;
 /// IS_CONSTRAINED_FEATURE: The function has constraints and isFeasible might return false;
 /// CAN_PROPOSE_STARTING_POINT: the function can return a possibly randomized starting point;
 /// CAN_PROVIDE_CLOSEST_FEASIBLE: if the function is constrained, closest feasible can be
@@ -109,7 +111,8 @@ public:
 		HAS_CONSTRAINT_HANDLER           =  32, ///< The constraints are governed by a constraint handler which can be queried by getConstraintHandler()
 		CAN_PROVIDE_CLOSEST_FEASIBLE     = 64,	///< If the function is constrained, the method closestFeasible is implemented and returns a "repaired" solution.
 		IS_THREAD_SAFE     = 128,	///< can eval or evalDerivative be called in parallel?
-		IS_NOISY     = 256	///< The function value is perturbed by some kind of noise
+		IS_NOISY     = 256,	///< The function value is perturbed by some kind of noise
+		HAS_HESSIAN_VECTOR_PRODUCT = 512 ///< The method evalHessianVectorProduct is implemented and returns the exact product.
 	};
 
 	/// This statement declares the member m_features. See Core/Flags.h for details.
@@ -130,6 +133,11 @@ public:
 		return m_features & HAS_SECOND_DERIVATIVE;
 	}
 	
+	/// \brief returns whether this function can compute products of the Hessian with a vector
+	bool hasHessianVectorProduct()const{
+		return m_features & HAS_HESSIAN_VECTOR_PRODUCT;
+	}
+	
 	/// \brief returns whether this function can propose a starting point.
 	bool canProposeStartingPoint()const{
 		return m_features & CAN_PROPOSE_STARTING_POINT;
@@ -281,6 +289,19 @@ public:
 		SHARK_FEATURE_EXCEPTION(HAS_SECOND_DERIVATIVE);
 	}
 
+	/// \brief Computes the product of the Hessian of the objective function with a vector.
+	///
+	/// The Hessian is never formed, thus the product can be used by optimizers
+	/// for problems whose Hessian does not fit into memory, e.g. inside a conjugate gradient solver.
+	/// \param [in] input The point at which the Hessian is evaluated.
+	/// \param [in] vector The vector which is multiplied with the Hessian.
+	/// \param [out] result The product of the Hessian with the vector.
+	/// \throws FeatureNotAvailableException in the default implementation
+	/// and if a function does not support this feature.
+	virtual void evalHessianVectorProduct( SearchPointType const& input, SearchPointType const& vector, SearchPointType& result )const {
+		SHARK_FEATURE_EXCEPTION(HAS_HESSIAN_VECTOR_PRODUCT);
+	}
+
 protected:
 	mutable std::size_t m_evaluationCounter; ///< Evaluation counter, default value: 0.
 	AbstractConstraintHandler<SearchPointType> const* m_constraintHandler;
@@ -0,0 +1,66 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Interface for combining partial results of data parallel computations
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_OBJECTIVEFUNCTIONS_ABSTRACTREDUCER_H
+#define SHARK_OBJECTIVEFUNCTIONS_ABSTRACTREDUCER_H
+
+#include <shark/LinAlg/Base.h>
+
+namespace shark{
+
+///
+/// \brief Combines the partial sums of several processes in data parallel training.
+///
+/// In data parallel training, every process holds a part of the training data and
+/// an objective function, e.g. an ErrorFunction, defined on it. Every evaluation computes
+/// the sums of the loss (and its gradient) over the local data. The reducer exchanges these sums
+/// so that afterwards every process holds the sums over the whole dataset. The processes then
+/// take the same optimization step and stay synchronized.
+///
+/// The reducer is an extension point for communication backends, e.g. MPI,
+/// sockets or shared memory. An implementation must be called by all processes in the same order.
+/// For results that do not depend on timing, the sum should be computed in a fixed
+/// order, e.g. by rank of the processes.
+///
+class AbstractReducer{
+public:
+	virtual ~AbstractReducer(){}
+
+	/// \brief Replaces the buffer on every process by the elementwise sum of the buffers of all processes.
+	///
+	/// All processes pass buffers of the same size.
+	virtual void allReduce(RealVector& buffer) = 0;
+};
+
+}
+#endif
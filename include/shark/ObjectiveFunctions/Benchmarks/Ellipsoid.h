@@ -46,6 +46,7 @@ struct Ellipsoid : public SingleObjectiveFunction {
 		m_features |= CAN_PROPOSE_STARTING_POINT;
 		m_features |= HAS_FIRST_DERIVATIVE;
 		m_features |= HAS_SECOND_DERIVATIVE;
+		m_features |= HAS_HESSIAN_VECTOR_PRODUCT;
 		m_numberOfVariables = numberOfVariables;
 	}
 
@@ -105,6 +106,14 @@ struct Ellipsoid : public SingleObjectiveFunction {
 		}
 		return eval(p);
 	}
+	void evalHessianVectorProduct(SearchPointType const& p, SearchPointType const& v, SearchPointType& result)const {
+		SIZE_CHECK(v.size() == p.size());
+		double sizeMinusOne=p.size() - 1.;
+		result.resize(p.size());
+		for (std::size_t i = 0; i < p.size(); i++) {
+			result(i) = 2 * std::pow(m_alpha, i / sizeMinusOne ) * v(i);
+		}
+	}
 private:
 	std::size_t m_numberOfVariables;
 	double m_alpha;
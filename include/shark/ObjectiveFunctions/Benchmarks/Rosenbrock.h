@@ -67,6 +67,7 @@ struct Rosenbrock : public SingleObjectiveFunction {
 		m_features|=CAN_PROPOSE_STARTING_POINT;
 		m_features|=HAS_FIRST_DERIVATIVE;
 		m_features|=HAS_SECOND_DERIVATIVE;
+		m_features|=HAS_HESSIAN_VECTOR_PRODUCT;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -146,6 +147,18 @@ struct Rosenbrock : public SingleObjectiveFunction {
 		return result;
 	}
 
+	/// \brief Multiplies the tridiagonal Hessian with a vector.
+	virtual void evalHessianVectorProduct( const SearchPointType & p, const SearchPointType & v, SearchPointType & result )const {
+		size_t size = p.size();
+		SIZE_CHECK(v.size() == size);
+		result.resize(size);
+		result(0) = (2 - 400* (p(1) - 3*sqr(p(0)))) * v(0) - 400 * p(0) * v(1);
+		result(size-1) = 200 * v(size-1) - 400 * p( size - 2 ) * v(size-2);
+		for(size_t i=1; i != size-1; ++i){
+			result(i) = (202 - 400 * ( p(i+1) - 3 * sqr(p(i)))) * v(i) - 400 * p(i) * v(i+1) - 400 * p(i-1) * v(i-1);
+		}
+	}
+
 private:
 	std::size_t m_numberOfVariables;
 	double m_initialSpread;
@@ -60,6 +60,7 @@ public:
 	CombinedObjectiveFunction(){
 		this->m_features|=super::HAS_FIRST_DERIVATIVE;
 		this->m_features|=super::HAS_SECOND_DERIVATIVE;
+		this->m_features|=super::HAS_HESSIAN_VECTOR_PRODUCT;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -85,6 +86,7 @@ public:
 		if (e.features().test(element::IS_CONSTRAINED_FEATURE)) this->m_features.set(super::IS_CONSTRAINED_FEATURE);
 		if (! e.features().test(element::HAS_FIRST_DERIVATIVE)) this->m_features.reset(super::HAS_FIRST_DERIVATIVE);
 		if (! e.features().test(element::HAS_SECOND_DERIVATIVE)) this->m_features.reset(super::HAS_SECOND_DERIVATIVE);
+		if (! e.features().test(element::HAS_HESSIAN_VECTOR_PRODUCT)) this->m_features.reset(super::HAS_HESSIAN_VECTOR_PRODUCT);
 	}
 
 	/// Tests whether a point in SearchSpace is feasible,
@@ -149,6 +151,25 @@ public:
 		return ret;
 	}
 
+	/// Calculates the product of the Hessian with a vector
+	/// as weighted sum of the products of the single functions.
+	void evalHessianVectorProduct(
+		typename super::SearchPointType const& input,
+		typename super::SearchPointType const& vector,
+		typename super::SearchPointType& result
+	)const {
+		SHARK_RUNTIME_CHECK(this->m_features.test(super::HAS_HESSIAN_VECTOR_PRODUCT), "[CombinedObjectiveFunction::evalHessianVectorProduct] At least one of the objective functions combined does not provide hessian vector products");
+		typename super::SearchPointType product;
+		std::size_t ic = m_elements.size();
+		m_elements[0]->evalHessianVectorProduct(input, vector, product);
+		result = m_weight[0] * product;
+		for (std::size_t i=1; i<ic; i++)
+		{
+			m_elements[i]->evalHessianVectorProduct(input, vector, product);
+			result += m_weight[i] * product;
+		}
+	}
+
 protected:
 	/// list of weights
 	std::vector<double> m_weight;
@@ -36,11 +36,21 @@
 #ifndef SHARK_OBJECTIVEFUNCTIONS_CROSSVALIDATIONERROR_H
 #define SHARK_OBJECTIVEFUNCTIONS_CROSSVALIDATIONERROR_H
 
-#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/ObjectiveFunctions/AbstractBudgetedObjectiveFunction.h>
 #include <shark/Algorithms/Trainers/AbstractTrainer.h>
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Algorithms/StoppingCriteria/MaxIterations.h>
 #include <shark/ObjectiveFunctions/AbstractCost.h>
 #include <shark/Data/CVDatasetTools.h>
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace shark {
 
@@ -68,8 +78,27 @@ namespace shark {
 /// IParameterizable object, a model, a trainer, a data set,
 /// and a cost function.
 ///
+/// \par
+/// The folds can be trained concurrently. To this end, further
+/// independent copies of meta object, model and trainer are
+/// registered with addWorker. Each fold borrows one of these workers
+/// for training and validation, so the number of workers bounds
+/// the number of concurrent trainings and thus the memory used.
+/// With more than one worker the function is thread safe, which allows
+/// GridSearch, NestedGridSearch and PointSearch to evaluate several
+/// points at once. The errors of the folds are summed in a fixed order,
+/// so the result does not depend on the number of threads.
+///
+/// \par
+/// The error can be evaluated with a reduced budget, see
+/// AbstractBudgetedObjectiveFunction. Depending on the BudgetType, the
+/// budget is the fraction of folds used, the fraction of the training
+/// data of each fold, or the fraction of the iterations of an
+/// iterative trainer, which is controlled by a MaxIterations
+/// stopping criterion.
+///
 template<class ModelTypeT, class LabelTypeT = typename ModelTypeT::OutputType>
-class CrossValidationError : public SingleObjectiveFunction
+class CrossValidationError : public AbstractBudgetedObjectiveFunction
 {
 public:
 	typedef typename ModelTypeT::InputType InputType;
@@ -80,15 +109,89 @@ public:
 	typedef ModelTypeT ModelType;
 	typedef AbstractTrainer<ModelType, LabelType> TrainerType;
 	typedef AbstractCost<LabelType, OutputType> CostType;
+	typedef MaxIterations<> IterationsType;
+
+	/// \brief Resource which is reduced by evaluations with a budget smaller than one.
+	enum BudgetType{
+		Folds,        ///< only the first folds are trained and validated
+		TrainingData, ///< only the first batches of each training set are used
+		Iterations    ///< the trainers are stopped after a fraction of the maximum number of iterations
+	};
 private:
-	typedef SingleObjectiveFunction base_type;
+	typedef AbstractBudgetedObjectiveFunction base_type;
+
 
+	/// \brief Objects needed to train and validate the model on one fold.
+	struct Worker{
+		IParameterizable* meta;
+		ModelType* model;
+		TrainerType* trainer;
+		IterationsType* iterations;
+	};
+
+	/// \brief Hands out the workers to the folds which are evaluated concurrently.
+	struct WorkerPool{
+		std::vector<Worker> workers;
+		std::vector<std::size_t> idle;
+		std::mutex mutex;
+		std::condition_variable released;
+	};
 
 	FoldsType m_folds;
 	IParameterizable* mep_meta;
 	ModelType* mep_model;
 	TrainerType* mep_trainer;
 	CostType* mep_cost;
+	std::shared_ptr<WorkerPool> m_pool;
+	BudgetType m_budgetType;
+	unsigned int m_maxIterations;
+
+	std::size_t acquireWorker()const{
+		std::unique_lock<std::mutex> lock(m_pool->mutex);
+		m_pool->released.wait(lock, [this]{return !m_pool->idle.empty();});
+		std::size_t worker = m_pool->idle.back();
+		m_pool->idle.pop_back();
+		return worker;
+	}
+
+	void releaseWorker(std::size_t worker)const{
+		{
+			std::lock_guard<std::mutex> lock(m_pool->mutex);
+			m_pool->idle.push_back(worker);
+		}
+		m_pool->released.notify_one();
+	}
+
+	/// trains a model on the training part of the fold and returns its cost on the validation part
+	double evalFold(std::size_t setID, RealVector const& parameters, double budget)const{
+		std::size_t index = acquireWorker();
+		Worker const& worker = m_pool->workers[index];
+		try{
+			worker.meta->setParameterVector(parameters);
+			DatasetType train =  m_folds.training(setID);
+			DatasetType validation =  m_folds.validation(setID);
+			if(m_budgetType == TrainingData){
+				train = rangeSubset(train, 0, budgetedSize(train.numberOfBatches(), budget));
+			}
+			else if(m_budgetType == Iterations){
+				SHARK_RUNTIME_CHECK(worker.iterations, "Iteration budgets need a MaxIterations criterion for every worker");
+				worker.iterations->setMaxIterations((unsigned int)budgetedSize(m_maxIterations, budget));
+			}
+			worker.trainer->train(*worker.model, train);
+			Data<OutputType> output = (*worker.model)(validation.inputs());
+			double error = mep_cost->eval(validation.labels(), output);
+			releaseWorker(index);
+			return error;
+		}catch(...){
+			releaseWorker(index);
+			throw;
+		}
+	}
+
+	/// number of resources out of total used for the budget, at least one
+	static std::size_t budgetedSize(std::size_t total, double budget){
+		return std::max<std::size_t>(1, std::min<std::size_t>(total, (std::size_t)std::ceil(budget * total - 1.e-10)));
+	}
 
 public:
 
@@ -103,7 +206,12 @@ public:
 	, mep_model(model)
 	, mep_trainer(trainer)
 	, mep_cost(cost)
-	{ }
+	, m_pool(new WorkerPool())
+	, m_budgetType(Folds)
+	, m_maxIterations(0)
+	{
+		addWorker(meta, model, trainer);
+	}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -118,22 +226,88 @@ public:
 		return mep_meta->numberOfParameters();
 	}
 
+	/// \brief Adds a further copy of meta object, model and trainer used to train folds concurrently.
+	///
+	/// The objects must not share state with the other workers, e.g. a kernel whose parameters
+	/// are set by the meta object needs its own copy for every worker. The meta object must
+	/// configure the model and trainer of the same worker.
+	/// The objects given in the constructor form the first worker.
+	/// The stopping criterion is only needed for the Iterations budget and must stop the trainer of the worker.
+	void addWorker(IParameterizable* meta, ModelType* model, TrainerType* trainer, IterationsType* iterations = nullptr){
+		SHARK_RUNTIME_CHECK(meta->numberOfParameters() == mep_meta->numberOfParameters(), "Meta objects of all workers must have the same number of parameters");
+		Worker worker = {meta, model, trainer, iterations};
+		m_pool->idle.push_back(m_pool->workers.size());
+		m_pool->workers.push_back(worker);
+		if(m_pool->workers.size() > 1)
+			m_features |= IS_THREAD_SAFE;
+	}
+
+	/// \brief Number of workers, i.e. the maximum number of concurrent trainings.
+	std::size_t numberOfWorkers()const{
+		return m_pool->workers.size();
+	}
+
+	/// \brief Returns the resource reduced by evaluations with a budget.
+	BudgetType budgetType()const{
+		return m_budgetType;
+	}
+
+	/// \brief Budgets reduce the number of folds or the training data of each fold.
+	void setBudgetType(BudgetType type){
+		SHARK_RUNTIME_CHECK(type != Iterations, "Use setIterationBudget for iteration budgets");
+		m_budgetType = type;
+	}
+
+	/// \brief Budgets reduce the number of iterations of the trainer.
+	///
+	/// A budget b lets the trainer run for at most b * maxIterations iterations by adjusting
+	/// the stopping criterion of the trainer before every training. The trainer may still stop
+	/// earlier due to other criteria. The stopping criterion belongs to the worker
+	/// given in the constructor, further workers pass their own criterion to addWorker.
+	void setIterationBudget(unsigned int maxIterations, IterationsType* iterations){
+		SHARK_RUNTIME_CHECK(maxIterations > 0, "The maximum number of iterations must be positive");
+		m_pool->workers[0].iterations = iterations;
+		m_maxIterations = maxIterations;
+		m_budgetType = Iterations;
+	}
+
 	/// Evaluate the cross-validation error:
 	/// train sub-models, evaluate objective,
 	/// return the average.
-	double eval(RealVector const& parameters) const {
-		this->m_evaluationCounter++;
-		mep_meta->setParameterVector(parameters);
+	double evalBudgeted(RealVector const& parameters, double budget) const {
+		SHARK_RUNTIME_CHECK(budget > 0 && budget <= 1, "The budget must be in (0,1]");
+		SHARK_CRITICAL_REGION{
+			this->m_evaluationCounter++;
+		}
 
+		std::size_t folds = m_folds.size();
+		if(m_budgetType == Folds)
+			folds = budgetedSize(folds, budget);
+		std::vector<double> errors(folds);
+		if(numberOfWorkers() == 1){
+			for (std::size_t setID=0; setID != folds; ++setID) {
+				errors[setID] = evalFold(setID, parameters, budget);
+			}
+		}else{
+			//exceptions must not leave the parallel region, they are rethrown afterwards
+			std::vector<std::exception_ptr> exceptions(folds);
+			SHARK_PARALLEL_FOR_DYNAMIC(int setID = 0; setID < (int)folds; ++setID){
+				try{
+					errors[setID] = evalFold(setID, parameters, budget);
+				}catch(...){
+					exceptions[setID] = std::current_exception();
+				}
+			}
+			for(std::size_t setID = 0; setID != folds; ++setID){
+				if(exceptions[setID])
+					std::rethrow_exception(exceptions[setID]);
+			}
+		}
 		double ret = 0.0;
-		for (size_t setID=0; setID != m_folds.size(); ++setID) {
-			DatasetType train =  m_folds.training(setID);
-			DatasetType validation =  m_folds.validation(setID);
-			mep_trainer->train(*mep_model, train);
-			Data<OutputType> output = (*mep_model)(validation.inputs());
-			ret += mep_cost->eval(validation.labels(), output);
+		for (std::size_t setID=0; setID != folds; ++setID) {
+			ret += errors[setID];
 		}
-		return ret / m_folds.size();
+		return ret / folds;
 	}
 };
 
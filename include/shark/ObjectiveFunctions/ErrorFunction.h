@@ -58,6 +58,17 @@ namespace shark{
 /// It automatically infers the input und label type from the given dataset and the output type
 /// of the model in the constructor and ensures that Model and loss match. Thus the user does
 /// not need to provide the types as template parameters. 
+///
+///\par
+/// Non-sequential models are evaluated in parallel over the batches of the dataset.
+/// The partial sums are combined in a fixed order, so the value and the derivative are
+/// bitwise identical for every number of threads.
+///
+///\par
+/// For training on several processes, every process creates an ErrorFunction on its
+/// part of the data and sets the same kind of AbstractReducer. The reducer sums the
+/// errors, gradients and number of points over the processes, so that every process
+/// evaluates the error on the whole dataset.
 class ErrorFunction : public SingleObjectiveFunction
 {
 public:
@@ -82,8 +93,23 @@ public:
 	void setRegularizer(double factor, SingleObjectiveFunction* regularizer){
 		m_regularizer = regularizer;
 		m_regularizationStrength = factor;
+		//hessian vector products are only available if the regularizer supports them as well
+		m_features = mp_wrapper -> features();
+		if(regularizer && !regularizer->hasHessianVectorProduct())
+			m_features.reset(HAS_HESSIAN_VECTOR_PRODUCT);
 	}
 
+	/// \brief Sets the reducer combining the results of several processes.
+	///
+	/// The reducer is not owned by the error function. NULL disables the reduction.
+	void setReducer(AbstractReducer* reducer);
+
+	/// \brief Resets the evaluation counter and drops the cached model states.
+	///
+	/// The states are created again automatically when the number of parameters of the model changes.
+	/// Other changes of the model structure after the first evaluation require a call to init.
+	void init();
+
 	SearchPointType proposeStartingPoint()const {
 		return mp_wrapper -> proposeStartingPoint();
 	}
@@ -94,6 +120,13 @@ public:
 	double eval(RealVector const& input) const;
 	ResultType evalDerivative( const SearchPointType & input, FirstOrderDerivative & derivative ) const;
 	
+	/// \brief Computes the product of the Hessian of the error with a vector.
+	///
+	/// The product is exact and computed without forming the Hessian, using the directional derivatives of the model
+	/// (see AbstractModel::weightedParameterHessianVectorProduct). Its cost is about two gradient evaluations.
+	/// It is available when the model and the loss support it, e.g. for FFNet and LinearModel with SquaredLoss or CrossEntropy.
+	void evalHessianVectorProduct( SearchPointType const& input, SearchPointType const& vector, SearchPointType& result ) const;
+	
 	friend void swap(ErrorFunction& op1, ErrorFunction& op2);
 
 private:
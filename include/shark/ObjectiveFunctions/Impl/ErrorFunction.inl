@@ -33,6 +33,143 @@
 namespace shark{
 namespace detail{
 
+///\brief Maximum number of chunks into which the batches are grouped by deterministicBatchSum.
+///
+/// Every chunk holds its own result buffer, so this trades memory against load balance.
+/// It only bounds the parallelism on machines with more threads than this.
+static const std::size_t errorFunctionMaxChunks = 256;
+
+///\brief Number of chunks used by deterministicBatchSum for the given number of batches.
+///
+/// Every batch forms its own chunk up to errorFunctionMaxChunks. The number depends only on the data, never on the threads.
+inline std::size_t errorFunctionChunks(std::size_t numBatches){
+	return std::min(numBatches, errorFunctionMaxChunks);
+}
+
+///\brief Sums results over the batches of a dataset in parallel, independently of the number of threads.
+///
+/// The batches are grouped into errorFunctionChunks(numBatches) contiguous chunks with about the same number of elements.
+/// The chunks are scheduled dynamically, so that uneven batches or threads do not stall the computation.
+/// Every chunk is summed in batch order into its own buffer and the buffers are combined by a
+/// pairwise tree in a fixed order. Thus the result is bitwise identical for every number of threads.
+///
+/// \param batchSizes number of elements in every batch
+/// \param bufferSize size of the result
+/// \param chunkFunction called as chunkFunction(chunk, start, end, buffer), adds the results of the batches [start,end) to buffer.
+///                      Calls with different chunk indices may run concurrently, calls with the same index never do.
+template<class ChunkFunction>
+RealVector deterministicBatchSum(std::vector<std::size_t> const& batchSizes, std::size_t bufferSize, ChunkFunction const& chunkFunction){
+	std::size_t numBatches = batchSizes.size();
+	std::size_t numChunks = errorFunctionChunks(numBatches);
+	if(numChunks == 0)
+		return RealVector(bufferSize,0.0);
+
+	//chunk c ends with the first batch at which c+1 chunks worth of elements are reached
+	std::size_t numElements = 0;
+	for(std::size_t b = 0; b != numBatches; ++b)
+		numElements += batchSizes[b];
+	std::vector<std::size_t> chunkStart(numChunks+1, numBatches);
+	chunkStart[0] = 0;
+	std::size_t chunk = 1;
+	std::size_t elements = 0;
+	for(std::size_t b = 0; b != numBatches && chunk != numChunks; ++b){
+		elements += batchSizes[b];
+		if(elements * numChunks >= chunk * numElements){
+			chunkStart[chunk] = b+1;
+			++chunk;
+		}
+	}
+
+	std::vector<RealVector> buffers(numChunks);
+	SHARK_PARALLEL_FOR_DYNAMIC(int ci = 0; ci < (int)numChunks; ++ci){//MSVC does not support unsigned integrals in paralll loops
+		buffers[ci] = RealVector(bufferSize,0.0);
+		chunkFunction(ci, chunkStart[ci], chunkStart[ci+1], buffers[ci]);
+	}
+	for(std::size_t stride = 1; stride < numChunks; stride *= 2){
+		for(std::size_t i = 0; i + stride < numChunks; i += 2 * stride){
+			noalias(buffers[i]) += buffers[i + stride];
+		}
+	}
+	return buffers[0];
+}
+
+///\brief Sums the total weight and the sums of error and gradient over all processes of the reducer.
+inline void reduceErrorSums(AbstractReducer* reducer, double& weight, RealVector& sums){
+	if(!reducer) return;
+	RealVector buffer(sums.size()+1);
+	buffer(0) = weight;
+	noalias(subrange(buffer,1,buffer.size())) = sums;
+	reducer->allReduce(buffer);
+	weight = buffer(0);
+	noalias(sums) = subrange(buffer,1,buffer.size());
+}
+
+///\brief Buffers used for the evaluation of one chunk of batches.
+///
+/// The error functions keep one workspace per chunk between evaluations, so that
+/// the model state and the intermediate results are only reallocated when the batch size grows.
+/// Copies start with empty buffers, thus copies of an error function never share a state.
+/// The state is created again when the number of parameters of the model changes and
+/// dropped by ErrorFunction::init, which must be called after other changes of the model structure.
+template<class OutputType>
+struct ErrorFunctionWorkspace{
+	boost::shared_ptr<State> state;
+	std::size_t stateParameters; ///< number of parameters of the model when the state was created
+	typename Batch<OutputType>::type prediction;
+	typename Batch<OutputType>::type errorDerivative;
+	typename Batch<OutputType>::type predictionDerivative; ///< derivative of the predictions in a direction of the parameters
+	typename Batch<OutputType>::type errorDerivativeDerivative; ///< derivative of errorDerivative in the same direction
+	RealVector gradient;
+
+	ErrorFunctionWorkspace():stateParameters(0){}
+	ErrorFunctionWorkspace(ErrorFunctionWorkspace const&):stateParameters(0){}
+	ErrorFunctionWorkspace& operator=(ErrorFunctionWorkspace const&){
+		return *this;
+	}
+
+	template<class Model>
+	State& modelState(Model const& model){
+		if(!state || stateParameters != model.numberOfParameters()){
+			state = model.createState();
+			stateParameters = model.numberOfParameters();
+		}
+		return *state;
+	}
+
+	///\brief Drops the model state, it is created again by the next call to modelState.
+	void reset(){
+		state.reset();
+	}
+};
+
+///\brief Computes the product of the Hessian of the loss on a batch with a direction in parameter space.
+///
+/// The derivative of the predictions in the direction is multiplied with the Hessian of the loss
+/// and backpropagated together with the derivative of the loss. The result is stored in workspace.gradient.
+template<class Model, class Loss, class InputBatch, class LabelBatch, class OutputType>
+void batchHessianVectorProduct(
+	Model const& model, Loss const& loss,
+	InputBatch const& inputs, LabelBatch const& labels,
+	RealVector const& direction, ErrorFunctionWorkspace<OutputType>& workspace
+){
+	State& state = workspace.modelState(model);
+	model.eval(inputs, workspace.prediction, state);
+	loss.evalDerivative(labels, workspace.prediction, workspace.errorDerivative);
+	model.parameterDirectionalDerivative(inputs, direction, state, workspace.predictionDerivative);
+	loss.evalHessianVectorProduct(labels, workspace.prediction, workspace.predictionDerivative, workspace.errorDerivativeDerivative);
+	model.weightedParameterHessianVectorProduct(
+		inputs, workspace.errorDerivative, workspace.errorDerivativeDerivative,
+		direction, state, workspace.gradient
+	);
+}
+
+template<class Dataset>
+std::vector<std::size_t> batchSizes(Dataset const& dataset){
+	std::vector<std::size_t> sizes(dataset.numberOfBatches());
+	for(std::size_t b = 0; b != sizes.size(); ++b)
+		sizes[b] = batchSize(dataset.batch(b));
+	return sizes;
+}
 
 ///\brief Implementation of the ErrorFunction using AbstractLoss.
 template<class InputType, class LabelType,class OutputType>
@@ -42,12 +179,14 @@ public:
 		LabeledData<InputType, LabelType> const& dataset,
 		AbstractModel<InputType,OutputType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss
-	):mep_model(model),mep_loss(loss),m_dataset(dataset){
+	):mep_model(model),mep_loss(loss),mep_reducer(NULL),m_dataset(dataset),m_workspace(1){
 		SHARK_ASSERT(model!=NULL);
 		SHARK_ASSERT(loss!=NULL);
 
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
 			m_features|=HAS_FIRST_DERIVATIVE;
+		if(mep_model->hasParameterHessianVectorProduct() && mep_loss->hasFirstDerivative() && mep_loss->hasHessianVectorProduct())
+			m_features|=HAS_HESSIAN_VECTOR_PRODUCT;
 		m_features|=CAN_PROPOSE_STARTING_POINT;
 	}
 
@@ -66,6 +205,16 @@ public:
 		return new ErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
 	}
 
+	void init(){
+		SingleObjectiveFunction::init();
+		for(std::size_t i = 0; i != m_workspace.size(); ++i)
+			m_workspace[i].reset();
+	}
+
+	void setReducer(AbstractReducer* reducer){
+		mep_reducer = reducer;
+	}
+
 	double eval(RealVector const& input) const {
 		mep_model->setParameterVector(input);
 
@@ -73,14 +222,15 @@ public:
 	}
 	
 	double evalPointSet() const {
-		std::size_t dataSize = m_dataset.numberOfElements();
-		typename Batch<OutputType>::type prediction;
-		double error = 0.0;
+		double dataSize = m_dataset.numberOfElements();
+		ErrorFunctionWorkspace<OutputType>& workspace = m_workspace[0];
+		RealVector error(1,0.0);
 		for(auto const& batch: m_dataset.batches()){
-			mep_model->eval(batch.input, prediction);
-			error += mep_loss->eval(batch.label, prediction);
+			mep_model->eval(batch.input, workspace.prediction, workspace.modelState(*mep_model));
+			error(0) += mep_loss->eval(batch.label, workspace.prediction);
 		}
-		return error/dataSize;
+		reduceErrorSums(mep_reducer, dataSize, error);
+		return error(0)/dataSize;
 	}
 
 	ResultType evalDerivative( SearchPointType const& point, FirstOrderDerivative& derivative ) const {
@@ -89,40 +239,56 @@ public:
 	}
 	
 	ResultType evalDerivativePointSet( FirstOrderDerivative & derivative ) const {
-		std::size_t dataSize = m_dataset.numberOfElements();
-		derivative.resize(mep_model->numberOfParameters());
-		derivative.clear();
-
-		typename Batch<OutputType>::type prediction;
-		RealVector dataGradient(mep_model->numberOfParameters());
-		typename Batch<OutputType>::type errorDerivative;
+		double dataSize = m_dataset.numberOfElements();
+		std::size_t numParameters = mep_model->numberOfParameters();
+		ErrorFunctionWorkspace<OutputType>& workspace = m_workspace[0];
+		State& state = workspace.modelState(*mep_model);
 
-		double error=0.0;
-		boost::shared_ptr<State> state = mep_model->createState();
+		//sums(0) holds the error, the remaining entries the gradient
+		RealVector sums(1 + numParameters, 0.0);
 		for(auto const& batch: m_dataset.batches()){
 			// calculate model output for the batch as well as the derivative
-			mep_model->eval(batch.input, prediction,*state);
+			mep_model->eval(batch.input, workspace.prediction,state);
 
 			// calculate error derivative of the loss function
-			error += mep_loss->evalDerivative(batch.label, prediction,errorDerivative);
+			sums(0) += mep_loss->evalDerivative(batch.label, workspace.prediction,workspace.errorDerivative);
 
 			//calculate the gradient using the chain rule
-			mep_model->weightedParameterDerivative(batch.input,errorDerivative,*state,dataGradient);
-			derivative+=dataGradient;
+			mep_model->weightedParameterDerivative(batch.input,workspace.errorDerivative,state,workspace.gradient);
+			noalias(subrange(sums,1,sums.size())) += workspace.gradient;
+		}
+		reduceErrorSums(mep_reducer, dataSize, sums);
+		derivative = subrange(sums,1,sums.size()) / dataSize;
+		return sums(0) / dataSize;
+	}
+
+	void evalHessianVectorProduct( SearchPointType const& point, SearchPointType const& direction, SearchPointType& result ) const {
+		mep_model->setParameterVector(point);
+		double dataSize = m_dataset.numberOfElements();
+		SIZE_CHECK(direction.size() == mep_model->numberOfParameters());
+		ErrorFunctionWorkspace<OutputType>& workspace = m_workspace[0];
+		RealVector sums(direction.size(), 0.0);
+		for(auto const& batch: m_dataset.batches()){
+			batchHessianVectorProduct(*mep_model, *mep_loss, batch.input, batch.label, direction, workspace);
+			noalias(sums) += workspace.gradient;
 		}
-		error /= dataSize;
-		derivative /= double(dataSize);
-		return error;
+		reduceErrorSums(mep_reducer, dataSize, sums);
+		result = sums / dataSize;
 	}
 
 private:
 	AbstractModel<InputType, OutputType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
+	AbstractReducer* mep_reducer;
 	LabeledData<InputType, LabelType> m_dataset;
+	mutable std::vector<ErrorFunctionWorkspace<OutputType> > m_workspace;
 };
 
 
 ///\brief Implementation of the ErrorFunction using AbstractLoss for parallelizable computations
+///
+/// The batches are processed in parallel by deterministicBatchSum, thus the
+/// result does not depend on the number of threads.
 template<class InputType, class LabelType,class OutputType>
 class ParallelErrorFunctionImpl:public FunctionWrapperBase{
 public:
@@ -131,12 +297,15 @@ public:
 		LabeledData<InputType,LabelType> const& dataset,
 		AbstractModel<InputType,OutputType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss
-	):mep_model(model),mep_loss(loss),m_dataset(dataset){
+	):mep_model(model),mep_loss(loss),mep_reducer(NULL),m_dataset(dataset),m_batchSizes(batchSizes(dataset))
+	,m_workspaces(errorFunctionChunks(m_batchSizes.size())){
 		SHARK_ASSERT(model!=NULL);
 		SHARK_ASSERT(loss!=NULL);
 
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
 			m_features|=HAS_FIRST_DERIVATIVE;
+		if(mep_model->hasParameterHessianVectorProduct() && mep_loss->hasFirstDerivative() && mep_loss->hasHessianVectorProduct())
+			m_features|=HAS_HESSIAN_VECTOR_PRODUCT;
 		m_features|=CAN_PROPOSE_STARTING_POINT;
 	}
 
@@ -155,68 +324,78 @@ public:
 		return new ParallelErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
 	}
 
+	void init(){
+		SingleObjectiveFunction::init();
+		for(std::size_t i = 0; i != m_workspaces.size(); ++i)
+			m_workspaces[i].reset();
+	}
+
+	void setReducer(AbstractReducer* reducer){
+		mep_reducer = reducer;
+	}
+
 	double eval(RealVector const& input) const {
 		mep_model->setParameterVector(input);
 
-		std::size_t numBatches = m_dataset.numberOfBatches();
-		std::size_t numElements = m_dataset.numberOfElements();
-		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
-		//calculate optimal partitioning
-		std::size_t batchesPerThread = numBatches/numThreads;
-		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
-		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
-			std::size_t t = ti;
-			//get start and end index of batch-range
-			std::size_t start = t*batchesPerThread+std::min(t,leftOver);
-			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
-			LabeledData<InputType, LabelType> threadData = rangeSubset(m_dataset,start,end);//threadsafe!
-			ErrorFunctionImpl<InputType,LabelType,OutputType> errorFunc(threadData,mep_model,mep_loss);
-			double threadError = errorFunc.evalPointSet();//threadsafe!
-			//we need to weight the error and derivativs with the number of samples in the split.
-			double weightFactor = double(threadData.numberOfElements())/numElements;
-			SHARK_CRITICAL_REGION{
-				error += weightFactor * threadError;
+		double dataSize = m_dataset.numberOfElements();
+		RealVector error = deterministicBatchSum(m_batchSizes, 1, [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			State& state = workspace.modelState(*mep_model);
+			for(std::size_t b = start; b != end; ++b){
+				mep_model->eval(m_dataset.batch(b).input, workspace.prediction, state);
+				sum(0) += mep_loss->eval(m_dataset.batch(b).label, workspace.prediction);
 			}
-		}
-		return error;
+		});
+		reduceErrorSums(mep_reducer, dataSize, error);
+		return error(0) / dataSize;
 	}
 
 	ResultType evalDerivative( const SearchPointType & point, FirstOrderDerivative & derivative ) const {
 		mep_model->setParameterVector(point);
-		derivative.resize(mep_model->numberOfParameters());
-		derivative.clear();
 		
-		std::size_t numBatches = m_dataset.numberOfBatches();
-		std::size_t numElements = m_dataset.numberOfElements();
-		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
-		//calculate optimal partitioning
-		std::size_t batchesPerThread = numBatches/numThreads;
-		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
-		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
-			std::size_t t = ti;
-			FirstOrderDerivative threadDerivative;
-			//get start and end index of batch-range
-			std::size_t start = t*batchesPerThread+std::min(t,leftOver);
-			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
-			LabeledData<InputType, LabelType> threadData = rangeSubset(m_dataset,start,end);//threadsafe!
-			ErrorFunctionImpl<InputType,LabelType,OutputType> errorFunc(threadData,mep_model,mep_loss);
-			double threadError = errorFunc.evalDerivativePointSet(threadDerivative);//threadsafe!
-			//we need to weight the error and derivativs with the number of samples in the split.
-			double weightFactor = double(threadData.numberOfElements())/numElements;
-			SHARK_CRITICAL_REGION{
-				error += weightFactor*threadError;
-				noalias(derivative) += weightFactor*threadDerivative;
+		double dataSize = m_dataset.numberOfElements();
+		std::size_t numParameters = mep_model->numberOfParameters();
+		//sums(0) holds the error, the remaining entries the gradient
+		RealVector sums = deterministicBatchSum(m_batchSizes, 1 + numParameters, [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			State& state = workspace.modelState(*mep_model);
+			auto gradient = subrange(sum,1,sum.size());
+			for(std::size_t b = start; b != end; ++b){
+				auto const& batch = m_dataset.batch(b);
+				mep_model->eval(batch.input, workspace.prediction,state);
+				sum(0) += mep_loss->evalDerivative(batch.label, workspace.prediction,workspace.errorDerivative);
+				mep_model->weightedParameterDerivative(batch.input,workspace.errorDerivative,state,workspace.gradient);
+				noalias(gradient) += workspace.gradient;
 			}
-		}
-		return error;
+		});
+		reduceErrorSums(mep_reducer, dataSize, sums);
+		derivative = subrange(sums,1,sums.size()) / dataSize;
+		return sums(0) / dataSize;
+	}
+
+	void evalHessianVectorProduct( SearchPointType const& point, SearchPointType const& direction, SearchPointType& result ) const {
+		mep_model->setParameterVector(point);
+		double dataSize = m_dataset.numberOfElements();
+		SIZE_CHECK(direction.size() == mep_model->numberOfParameters());
+		RealVector sums = deterministicBatchSum(m_batchSizes, direction.size(), [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			for(std::size_t b = start; b != end; ++b){
+				auto const& batch = m_dataset.batch(b);
+				batchHessianVectorProduct(*mep_model, *mep_loss, batch.input, batch.label, direction, workspace);
+				noalias(sum) += workspace.gradient;
+			}
+		});
+		reduceErrorSums(mep_reducer, dataSize, sums);
+		result = sums / dataSize;
 	}
 
 protected:
 	AbstractModel<InputType, OutputType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
+	AbstractReducer* mep_reducer;
 	LabeledData<InputType, LabelType> m_dataset;
+	std::vector<std::size_t> m_batchSizes;
+	mutable std::vector<ErrorFunctionWorkspace<OutputType> > m_workspaces;
 };
 
 
@@ -228,12 +407,15 @@ public:
 		WeightedLabeledData<InputType, LabelType> const& dataset,
 		AbstractModel<InputType,OutputType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss
-	):mep_model(model),mep_loss(loss),m_dataset(dataset){
+	):mep_model(model),mep_loss(loss),mep_reducer(NULL),m_dataset(dataset),m_batchSizes(batchSizes(dataset))
+	,m_workspaces(errorFunctionChunks(m_batchSizes.size())){
 		SHARK_ASSERT(model!=NULL);
 		SHARK_ASSERT(loss!=NULL);
 
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
 			m_features|=HAS_FIRST_DERIVATIVE;
+		if(mep_model->hasParameterHessianVectorProduct() && mep_loss->hasFirstDerivative() && mep_loss->hasHessianVectorProduct())
+			m_features|=HAS_HESSIAN_VECTOR_PRODUCT;
 		m_features|=CAN_PROPOSE_STARTING_POINT;
 	}
 
@@ -252,73 +434,119 @@ public:
 		return new WeightedErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
 	}
 
+	void init(){
+		SingleObjectiveFunction::init();
+		for(std::size_t i = 0; i != m_workspaces.size(); ++i)
+			m_workspaces[i].reset();
+	}
+
+	void setReducer(AbstractReducer* reducer){
+		mep_reducer = reducer;
+	}
+
 	double eval(RealVector const& input) const {
 		mep_model->setParameterVector(input);
 
 		double sumWeights = sumOfWeights(m_dataset);
-		double error = 0.0;
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_dataset.numberOfBatches(); ++i){
-			auto const& weights = m_dataset.batch(i).weight;
-			auto const& data = m_dataset.batch(i).data;
-			
-			//create model prediction
-			auto prediction = (*mep_model)(data.input);
-			
-			//sum up weighted loss
-			double batchError = 0.0;
-			for(std::size_t j = 0; j != data.size(); ++j){
-				batchError += weights(j) * mep_loss->eval(getBatchElement(data.label,j), getBatchElement(prediction,j));
+		RealVector error = deterministicBatchSum(m_batchSizes, 1, [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			State& state = workspace.modelState(*mep_model);
+			auto const& prediction = workspace.prediction;
+			for(std::size_t i = start; i != end; ++i){
+				auto const& weights = m_dataset.batch(i).weight;
+				auto const& data = m_dataset.batch(i).data;
+				
+				//create model prediction
+				mep_model->eval(data.input, workspace.prediction, state);
+				
+				//sum up weighted loss
+				for(std::size_t j = 0; j != data.size(); ++j){
+					sum(0) += weights(j) * mep_loss->eval(getBatchElement(data.label,j), getBatchElement(prediction,j));
+				}
 			}
-			SHARK_CRITICAL_REGION{
-				error+= batchError;
-			}
-		}
-		return error/sumWeights;
+		});
+		reduceErrorSums(mep_reducer, sumWeights, error);
+		return error(0)/sumWeights;
 	}
 
 	ResultType evalDerivative( SearchPointType const& point, FirstOrderDerivative& derivative ) const {
 		mep_model->setParameterVector(point);
 		double sumWeights = sumOfWeights(m_dataset);
-		derivative.resize(mep_model->numberOfParameters());
-		derivative.clear();
+		std::size_t numParameters = mep_model->numberOfParameters();
 		
-		
-		double error = 0.0;
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_dataset.numberOfBatches(); ++i){
-			auto const& weights = m_dataset.batch(i).weight;
-			auto const& data = m_dataset.batch(i).data;
-			
-			// calculate model output for the batch as well as the derivative
-			typename Batch<OutputType>::type prediction;
-			boost::shared_ptr<State> state = mep_model->createState();
-			mep_model->eval(data.input, prediction,*state);
-			
-			//compute  weighted loss and its derivative for every element in its batch
-			typename Batch<OutputType>::type errorDerivative(prediction.size1(),prediction.size2());
+		//sums(0) holds the error, the remaining entries the gradient
+		RealVector sums = deterministicBatchSum(m_batchSizes, 1 + numParameters, [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			State& state = workspace.modelState(*mep_model);
+			auto const& prediction = workspace.prediction;
+			auto& errorDerivative = workspace.errorDerivative;
+			auto gradient = subrange(sum,1,sum.size());
 			OutputType singleDerivative;
-			double batchError = 0.0;
-			for(std::size_t j = 0; j != data.size(); ++j){
-				batchError += weights(j) * mep_loss->evalDerivative(getBatchElement(data.label,j), getBatchElement(prediction,j), singleDerivative);
-				noalias(row(errorDerivative,j) ) = weights(j) * singleDerivative;
+			for(std::size_t i = start; i != end; ++i){
+				auto const& weights = m_dataset.batch(i).weight;
+				auto const& data = m_dataset.batch(i).data;
+				
+				// calculate model output for the batch as well as the derivative
+				mep_model->eval(data.input, workspace.prediction,state);
+				
+				//compute  weighted loss and its derivative for every element in its batch
+				errorDerivative.resize(prediction.size1(),prediction.size2());
+				for(std::size_t j = 0; j != data.size(); ++j){
+					sum(0) += weights(j) * mep_loss->evalDerivative(getBatchElement(data.label,j), getBatchElement(prediction,j), singleDerivative);
+					noalias(row(errorDerivative,j) ) = weights(j) * singleDerivative;
+				}
+				
+				//calculate the gradient using the chain rule
+				mep_model->weightedParameterDerivative(data.input,errorDerivative,state,workspace.gradient);
+				noalias(gradient) += workspace.gradient;
 			}
-			
-			//calculate the gradient using the chain rule
-			RealVector dataGradient(mep_model->numberOfParameters());
-			mep_model->weightedParameterDerivative(data.input,errorDerivative,*state,dataGradient);
-			SHARK_CRITICAL_REGION{
-				derivative += dataGradient;
-				error += batchError;
+		});
+		reduceErrorSums(mep_reducer, sumWeights, sums);
+		derivative = subrange(sums,1,sums.size()) / sumWeights;
+		return sums(0) / sumWeights;
+	}
+
+	void evalHessianVectorProduct( SearchPointType const& point, SearchPointType const& direction, SearchPointType& result ) const {
+		mep_model->setParameterVector(point);
+		double sumWeights = sumOfWeights(m_dataset);
+		SIZE_CHECK(direction.size() == mep_model->numberOfParameters());
+		RealVector sums = deterministicBatchSum(m_batchSizes, direction.size(), [&](std::size_t chunk, std::size_t start, std::size_t end, RealVector& sum){
+			ErrorFunctionWorkspace<OutputType>& workspace = m_workspaces[chunk];
+			State& state = workspace.modelState(*mep_model);
+			auto& errorDerivative = workspace.errorDerivative;
+			auto& errorDerivativeDerivative = workspace.errorDerivativeDerivative;
+			for(std::size_t i = start; i != end; ++i){
+				auto const& weights = m_dataset.batch(i).weight;
+				auto const& data = m_dataset.batch(i).data;
+				
+				mep_model->eval(data.input, workspace.prediction, state);
+				mep_loss->evalDerivative(data.label, workspace.prediction, errorDerivative);
+				mep_model->parameterDirectionalDerivative(data.input, direction, state, workspace.predictionDerivative);
+				mep_loss->evalHessianVectorProduct(data.label, workspace.prediction, workspace.predictionDerivative, errorDerivativeDerivative);
+				
+				//the loss of every point is weighted, and so are its derivatives
+				for(std::size_t j = 0; j != data.size(); ++j){
+					noalias(row(errorDerivative,j)) *= weights(j);
+					noalias(row(errorDerivativeDerivative,j)) *= weights(j);
+				}
+				mep_model->weightedParameterHessianVectorProduct(
+					data.input, errorDerivative, errorDerivativeDerivative,
+					direction, state, workspace.gradient
+				);
+				noalias(sum) += workspace.gradient;
 			}
-		}
-		error /= sumWeights;
-		derivative /= sumWeights;
-		return error;
+		});
+		reduceErrorSums(mep_reducer, sumWeights, sums);
+		result = sums / sumWeights;
 	}
 
 private:
 	AbstractModel<InputType, OutputType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
+	AbstractReducer* mep_reducer;
 	WeightedLabeledData<InputType, LabelType> m_dataset;
+	std::vector<std::size_t> m_batchSizes;
+	mutable std::vector<ErrorFunctionWorkspace<OutputType> > m_workspaces;
 };
 
 } // namespace detail
@@ -337,8 +565,9 @@ inline ErrorFunction::ErrorFunction(
 	AbstractLoss<LabelType, OutputType>* loss
 ){
 	m_regularizer = 0;
-	//non sequential models can be parallelized
-	if(model->isSequential() || SHARK_NUM_THREADS == 1)
+	//non sequential models can be parallelized. The parallel implementation is also used
+	//for a single thread, as its results do not depend on the number of threads.
+	if(model->isSequential())
 		mp_wrapper.reset(new detail::ErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss));
 	else
 		mp_wrapper.reset(new detail::ParallelErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss));
@@ -369,6 +598,15 @@ inline ErrorFunction& ErrorFunction::operator = (const ErrorFunction& op){
 	return *this;
 }
 
+inline void ErrorFunction::setReducer(AbstractReducer* reducer){
+	mp_wrapper->setReducer(reducer);
+}
+
+inline void ErrorFunction::init(){
+	SingleObjectiveFunction::init();
+	mp_wrapper->init();
+}
+
 inline double ErrorFunction::eval(RealVector const& input) const{
 	++m_evaluationCounter;
 	double value = mp_wrapper -> eval(input);
@@ -387,5 +625,15 @@ inline ErrorFunction::ResultType ErrorFunction::evalDerivative( const SearchPoin
 	}
 	return value;
 }
+
+inline void ErrorFunction::evalHessianVectorProduct( SearchPointType const& input, SearchPointType const& vector, SearchPointType& result ) const{
+	SHARK_RUNTIME_CHECK(hasHessianVectorProduct(), "[ErrorFunction::evalHessianVectorProduct] model, loss or regularizer do not support hessian vector products");
+	mp_wrapper -> evalHessianVectorProduct(input,vector,result);
+	if(m_regularizer){
+		SearchPointType regularizerProduct;
+		m_regularizer->evalHessianVectorProduct(input,vector,regularizerProduct);
+		noalias(result) += m_regularizationStrength*regularizerProduct;
+	}
+}
 }
 #endif
@@ -33,6 +33,7 @@
 #define SHARK_OBJECTIVEFUNCTIONS_IMPL_FUNCTIONWRAPPERBASE_H
 
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/ObjectiveFunctions/AbstractReducer.h>
 
 namespace shark{
 
@@ -41,6 +42,11 @@ namespace detail{
 class FunctionWrapperBase: public SingleObjectiveFunction{
 public:
 	virtual FunctionWrapperBase* clone()const = 0;
+
+	/// \brief Sets the reducer combining the partial sums with other processes.
+	virtual void setReducer(AbstractReducer* reducer){
+		SHARK_RUNTIME_CHECK(reducer == NULL, "[FunctionWrapperBase::setReducer] reducers are not supported by this function");
+	}
 };
 }
 }
@@ -139,6 +139,23 @@ public:
 		return 0.0;  // dead code, prevent warning
 	}
 
+	/// \brief computes the product of the hessian of the loss w.r.t. the prediction with a direction for every element of a batch
+	///
+	/// \par
+	/// The default implementations throws an exception.
+	/// If you overwrite this method, don't forget to set
+	/// the flag HAS_HESSIAN_VECTOR_PRODUCT.
+	/// \param  target      target values
+	/// \param  prediction  predictions, typically made by a model
+	/// \param  direction   the direction for every prediction
+	/// \param  result      the product of the hessian of every element with its direction
+	virtual void evalHessianVectorProduct(
+		BatchLabelType const& target, BatchOutputType const& prediction,
+		BatchOutputType const& direction, BatchOutputType& result
+	) const{
+		SHARK_FEATURE_EXCEPTION_DERIVED(HAS_HESSIAN_VECTOR_PRODUCT);
+	}
+
 	//~ /// \brief evaluate the loss and fist and second derivative w.r.t. the prediction
 	//~ ///
 	//~ /// \par
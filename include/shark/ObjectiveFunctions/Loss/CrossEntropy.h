@@ -62,11 +62,21 @@ namespace shark{
  *
  * The class labels must be integers starting from 0. Also for theoretical reasons, the output neurons of a neural
  *  Network must be linear.
+ *
+ * The template argument is the vector type of the predictions, e.g. FloatVector for single precision models.
+ * The losses of the single patterns are summed in double precision. CrossEntropy is the
+ * double precision version.
  */
-class CrossEntropy : public AbstractLoss<unsigned int,RealVector>
+template<class VectorType>
+class BasicCrossEntropy : public AbstractLoss<unsigned int,VectorType>
 {
 private:
-	typedef AbstractLoss<unsigned int,RealVector> base_type;
+	typedef AbstractLoss<unsigned int,VectorType> base_type;
+	typedef typename base_type::ConstLabelReference ConstLabelReference;
+	typedef typename base_type::ConstOutputReference ConstOutputReference;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+	typedef typename base_type::MatrixType MatrixType;
+	typedef VectorType OutputType;
 
 	//uses different formula to compute the binary case for 1 output.
 	//should be numerically more stable
@@ -81,10 +91,11 @@ private:
 		return std::log(1+exponential);
 	}
 public:
-	CrossEntropy()
+	BasicCrossEntropy()
 	{
-		m_features |= HAS_FIRST_DERIVATIVE;
-		//~ m_features |= HAS_SECOND_DERIVATIVE;
+		this->m_features |= base_type::HAS_FIRST_DERIVATIVE;
+		this->m_features |= base_type::HAS_HESSIAN_VECTOR_PRODUCT;
+		//~ this->m_features |= base_type::HAS_SECOND_DERIVATIVE;
 	}
 
 
@@ -95,7 +106,7 @@ public:
 	// annoyingness of C++ templates
 	using base_type::eval;
 
-	double eval(UIntVector const& target, RealMatrix const& prediction) const {
+	double eval(UIntVector const& target, BatchOutputType const& prediction) const {
 		double error = 0;
 		for(std::size_t i = 0; i != prediction.size1(); ++i){
 			error += eval(target(i), row(prediction,i));
@@ -123,7 +134,7 @@ public:
 		}
 	}
 
-	double evalDerivative(UIntVector const& target, RealMatrix const& prediction, RealMatrix& gradient) const {
+	double evalDerivative(UIntVector const& target, BatchOutputType const& prediction, BatchOutputType& gradient) const {
 		gradient.resize(prediction.size1(),prediction.size2());
 		if ( prediction.size2() == 1 )
 		{
@@ -158,6 +169,36 @@ public:
 			return error;
 		}
 	}
+	/// \brief Multiplies the hessian of every element of the batch with its direction.
+	///
+	/// With the softmax probabilities p, the hessian is diag(p)-pp^T, which is applied without forming it.
+	/// In the binary case with one output, the hessian is \f$ \sigma(x)(1-\sigma(x))\f$.
+	void evalHessianVectorProduct(
+		UIntVector const& target, BatchOutputType const& prediction,
+		BatchOutputType const& direction, BatchOutputType& result
+	) const {
+		SIZE_CHECK(direction.size1() == prediction.size1());
+		SIZE_CHECK(direction.size2() == prediction.size2());
+		result.resize(prediction.size1(),prediction.size2());
+		if ( prediction.size2() == 1 )
+		{
+			for(std::size_t i = 0; i != prediction.size1(); ++i){
+				double sigmoid = 1.0/(1.0+std::exp(-prediction(i,0)));
+				result(i,0) = sigmoid * (1.0 - sigmoid) * direction(i,0);
+			}
+		}else{
+			for(std::size_t i = 0; i != prediction.size1(); ++i){
+				auto resultRow = row(result,i);
+				//compute the probabilities as in evalDerivative
+				double maximum = max(row(prediction,i));
+				noalias(resultRow) = exp(row(prediction,i) - maximum);
+				resultRow /= sum(resultRow);
+				double mean = inner_prod(resultRow,row(direction,i));
+				noalias(resultRow) *= row(direction,i) - mean;
+			}
+		}
+	}
+	
 	double evalDerivative(ConstLabelReference target, ConstOutputReference prediction, OutputType& gradient) const {
 		gradient.resize(prediction.size());
 		if ( prediction.size() == 1 )
@@ -223,6 +264,8 @@ public:
 	}
 };
 
+typedef BasicCrossEntropy<RealVector> CrossEntropy;
+
 
 }
 #endif
@@ -56,6 +56,7 @@ public:
 	SquaredLoss()
 	{
 		this->m_features|=base_type::HAS_FIRST_DERIVATIVE;
+		this->m_features|=base_type::HAS_HESSIAN_VECTOR_PRODUCT;
 	}
 
 
@@ -84,6 +85,17 @@ public:
 		noalias(gradient) = 2.0*(prediction - label);
 		return SquaredLoss::eval(label,prediction);
 	}
+
+	/// The hessian of the squared loss is twice the identity, thus the product is 2*direction.
+	void evalHessianVectorProduct(
+		BatchLabelType const&, BatchOutputType const& predictions,
+		BatchOutputType const& direction, BatchOutputType& result
+	) const {
+		SIZE_CHECK(direction.size1() == predictions.size1());
+		SIZE_CHECK(direction.size2() == predictions.size2());
+		result.resize(direction.size1(),direction.size2());
+		noalias(result) = 2.0*direction;
+	}
 };
 
 //specialisation for classification case.
@@ -99,6 +111,7 @@ public:
 	SquaredLoss()
 	{
 		this->m_features|=base_type::HAS_FIRST_DERIVATIVE;
+		this->m_features|=base_type::HAS_HESSIAN_VECTOR_PRODUCT;
 	}
 
 
@@ -133,6 +146,17 @@ public:
 		}
 		return SquaredLoss::eval(labels,predictions);
 	}
+
+	/// The hessian of the squared loss is twice the identity, thus the product is 2*direction.
+	void evalHessianVectorProduct(
+		BatchLabelType const&, BatchOutputType const& predictions,
+		BatchOutputType const& direction, BatchOutputType& result
+	) const {
+		SIZE_CHECK(direction.size1() == predictions.size1());
+		SIZE_CHECK(direction.size2() == predictions.size2());
+		result.resize(direction.size1(),direction.size2());
+		noalias(result) = 2.0*direction;
+	}
 };
 
 //spcialisation for sequence data
@@ -38,6 +38,7 @@
 
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/LinAlg/IterativeKernelSolver.h>
 
 #include <shark/LinAlg/Base.h>
 namespace shark {
@@ -62,6 +63,15 @@ namespace shark {
 /// The regularization parameter can be encoded in different ways.
 /// The exponential encoding is the proper choice for unconstraint optimization.
 /// Be careful not to mix up different encodings between trainer and evidence.
+///
+/// By default, the covariance matrix is stored and factorized, which takes
+/// O(n^2) memory and O(n^3) time per evaluation. With setIterativeSolver, a
+/// matrix-free estimate is computed instead: \f$ M^{-1} t \f$ is obtained by preconditioned
+/// conjugate gradients, \f$ \log \det M \f$ by stochastic Lanczos quadrature
+/// and the traces in the derivative by the Hutchinson estimator
+/// \f$ tr(M^{-1} A) \approx \frac 1 p \sum_l (M^{-1} v_l)^T A v_l \f$ with the same
+/// Rademacher probes \f$ v_l \f$. The probes are drawn once, so that the estimate is a smooth
+/// function of the parameters. The memory is O(n p).
 template<class InputType = RealVector, class OutputType = RealVector, class LabelType = RealVector>
 class NegativeGaussianProcessEvidence : public SingleObjectiveFunction
 {
@@ -79,6 +89,9 @@ public:
 	): m_dataset(dataset)
 	, mep_kernel(kernel)
 	, m_unconstrained(unconstrained)
+	, m_lanczosSteps(0)
+	, m_solverTolerance(0)
+	, m_preconditionerRank(0)
 	{
 		if (kernel->hasFirstParameterDerivative()) m_features |= HAS_FIRST_DERIVATIVE;
 		setThreshold(0.);
@@ -92,6 +105,22 @@ public:
 		return 1+ mep_kernel->numberOfParameters();
 	}
 
+	/// \brief Selects the matrix-free stochastic estimate of the evidence.
+	///
+	/// \param numberOfProbes number of probe vectors of the trace estimators, 0 selects the exact computation
+	/// \param lanczosSteps number of Lanczos steps for the log determinant
+	/// \param tolerance relative residual norm at which the conjugate gradient iteration stops
+	/// \param preconditionerRank number of landmarks of the Nystroem preconditioner, 0 selects the Jacobi preconditioner
+	void setIterativeSolver(
+		std::size_t numberOfProbes, std::size_t lanczosSteps = 30,
+		double tolerance = 1.e-6, std::size_t preconditionerRank = 0
+	){
+		m_probes = numberOfProbes == 0? RealMatrix() : rademacherProbes(m_dataset.numberOfElements(), numberOfProbes);
+		m_lanczosSteps = lanczosSteps;
+		m_solverTolerance = tolerance;
+		m_preconditionerRank = preconditionerRank;
+	}
+
 	/// Let \f$M\f$ denote the (kernel Gram) covariance matrix and
 	/// \f$t\f$ the label vector.  For the evidence we have: \f[ E= 1/2 \cdot [ -\log(\det(M)) - t^T M^{-1} t - N \log(2 \pi) ] \f]
 	double eval(const RealVector& parameters) const {
@@ -111,6 +140,10 @@ public:
 			betaInv = std::exp(betaInv); // for unconstraint optimization
 		mep_kernel->setParameterVector(kernelParams);
 		
+		if(m_probes.size2() != 0){
+			FirstOrderDerivative derivative;
+			return evalIterative(betaInv, derivative, false);
+		}
 		
 		//generate kernel matrix and label vector
 		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
@@ -161,6 +194,9 @@ public:
 			betaInv = std::exp(betaInv); // for unconstraint optimization
 		mep_kernel->setParameterVector(kernelParams);
 		
+		if(m_probes.size2() != 0){
+			return evalIterative(betaInv, derivative, true);
+		}
 		
 		//generate kernel matrix and label vector
 		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
@@ -233,6 +269,49 @@ public:
 		
 
 private:
+	/// \brief Matrix-free estimate of the negative evidence and its derivative.
+	double evalIterative(double betaInv, FirstOrderDerivative& derivative, bool computeDerivative)const{
+		std::size_t N  = m_dataset.numberOfElements();
+		std::size_t p = m_probes.size2();
+		RegularizedKernelOperator<InputType> M(mep_kernel, m_dataset.inputs(), betaInv);
+		RegularizedKernelPreconditioner<InputType> preconditioner(mep_kernel, m_dataset.inputs(), M, m_preconditionerRank);
+
+		//solve M [z, U] = [t, V]. Only the label system is needed for the evidence itself
+		RealMatrix rhs(N, computeDerivative? p+1 : 1);
+		noalias(column(rhs,0)) = column(createBatch<RealVector>(m_dataset.labels().elements()),0);
+		if(computeDerivative)
+			noalias(columns(rhs,1,p+1)) = m_probes;
+		RealMatrix solution;
+		conjugateGradientSolve(M, preconditioner, rhs, solution, m_solverTolerance);
+
+		double logDet = stochasticLogDeterminant(M, m_probes, m_lanczosSteps);
+		double e = 0.5 * (-logDet - inner_prod(column(rhs,0), column(solution,0)) - N * std::log(2.0 * M_PI));
+		if(!computeDerivative)
+			return -e;
+
+		//W = z z^T - 1/p sum_l u_l v_l^T, written as W = A B^T
+		RealMatrix A = solution;
+		RealMatrix B = solution;
+		columns(A,1,p+1) *= -1.0/p;
+		noalias(columns(B,1,p+1)) = m_probes;
+		RealVector kernelGradient = 0.5 * M.weightedParameterDerivative(A,B);
+
+		//dE/dC = 1/2 [ ||z||^2 - tr(M^{-1}) ]
+		double trace = 0;
+		for(std::size_t l = 0; l != p; ++l)
+			trace += inner_prod(column(m_probes,l), column(solution,l+1));
+		double betaInvDerivative = 0.5 * (norm_sqr(column(solution,0)) - trace / p);
+		if(m_unconstrained)
+			betaInvDerivative *= betaInv;
+
+		derivative.resize(kernelGradient.size() + 1);
+		blas::init(derivative)<<kernelGradient,betaInvDerivative;
+		derivative *= -1.0;
+		for(std::size_t i=0; i<derivative.size(); i++)
+			if(std::abs(derivative(i)) < m_derivativeThresholds(i)) derivative(i) = 0;
+		return -e;
+	}
+
 	/// pointer to external data set
 	DatasetType m_dataset;
 
@@ -246,6 +325,12 @@ private:
 	/// considered. This is useful for unconstraint
 	/// optimization. The default value is false.
 	bool m_unconstrained; 
+
+	/// Rademacher probes of the iterative estimate, empty if the exact computation is used
+	RealMatrix m_probes;
+	std::size_t m_lanczosSteps;
+	double m_solverTolerance;
+	std::size_t m_preconditionerRank;
 };
 
 
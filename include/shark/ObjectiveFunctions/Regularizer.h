@@ -157,6 +157,7 @@ public:
 	{
 		m_features|=HAS_FIRST_DERIVATIVE;
 		m_features|=HAS_SECOND_DERIVATIVE;
+		m_features|=HAS_HESSIAN_VECTOR_PRODUCT;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -213,6 +214,17 @@ public:
 		derivative.hessian = blas::identity_matrix<double>(input.size());
 		return 0.5 * norm_sqr(input);
 	}
+
+	/// Multiplies the (diagonal) Hessian with a vector.
+	virtual void evalHessianVectorProduct( SearchPointType const& input, SearchPointType const& vector, SearchPointType& result )const {
+		SIZE_CHECK(vector.size() == input.size());
+		if(m_mask.empty()){
+			result = vector;
+		}
+		else{
+			result = m_mask*vector;
+		}
+	}
 private:
 	std::size_t m_numberOfVariables;
 	RealVector m_mask;
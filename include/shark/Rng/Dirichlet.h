@@ -93,7 +93,7 @@ namespace shark{
 		friend std::basic_ostream<CharT,Traits>&
 			operator<<(std::basic_ostream<CharT,Traits>& os, const Dirichlet_distribution& d)
 		{
-			os << d.alphas.size();
+			os << d.alphas().size();
 			for(int i=0;i!=d.alphas_.size();++i)
 				os << d.alphas_[i];
 			return os;
@@ -41,6 +41,7 @@
 #include <shark/Unsupervised/RBM/GradientApproximations/ContrastiveDivergence.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/MultiChainApproximator.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/SingleChainApproximator.h>
+#include <shark/Unsupervised/RBM/GradientApproximations/ParallelChainApproximator.h>
 #include <shark/Rng/GlobalRng.h>
 namespace shark{
 
@@ -52,6 +53,8 @@ typedef TemperedMarkovChain<BinaryGibbsOperator> BinaryPTChain;
 typedef MultiChainApproximator<BinaryGibbsChain> BinaryPCD;
 typedef ContrastiveDivergence<BinaryGibbsOperator> BinaryCD;
 typedef SingleChainApproximator<BinaryPTChain> BinaryParallelTempering;
+typedef ParallelChainApproximator<BinaryGibbsChain> BinaryParallelPCD;
+typedef ParallelChainApproximator<BinaryPTChain> BinaryParallelPT;
 }
 
 #endif
@@ -41,6 +41,7 @@
 #include <shark/Unsupervised/RBM/GradientApproximations/ContrastiveDivergence.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/MultiChainApproximator.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/SingleChainApproximator.h>
+#include <shark/Unsupervised/RBM/GradientApproximations/ParallelChainApproximator.h>
 #include <shark/Rng/GlobalRng.h>
 namespace shark{
 
@@ -52,6 +53,8 @@ typedef TemperedMarkovChain<BipolarGibbsOperator> BipolarPTChain;
 typedef MultiChainApproximator<BipolarGibbsChain> BipolarPCD;
 typedef ContrastiveDivergence<BipolarGibbsOperator> BipolarCD;
 typedef SingleChainApproximator<BipolarPTChain> BipolarParallelTempering;
+typedef ParallelChainApproximator<BipolarGibbsChain> BipolarParallelPCD;
+typedef ParallelChainApproximator<BipolarPTChain> BipolarParallelPT;
 	
 }
 
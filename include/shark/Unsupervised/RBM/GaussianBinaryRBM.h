@@ -42,6 +42,7 @@
 #include <shark/Unsupervised/RBM/GradientApproximations/ContrastiveDivergence.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/MultiChainApproximator.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/SingleChainApproximator.h>
+#include <shark/Unsupervised/RBM/GradientApproximations/ParallelChainApproximator.h>
 #include <shark/Rng/GlobalRng.h>
 namespace shark{
 
@@ -53,6 +54,8 @@ typedef TemperedMarkovChain<GaussianBinaryGibbsOperator> GaussianBinaryPTChain;
 typedef MultiChainApproximator<GaussianBinaryGibbsChain> GaussianBinaryPCD;
 typedef ContrastiveDivergence<GaussianBinaryGibbsOperator> GaussianBinaryCD;
 typedef SingleChainApproximator<GaussianBinaryPTChain> GaussianBinaryParallelTempering;
+typedef ParallelChainApproximator<GaussianBinaryGibbsChain> GaussianBinaryParallelPCD;
+typedef ParallelChainApproximator<GaussianBinaryPTChain> GaussianBinaryParallelPT;
 }
 
 #endif
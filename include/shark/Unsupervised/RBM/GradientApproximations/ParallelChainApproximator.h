@@ -0,0 +1,271 @@
+/*!
+ *
+ *
+ * \brief       -
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_UNSUPERVISED_RBM_GRADIENTAPPROXIMATIONS_PARALLELCHAINAPPROXIMATOR_H
+#define SHARK_UNSUPERVISED_RBM_GRADIENTAPPROXIMATIONS_PARALLELCHAINAPPROXIMATOR_H
+
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/Core/OpenMP.h>
+#include "Impl/DataEvaluator.h"
+#include <vector>
+
+namespace shark{
+///\brief Approximates the gradient by taking samples from several independent Markov chains which are run concurrently.
+///
+/// Every chain is a copy of the prototype chain returned by chain() and gets its own random number generator.
+/// Thus the chains do not share any mutable state and are advanced in parallel without locking.
+/// The generators are seeded from the generator of the RBM when setData is called.
+///
+/// If the chain computes batches (e.g. MarkovChain for persistent contrastive divergence), the samples
+/// are split evenly among the chains and every chain holds a batch of persistent samples. Otherwise
+/// (e.g. TemperedMarkovChain for parallel tempering) every chain is a separate set of tempered chains
+/// which produces its share of the samples sequentially. In this case the replica exchange of every set
+/// happens after each round of Gibbs steps of all its temperatures, as in TemperedMarkovChain::step.
+///
+/// The gradients of the chains are summed up in a fixed order. Therefore, for a fixed number of chains
+/// the samples only depend on the state of the RBM's generator and not on the number of threads
+/// or their scheduling. If the number of chains is not set, one chain per available thread is used.
+template<class MarkovChainType>
+class ParallelChainApproximator: public SingleObjectiveFunction{
+public:
+	typedef typename MarkovChainType::RBM RBM;
+	typedef typename RBM::RngType RngType;
+
+	ParallelChainApproximator(RBM* rbm)
+	: mpe_rbm(rbm),m_chain(rbm),m_k(1),m_samples(0),m_numberOfChains(0),m_numBatches(0),m_regularizer(0),m_regularizationStrength(0){
+		SHARK_ASSERT(rbm != NULL);
+
+		m_features.reset(HAS_VALUE);
+		m_features |=HAS_FIRST_DERIVATIVE;
+		m_features |=CAN_PROPOSE_STARTING_POINT;
+	}
+
+	/// \brief Copies the approximator. The chains of the copy sample with the generators of the copy.
+	ParallelChainApproximator(ParallelChainApproximator const& other)
+	: SingleObjectiveFunction(other)
+	, mpe_rbm(other.mpe_rbm)
+	, m_chain(other.m_chain)
+	, m_chains(other.m_chains)
+	, m_rngs(other.m_rngs)
+	, m_chainSamples(other.m_chainSamples)
+	, m_data(other.m_data)
+	, m_k(other.m_k)
+	, m_samples(other.m_samples)
+	, m_numberOfChains(other.m_numberOfChains)
+	, m_numBatches(other.m_numBatches)
+	, m_regularizer(other.m_regularizer)
+	, m_regularizationStrength(other.m_regularizationStrength){
+		bindChainRngs();
+	}
+
+	/// \brief Copies the approximator. The chains of the copy sample with the generators of the copy.
+	ParallelChainApproximator& operator=(ParallelChainApproximator const& other){
+		SingleObjectiveFunction::operator=(other);
+		mpe_rbm = other.mpe_rbm;
+		m_chain = other.m_chain;
+		m_chains = other.m_chains;
+		m_rngs = other.m_rngs;
+		m_chainSamples = other.m_chainSamples;
+		m_data = other.m_data;
+		m_k = other.m_k;
+		m_samples = other.m_samples;
+		m_numberOfChains = other.m_numberOfChains;
+		m_numBatches = other.m_numBatches;
+		m_regularizer = other.m_regularizer;
+		m_regularizationStrength = other.m_regularizationStrength;
+		bindChainRngs();
+		return *this;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "ParallelChainApproximator"; }
+
+	void setK(unsigned int k){
+		m_k = k;
+	}
+	void setNumberOfSamples(std::size_t samples){
+		m_samples = samples;
+	}
+
+	/// \brief Sets the number of independent chains.
+	///
+	/// If it is 0, the number of threads is used. Takes effect on the next call to setData.
+	void setNumberOfChains(std::size_t chains){
+		m_numberOfChains = chains;
+	}
+
+	/// \brief Returns the number of independent chains that are currently used.
+	std::size_t numberOfChains()const{
+		return m_chains.size();
+	}
+
+	/// \brief Returns the prototype chain which is copied for every independent chain.
+	///
+	/// Configure it, e.g. the temperatures, before calling setData.
+	MarkovChainType& chain(){
+		return m_chain;
+	}
+	MarkovChainType const& chain() const{
+		return m_chain;
+	}
+
+	/// \brief Returns the ith chain that is used for sampling.
+	MarkovChainType const& chain(std::size_t i) const{
+		return m_chains[i];
+	}
+
+	/// \brief Returns the number of batches of the dataset that are used in every iteration.
+	///
+	/// If it is less than all batches, the batches are chosen at random. if it is 0, all batches are used
+	std::size_t numBatches()const{
+		return m_numBatches;
+	}
+
+	/// \brief Returns a reference to the number of batches of the dataset that are used in every iteration.
+	///
+	/// If it is less than all batches, the batches are chosen at random.if it is 0, all batches are used.
+	std::size_t& numBatches(){
+		return m_numBatches;
+	}
+
+	void setData(UnlabeledData<RealVector> const& data){
+		m_data = data;
+
+		//if the number of samples is 0 = unset, set it to the number of points in the data set
+		if(!m_samples){
+			setNumberOfSamples(m_data.numberOfElements());
+		}
+		std::size_t chains = m_numberOfChains? m_numberOfChains : SHARK_NUM_THREADS;
+		chains = std::min(chains, m_samples);
+
+		//split the samples evenly among the chains
+		std::size_t samplesPerChain = m_samples / chains;
+		std::size_t leftOver = m_samples - samplesPerChain * chains;
+		m_chainSamples.resize(chains);
+		for(std::size_t i = 0; i != chains; ++i){
+			m_chainSamples[i] = samplesPerChain + (i < leftOver);
+		}
+
+		//every chain gets its own generator seeded from the generator of the rbm.
+		//the vector is not resized afterwards as the chains store pointers to its elements
+		m_rngs.assign(chains,RngType());
+		for(std::size_t i = 0; i != chains; ++i){
+			m_rngs[i].seed(mpe_rbm->rng()());
+		}
+
+		m_chains.assign(chains,m_chain);
+		bindChainRngs();
+		for(std::size_t i = 0; i != chains; ++i){
+			if(MarkovChainType::computesBatch)
+				m_chains[i].setBatchSize(m_chainSamples[i]);
+			m_chains[i].initializeChain(m_data);
+		}
+	}
+
+	SearchPointType proposeStartingPoint() const{
+		return  mpe_rbm->parameterVector();
+	}
+
+	std::size_t numberOfVariables()const{
+		return mpe_rbm->numberOfParameters();
+	}
+
+	void setRegularizer(double factor, SingleObjectiveFunction* regularizer){
+		m_regularizer = regularizer;
+		m_regularizationStrength = factor;
+	}
+
+	double evalDerivative( SearchPointType const & parameter, FirstOrderDerivative & derivative ) const {
+		mpe_rbm->setParameterVector(parameter);
+
+		RealVector empiricalAverage = detail::evaluateData(m_data,*mpe_rbm,m_numBatches);
+
+		//approximate the expectation of the energy gradient with respect to the model distribution
+		//using samples from the Markov chains. Every chain computes its own average.
+		std::size_t chains = m_chains.size();
+		std::vector<typename RBM::GradientType> chainAverages(chains,typename RBM::GradientType(mpe_rbm));
+		SHARK_PARALLEL_FOR(int ci = 0; ci < (int)chains; ++ci){//MSVC does not support unsigned integrals in paralll loops
+			std::size_t c = ci;
+			MarkovChainType& chain = m_chains[c];
+			if(MarkovChainType::computesBatch){
+				chain.step(m_k);
+				chainAverages[c].addVH(chain.samples().hidden, chain.samples().visible);
+			}else{
+				typename MarkovChainType::SampleBatch gradientBatch(m_chainSamples[c], mpe_rbm->numberOfVN(),mpe_rbm->numberOfHN());
+				for(std::size_t i = 0; i != m_chainSamples[c]; ++i){
+					chain.step(m_k);
+					getBatchElement(gradientBatch,i) = chain.sample();
+				}
+				chainAverages[c].addVH(gradientBatch.hidden, gradientBatch.visible);
+			}
+		}
+		//reduce in fixed order
+		typename RBM::GradientType modelAverage(mpe_rbm);
+		for(std::size_t c = 0; c != chains; ++c){
+			modelAverage += chainAverages[c];
+		}
+
+		derivative.resize(mpe_rbm->numberOfParameters());
+		noalias(derivative) = modelAverage.result() - empiricalAverage;
+
+		if(m_regularizer){
+			FirstOrderDerivative regularizerDerivative;
+			m_regularizer->evalDerivative(parameter,regularizerDerivative);
+			noalias(derivative) += m_regularizationStrength*regularizerDerivative;
+		}
+
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+private:
+	/// \brief Lets the i-th chain sample with the i-th generator of this object.
+	void bindChainRngs(){
+		for(std::size_t i = 0; i != m_chains.size(); ++i){
+			m_chains[i].transitionOperator().setRng(m_rngs[i]);
+		}
+	}
+
+	RBM* mpe_rbm;
+	MarkovChainType m_chain;
+	mutable std::vector<MarkovChainType> m_chains;
+	std::vector<RngType> m_rngs;
+	std::vector<std::size_t> m_chainSamples;
+	UnlabeledData<RealVector> m_data;
+
+	unsigned int m_k;
+	std::size_t m_samples;
+	std::size_t m_numberOfChains;
+	std::size_t m_numBatches;
+
+	SingleObjectiveFunction* m_regularizer;
+	double m_regularizationStrength;
+};
+}
+
+#endif
@@ -29,7 +29,7 @@
 #define SHARK_UNSUPERVISED_RBM_IMPL_CONVOLUTIONALENERGYGRADIENT_H
 
 #include <shark/LinAlg/Base.h>
-#include <shark/LinAlg/BLAS/matrix_set.hpp>
+#include <shark/LinAlg/BLAS/kernels/conv2d.hpp>
 namespace shark{
 namespace detail{
 ///\brief The gradient of the energy averaged over a set of cumulative added samples.
@@ -62,14 +62,14 @@ public:
 	///@param logWeights the logarithm of the weights for every sample
 	template<class HiddenSampleBatch, class VisibleSampleBatch, class WeightVector>
 	void addVH(HiddenSampleBatch const& hiddens, VisibleSampleBatch const& visibles, WeightVector const& logWeights){
-		SIZE_CHECK(logWeights.size() == shark::size(hiddens));
-		SIZE_CHECK(logWeights.size() == shark::size(visibles));
+		SIZE_CHECK(logWeights.size() == shark::batchSize(hiddens));
+		SIZE_CHECK(logWeights.size() == shark::batchSize(visibles));
 		
 		///update the internal state and get the transformed weights for the batch
 		RealVector weights = updateWeights(logWeights);
 		if(weights.empty()) return;//weights are not relevant to the gradient
 		
-		std::size_t batchSize = shark::size(hiddens);
+		std::size_t batchSize = shark::batchSize(hiddens);
 		
 		//update the gradient
 		RealMatrix weightedFeatures = mpe_rbm->visibleNeurons().phi(visibles.state);
@@ -91,14 +91,14 @@ public:
 	///@param logWeights the logarithm of the weights for every sample
 	template<class HiddenSampleBatch, class VisibleSampleBatch, class WeightVector>
 	void addHV(HiddenSampleBatch const& hiddens, VisibleSampleBatch const& visibles, WeightVector const& logWeights){
-		SIZE_CHECK(logWeights.size() == shark::size(hiddens));
-		SIZE_CHECK(logWeights.size() == shark::size(visibles));
+		SIZE_CHECK(logWeights.size() == shark::batchSize(hiddens));
+		SIZE_CHECK(logWeights.size() == shark::batchSize(visibles));
 		
 		///update the internal state and get the transformed weights for the batch
 		RealVector weights = updateWeights(logWeights);
 		if(weights.empty()) return;
 		
-		std::size_t batchSize = shark::size(hiddens);
+		std::size_t batchSize = shark::batchSize(hiddens);
 		
 		//update the gradient
 		RealMatrix weightedFeatures = mpe_rbm->hiddenNeurons().phi(hiddens.state);
@@ -131,15 +131,18 @@ public:
 		//scaling factor corrects by multiplying with 
 		//Z/(Z+Z_new)=1/(1+exp(logZ_new - logZ))
 		double const scalingFactor = std::exp(-logWeightSumUpdate);// factor is <=1
-		m_deltaWeights *= scalingFactor;
+		for(auto& deltaWeights: m_deltaWeights)
+			deltaWeights *= scalingFactor;
 		m_deltaBiasVisible *= scalingFactor;
 		m_deltaBiasHidden *= scalingFactor;
 		
 		//now add the new gradient with its corrected weight
 		double weight = std::exp(gradient.m_logWeightSum-m_logWeightSum);
-		noalias(m_deltaWeights) += weight * gradient.m_deltaWeights;
+		for(std::size_t f = 0; f != m_deltaWeights.size(); ++f)
+			noalias(m_deltaWeights[f]) += weight * gradient.m_deltaWeights[f];
 		noalias(m_deltaBiasVisible) += weight * gradient.m_deltaBiasVisible;
 		noalias(m_deltaBiasHidden) += weight * gradient.m_deltaBiasHidden;
+		return *this;
 	}
 	
 	///\brief Calculates the expectation of the energy gradient with respect to p(h|v) for a complete Batch.
@@ -151,7 +154,7 @@ public:
 	///@param visibles a batch of samples of the visible layer
 	template<class HiddenSampleBatch, class VisibleSampleBatch>
 	void addVH(HiddenSampleBatch const& hiddens, VisibleSampleBatch const& visibles){
-		addVH(hiddens,visibles, blas::repeat(0.0,shark::size(hiddens)));
+		addVH(hiddens,visibles, blas::repeat(0.0,shark::batchSize(hiddens)));
 	}
 
 	///\brief Calculates the weighted expectation of the energy gradient with respect to p(v|h) for a complete Batch.
@@ -163,7 +166,7 @@ public:
 	///@param visibles a batch of samples of the visible layer
 	template<class HiddenSampleBatch, class VisibleSampleBatch>
 	void addHV(HiddenSampleBatch const& hiddens, VisibleSampleBatch const& visibles){
-		addHV(hiddens,visibles, blas::repeat(0.0,shark::size(hiddens)));
+		addHV(hiddens,visibles, blas::repeat(0.0,shark::batchSize(hiddens)));
 	}
 	
 	///Returns the log of the sum of the weights.
@@ -182,7 +185,8 @@ public:
 	
 	///\brief Resets the internal state. 
 	void clear(){
-		m_deltaWeights.clear();
+		for(auto& deltaWeights: m_deltaWeights)
+			deltaWeights.clear();
 		m_deltaBiasVisible.clear();
 		m_deltaBiasHidden.clear();
 		m_logWeightSum = -std::numeric_limits<double>::infinity();
@@ -196,25 +200,24 @@ private:
 	double m_logWeightSum; //log of sum of weights. Usually equal to the log of the number of samples used.
 	
 
+	//the derivative with respect to a filter is the correlation of the visible image with the responses of the filter.
+	//Thus it is computed by the conv2d kernel with the responses of the filters taking the role of the filters.
 	template<class MatrixH, class MatrixV>
 	void updateConnectionDerivative(MatrixH const& hiddens, MatrixV const& visibles){
 		
 		std::size_t numFilters = mpe_rbm->numFilters();
 		std::size_t responseSize1 = mpe_rbm->responseSize1();
 		std::size_t responseSize2 = mpe_rbm->responseSize2();
+		std::size_t filterSize1 = mpe_rbm->filterSize1();
+		RealMatrix hidden(numFilters*responseSize1,responseSize2);
+		RealMatrix visible(mpe_rbm->inputSize1(),mpe_rbm->inputSize2());
+		RealMatrix filterDerivatives(numFilters*filterSize1,mpe_rbm->filterSize2());
 		for(std::size_t i = 0; i != hiddens.size1();++i){
-			auto visible = to_matrix(row(visibles,i),mpe_rbm->inputSize1(),mpe_rbm->inputSize2());
-			auto hidden = to_matrix(row(hiddens,i),numFilters*responseSize1,responseSize2);
-			
-			for (std::size_t x1=0; x1 != responseSize1; ++x1) {
-				for(std::size_t x2=0; x2 != responseSize2; ++x2) {
-					std::size_t end1 = x1+mpe_rbm->filterSize1();
-					std::size_t end2 = x2+mpe_rbm->filterSize2();
-					for(std::size_t f = 0; f != numFilters;++f){
-						double val = hidden(f*responseSize1+x1,x2);
-						noalias(m_deltaWeights[f]) += subrange(visible,x1,end1,x2,end2)*val;
-					}
-				}
+			noalias(visible) = to_matrix(row(visibles,i),mpe_rbm->inputSize1(),mpe_rbm->inputSize2());
+			noalias(hidden) = to_matrix(row(hiddens,i),numFilters*responseSize1,responseSize2);
+			blas::kernels::conv2d(visible,hidden,filterDerivatives,1,numFilters);
+			for(std::size_t f = 0; f != numFilters;++f){
+				noalias(m_deltaWeights[f]) += rows(filterDerivatives,f*filterSize1,(f+1)*filterSize1);
 			}
 		}
 	}
@@ -225,7 +228,7 @@ private:
 		double const maxExp = maxExpInput<double>();
 		
 		//calculate the gradient update with respect of only the current batch
-		std::size_t batchSize = shark::size(logWeights);
+		std::size_t batchSize = logWeights.size();
 		//first calculate the batchLogWeightSum
 		double batchLogWeightSum = logWeights(0);
 		for(std::size_t i = 1; i != batchSize; ++i){
@@ -256,7 +259,8 @@ private:
 			//scaling factor corrects by multiplying with 
 			//Z/(Z+Z_new)=1/(1+exp(logZ_new - logZ))
 			double const scalingFactor = std::exp(-weightSumUpdate);// factor is <=1
-			m_deltaWeights *= scalingFactor;
+			for(auto& deltaWeights: m_deltaWeights)
+				deltaWeights *= scalingFactor;
 			m_deltaBiasVisible *= scalingFactor;
 			m_deltaBiasHidden *= scalingFactor;
 		}
@@ -38,6 +38,7 @@
 #include <shark/Core/OpenMP.h>
 
 #include <boost/range/numeric.hpp>
+#include <vector>
 namespace shark {
 namespace detail{
 	
@@ -168,19 +169,26 @@ namespace detail{
 		noalias(energyDiffDown) = sampler.getDownDifferences();
 	}
 	
+	/// \brief Samples the energy differences of annealed importance sampling.
+	///
+	/// Given a set of beta: beta_0> beta_1>.... beta_n >= 0, every sample starts at beta_n and is moved
+	/// up to beta_1 by one step of Gibbs sampling per temperature. Row i of energyDiffUp
+	/// stores \f$ \ln(p_i(h)) - \ln(p_{i-1}(h)) \f$ for the sample drawn at beta_i, row 0 is not used.
+	///
+	/// The samples are processed in batches of fixed size which run in parallel. Every batch has its own
+	/// transition operator and random number generator. The generators are seeded in order of the batches
+	/// from the generator of the RBM before sampling starts. Thus the result only depends on the state of the
+	/// generator of the RBM and not on the number of threads or their scheduling.
 	template<class RBMType>
 	void sampleEnergiesWithTempering(
 		RBMType& rbm, 
 		RealVector const& beta, 
 		RealMatrix& energyDiffUp
 	){
-		std::size_t chains = beta.size();
-		std::size_t samples = energyDiffUp.size2();
-		
-		//setup sampler
-		GibbsOperator<RBMType> gibbsOperator(&rbm);
+		typedef typename RBMType::RngType RngType;
 		typedef typename  GibbsOperator<RBMType>::HiddenSampleBatch Hidden;
 		typedef typename  GibbsOperator<RBMType>::VisibleSampleBatch Visible;
+		std::size_t samples = energyDiffUp.size2();
 		
 		//sample and store Energies batchwise
 		std::size_t batchSize  = 512;
@@ -188,11 +196,20 @@ namespace detail{
 		if(numBatches*batchSize < samples)
 			++numBatches;
 		
-		SHARK_PARALLEL_FOR (unsigned int b = 0; b < (unsigned int)numBatches; ++b){
+		//one generator per batch, seeded sequentially so that the streams do not depend on the scheduling
+		std::vector<RngType> rngs(numBatches);
+		for(std::size_t b = 0; b != numBatches; ++b){
+			rngs[b].seed(rbm.rng()());
+		}
+		
+		SHARK_PARALLEL_FOR (int bi = 0; bi < (int)numBatches; ++bi){//MSVC does not support unsigned integrals in paralll loops
+			std::size_t b = bi;
 			std::size_t batchStart = b*batchSize;
 			std::size_t batchEnd = (b== numBatches-1)? samples : batchStart+batchSize;
 			std::size_t curSize = batchEnd-batchStart;
 
+			GibbsOperator<RBMType> gibbsOperator(&rbm);
+			gibbsOperator.setRng(rngs[b]);
 			Energy<RBMType> energy = rbm.energy();
 			
 			Hidden hidden(curSize,rbm.numberOfHN());
@@ -225,7 +242,45 @@ namespace detail{
 		}
 	}
 	
-
+	/// \brief Places inverse temperatures such that every step of AIS contributes the same amount of variance.
+	///
+	/// The variance of the log-weight of one annealing step from beta_i to beta_{i-1} is approximately
+	/// \f$ (\beta_{i-1}-\beta_i)^2 Var_{\beta_i}[\Delta E] \f$. Thus the standard deviation of a row of energyDiffUp
+	/// sampled on the schedule pilotBeta measures the length of the corresponding interval. The new schedule
+	/// divides the cumulated length into chains-1 intervals of equal length. Inside an interval of the pilot schedule,
+	/// the length is interpolated linearly. Intervals without variance get a small minimal length so that the
+	/// schedule stays strictly decreasing.
+	inline RealVector equalizeBetaSchedule(
+		RealVector const& pilotBeta,
+		RealMatrix const& energyDiffUp,
+		std::size_t chains
+	){
+		std::size_t pilotChains = pilotBeta.size();
+		std::size_t samples = energyDiffUp.size2();
+		
+		//cumulated length from beta_0 downwards
+		RealVector length(pilotChains,0.0);
+		for(std::size_t i = 1; i != pilotChains; ++i){
+			double mean = sum(row(energyDiffUp,i))/samples;
+			double variance = norm_sqr(row(energyDiffUp,i))/samples - sqr(mean);
+			double minLength = 1.e-3*(pilotBeta(i-1)-pilotBeta(i));
+			length(i) = length(i-1) + std::max(std::sqrt(std::max(variance,0.0)),minLength);
+		}
+		
+		RealVector beta(chains);
+		beta(0) = pilotBeta(0);
+		beta(chains-1) = pilotBeta(pilotChains-1);
+		std::size_t interval = 1;
+		for(std::size_t j = 1; j < chains-1; ++j){
+			double target = length(pilotChains-1) * j / double(chains-1);
+			while(length(interval) < target)
+				++interval;
+			double t = (target - length(interval-1))/(length(interval)-length(interval-1));
+			beta(j) = pilotBeta(interval-1) + t * (pilotBeta(interval) - pilotBeta(interval-1));
+		}
+		return beta;
+	}
+	
 	///\brief updates the log partition with the Energy of another state
 	///
 	///Calculating the partition fucntion itself is not easy. Aside from the computational complexity, 
@@ -127,41 +127,39 @@ public:
 	/// @param statistics sufficient statistics containing the probabilities of the neurons to be one
 	/// @param state the state vector that shell hold the sampled states
 	/// @param alpha factor changing from gibbs to flip-the state sampling. 0<=alpha<=1
-	/// @param rng the random number generator used for sampling
+	/// @param rng the random number generator used for sampling. Access to it is not synchronized, callers sharing a generator between threads must lock it.
 	template<class Matrix, class Rng>
 	void sample(StatisticsBatch const& statistics, Matrix& state, double alpha, Rng& rng) const{
 		SIZE_CHECK(statistics.size2() == size());
 		SIZE_CHECK(statistics.size1() == state.size1());
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			Bernoulli<Rng> coinToss(rng,0.5);
-			if(alpha == 0.0){//special case: normal gibbs sampling
-				for(std::size_t s = 0; s != state.size1();++s){
-					for(std::size_t i = 0; i != state.size2();++i){
-						state(s,i) = coinToss(statistics(s,i));
-					}
+		Bernoulli<Rng> coinToss(rng,0.5);
+		if(alpha == 0.0){//special case: normal gibbs sampling
+			for(std::size_t s = 0; s != state.size1();++s){
+				for(std::size_t i = 0; i != state.size2();++i){
+					state(s,i) = coinToss(statistics(s,i));
 				}
 			}
-			else{//flip-the state sampling
-				for(size_t s = 0; s != state.size1(); ++s){
-					for (size_t i = 0; i != state.size2(); i++) {
-						double prob = statistics(s,i);
-						if (state(s,i) == 0) {
-							if (prob <= 0.5) {
-								prob = (1. - alpha) * prob + alpha * prob / (1. - prob);
-							} else {
-								prob = (1. - alpha) * prob  + alpha;
-							}
+		}
+		else{//flip-the state sampling
+			for(size_t s = 0; s != state.size1(); ++s){
+				for (size_t i = 0; i != state.size2(); i++) {
+					double prob = statistics(s,i);
+					if (state(s,i) == 0) {
+						if (prob <= 0.5) {
+							prob = (1. - alpha) * prob + alpha * prob / (1. - prob);
+						} else {
+							prob = (1. - alpha) * prob  + alpha;
+						}
+					} else {
+						if (prob >= 0.5) {
+							prob = (1. - alpha) * prob + alpha * (1. - (1. - prob) / prob);
 						} else {
-							if (prob >= 0.5) {
-								prob = (1. - alpha) * prob + alpha * (1. - (1. - prob) / prob);
-							} else {
-								prob = (1. - alpha) * prob;
-							}
+							prob = (1. - alpha) * prob;
 						}
-						state(s,i) = coinToss(prob);
 					}
+					state(s,i) = coinToss(prob);
 				}
 			}
 		}
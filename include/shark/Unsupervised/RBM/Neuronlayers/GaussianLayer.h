@@ -105,19 +105,17 @@ public:
 	/// @param statistics sufficient statistics containing the mean of the conditional Gaussian distribution of the neurons
 	/// @param state the state matrix that will hold the sampled states
 	/// @param alpha factor changing from gibbs to flip-the state sampling. 0<=alpha<=1
-	/// @param rng the random number generator used for sampling
+	/// @param rng the random number generator used for sampling. Access to it is not synchronized, callers sharing a generator between threads must lock it.
 	template<class Matrix, class Rng>
 	void sample(StatisticsBatch const& statistics, Matrix& state, double alpha, Rng& rng) const{
 		SIZE_CHECK(statistics.size2() == size());
 		SIZE_CHECK(statistics.size1() == state.size1());
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			for(std::size_t i = 0; i != state.size1();++i){
-				for(std::size_t j = 0; j != state.size2();++j){
-					Normal<Rng> normal(rng,statistics(i,j),1.0);
-					state(i,j) = normal();
-				}
+		for(std::size_t i = 0; i != state.size1();++i){
+			for(std::size_t j = 0; j != state.size2();++j){
+				Normal<Rng> normal(rng,statistics(i,j),1.0);
+				state(i,j) = normal();
 			}
 		}
 		(void) alpha;
@@ -135,20 +135,18 @@ public:
 	/// @param statistics sufficient statistics for the batch to be computed
 	/// @param state the state matrix that will hold the sampled states
 	/// @param alpha factor changing from gibbs to flip-the state sampling. 0<=alpha<=1
-	/// @param rng the random number generator used for sampling
+	/// @param rng the random number generator used for sampling. Access to it is not synchronized, callers sharing a generator between threads must lock it.
 	template<class Matrix, class Rng>
 	void sample(StatisticsBatch const& statistics, Matrix& state, double alpha, Rng& rng) const{
 		SIZE_CHECK(statistics.lambda.size2() == size());
 		SIZE_CHECK(statistics.lambda.size1() == state.size1());
 		SIZE_CHECK(statistics.lambda.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			for(std::size_t i = 0; i != state.size1();++i){
-				for(std::size_t j = 0; j != state.size2();++j){
-					double integral = 1.0 - statistics.expMinusLambda(i,j);
-					TruncatedExponential<Rng> truncExp(integral,rng,statistics.lambda(i,j));
-					state(i,j) = truncExp();
-				}
+		for(std::size_t i = 0; i != state.size1();++i){
+			for(std::size_t j = 0; j != state.size2();++j){
+				double integral = 1.0 - statistics.expMinusLambda(i,j);
+				TruncatedExponential<Rng> truncExp(integral,rng,statistics.lambda(i,j));
+				state(i,j) = truncExp();
 			}
 		}
 		(void)alpha;//TODO: USE ALPHA
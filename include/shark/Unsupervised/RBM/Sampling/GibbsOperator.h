@@ -31,6 +31,7 @@
 #define SHARK_UNSUPERVISED_RBM_SAMPLING_GIBBSOPERATOR_H
 
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
 #include "Impl/SampleTypes.h"
 namespace shark{
 	
@@ -48,10 +49,16 @@ namespace shark{
 /// The trick of this sampler is that it takes the previous state into account while sampling. If the current state has a low probability,
 /// the sampler jumps deterministically in another state with higher probability. This is counterbalanced by having a higher chance to jump away from
 /// this state.
+///
+/// By default, the random number generator of the RBM is used for sampling. As this generator is
+/// shared, access to it is serialized when several threads sample at the same time. An operator can be given
+/// its own generator using setRng(), in which case several operators can sample concurrently
+/// without locking, as long as every generator is only used by a single thread.
 template< class RBMType >
 class GibbsOperator{
 public:
 	typedef RBMType RBM;
+	typedef typename RBM::RngType RngType;
 
 	///The operator holds a 'sample' of the visible and hidden neurons.
 	///Such a sample does not only contain the states of the neurons but all other information
@@ -80,7 +87,7 @@ public:
 
 	///\brief Constructs the Operator using an allready defined Distribution to sample from. 
 	GibbsOperator(RBM* rbm, double alphaVisible = 0,double alphaHidden = 0)
-	:mpe_rbm(rbm){
+	:mpe_rbm(rbm), mpe_rng(0){
 		setAlpha(alphaVisible,alphaHidden);
 	}
 		
@@ -89,6 +96,23 @@ public:
 		return mpe_rbm;
 	}
 
+	///\brief Returns the random number generator used for sampling.
+	RngType& rng()const{
+		return mpe_rng? *mpe_rng : mpe_rbm->rng();
+	}
+
+	///\brief Sets a random number generator which is used instead of the generator of the RBM.
+	///
+	/// The generator is not owned by the operator and must outlive it.
+	void setRng(RngType& rng){
+		mpe_rng = &rng;
+	}
+
+	///\brief Returns true if the operator uses its own generator instead of the generator of the RBM.
+	bool hasOwnRng()const{
+		return mpe_rng != 0;
+	}
+
 
 	///\brief Calculates internal data needed for sampling the hidden units as well as requested information for the gradient.
 	///
@@ -122,14 +146,26 @@ public:
 	///\brief Samples a new batch of states of the hidden units using their precomputed statistics.
 	void sampleHidden(HiddenSampleBatch& sampleBatch)const{
 		//sample state of the hidden neurons, input and statistics was allready computed by precompute
-		mpe_rbm->hiddenNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaHidden, mpe_rbm->rng());
+		if(hasOwnRng()){
+			mpe_rbm->hiddenNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaHidden, *mpe_rng);
+		}else{
+			SHARK_CRITICAL_REGION{//the rng of the rbm might be shared by several threads
+				mpe_rbm->hiddenNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaHidden, mpe_rbm->rng());
+			}
+		}
 	}
 
 
 	///\brief Samples a new batch of states of the visible units using their precomputed statistics.
 	void sampleVisible(VisibleSampleBatch& sampleBatch)const{
 		//sample state of the visible neurons, input and statistics was allready computed by precompute
-		mpe_rbm->visibleNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaVisible, mpe_rbm->rng());
+		if(hasOwnRng()){
+			mpe_rbm->visibleNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaVisible, *mpe_rng);
+		}else{
+			SHARK_CRITICAL_REGION{//the rng of the rbm might be shared by several threads
+				mpe_rbm->visibleNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaVisible, mpe_rbm->rng());
+			}
+		}
 	}
 	
 	/// \brief Applies the Gibbs operator a number of times to a given sample.
@@ -197,6 +233,7 @@ public:
 	}
 private:
 	RBM* mpe_rbm;
+	RngType* mpe_rng;
 	double m_alphaVisible;
 	double m_alphaHidden;
 };
@@ -84,7 +84,7 @@ public:
 	///
 	/// @param dataSet the data set
 	void initializeChain(Data<RealVector> const& dataSet){
-		DiscreteUniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,dataSet.numberOfElements()-1);
+		DiscreteUniform<typename RBM::RngType> uni(m_operator.rng(),0,dataSet.numberOfElements()-1);
 		std::size_t visibles=m_operator.rbm()->numberOfVN();
 		RealMatrix sampleData(m_samples.size(),visibles);
 		
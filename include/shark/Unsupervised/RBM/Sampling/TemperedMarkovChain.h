@@ -79,7 +79,7 @@ private:
 		double r = betaDiff * energyDiff + betaDiff*baseRateDiff;
 		
 		
-		Uniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,1);
+		Uniform<typename RBM::RngType> uni(m_operator.rng(),0,1);
 		double z = uni();
 		if( r >= 0 || (z > 0 && std::log(z) < r) ){
 			swap(high,low);
@@ -166,7 +166,7 @@ public:
 	/// @param dataSet the data set
 	void initializeChain(Data<RealVector> const& dataSet){
 		SHARK_RUNTIME_CHECK(m_temperedChains.size() != 0,"You did not initialize the number of temperatures bevor initializing the chain!");
-		DiscreteUniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,dataSet.numberOfElements()-1);
+		DiscreteUniform<typename RBM::RngType> uni(m_operator.rng(),0,dataSet.numberOfElements()-1);
 		std::size_t visibles = m_operator.rbm()->numberOfVN();
 		RealMatrix sampleData(m_temperedChains.size(),visibles);
 		
@@ -42,6 +42,7 @@
 #include <shark/Unsupervised/RBM/GradientApproximations/ContrastiveDivergence.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/MultiChainApproximator.h>
 #include <shark/Unsupervised/RBM/GradientApproximations/SingleChainApproximator.h>
+#include <shark/Unsupervised/RBM/GradientApproximations/ParallelChainApproximator.h>
 #include <shark/Rng/GlobalRng.h>
 namespace shark{
 typedef RBM<TruncExpBinaryEnergy, Rng::rng_type> TruncExpBinaryRBM;
@@ -52,6 +53,8 @@ typedef TemperedMarkovChain<TruncExpBinaryGibbsOperator> TruncExpBinaryPTChain;
 typedef MultiChainApproximator<TruncExpBinaryGibbsChain> TruncExpBinaryPCD;
 typedef ContrastiveDivergence<TruncExpBinaryGibbsOperator> TruncExpBinaryCD;
 typedef SingleChainApproximator<TruncExpBinaryPTChain> TruncExpBinaryParallelTempering;
+typedef ParallelChainApproximator<TruncExpBinaryGibbsChain> TruncExpBinaryParallelPCD;
+typedef ParallelChainApproximator<TruncExpBinaryPTChain> TruncExpBinaryParallelPT;
 }
 
 #endif
@@ -167,6 +167,14 @@ double estimateLogFreeEnergy(
 	);
 }
 
+///\brief Estimates the log of the ratio of the partition functions at beta(0) and beta(n) with annealed importance sampling.
+///
+///The samples are drawn in parallel. For a fixed state of the random number generator of the RBM
+///the result is the same regardless of the number of threads.
+///
+///@param rbm the RBM for which to estimate the ratio
+///@param beta the decreasing inverse temperatures of the annealing schedule
+///@param samples the number of importance samples
 template<class RBMType>
 double annealedImportanceSampling(
 	RBMType& rbm,RealVector const& beta, std::size_t samples
@@ -203,5 +211,33 @@ double annealedImportanceSampling(
 	return annealedImportanceSampling(rbm,beta,samples);
 }
 
+///\brief Computes an annealing schedule for AIS from a pilot run.
+///
+///A pilot run of AIS with pilotChains equally spaced inverse temperatures between 1 and 0 estimates
+///where the energy differences between neighbouring temperatures vary most. The returned schedule of
+///length chains places the temperatures such that every annealing step contributes roughly the same variance
+///to the importance weights. This gives a lower variance estimate than the linear schedule for the same
+///number of temperatures.
+///
+///@param rbm the RBM for which to compute the schedule
+///@param chains the number of temperatures of the returned schedule
+///@param pilotChains the number of temperatures of the pilot run
+///@param pilotSamples the number of samples of the pilot run
+///@return the inverse temperatures in decreasing order from 1 to 0
+template<class RBMType>
+RealVector adaptiveBetaSchedule(
+	RBMType& rbm, std::size_t chains, std::size_t pilotChains, std::size_t pilotSamples
+){
+	SHARK_RUNTIME_CHECK(chains >= 2 && pilotChains >= 2, "At least two temperatures are needed");
+	SHARK_RUNTIME_CHECK(pilotSamples >= 2, "The pilot run needs at least two samples");
+	RealVector pilotBeta(pilotChains);
+	for(std::size_t i = 0; i  != pilotChains; ++i){
+		pilotBeta(i) = 1.0-i/double(pilotChains-1);
+	}
+	RealMatrix energyDiffTempering(pilotChains,pilotSamples,0.0);
+	detail::sampleEnergiesWithTempering(rbm,pilotBeta,energyDiffTempering);
+	return detail::equalizeBetaSchedule(pilotBeta,energyDiffTempering,chains);
+}
+
 }
 #endif
@@ -38,6 +38,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
 #include <shark/Core/utility/KeyValuePair.h>
+#include <shark/Core/OpenMP.h>
 #include <algorithm>
 using namespace shark;
 
@@ -52,6 +53,45 @@ namespace{
 		std::nth_element(rankDistr.begin(), pos, rankDistr.end());
 		return *pos;
 	}
+
+	//number of rows or columns of the blocks of the matrix operations which are distributed over the threads
+	std::size_t const parallelBlockSize = 64;
+
+	//computes Y = Z * A^T by blocks of columns of Y
+	void parallelProdTrans(RealMatrix const& Z, RealMatrix const& A, RealMatrix& Y){
+		std::size_t n = A.size1();
+		std::size_t blocks = (n + parallelBlockSize - 1) / parallelBlockSize;
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)blocks; ++b){
+			std::size_t start = b * parallelBlockSize;
+			std::size_t end = std::min(start + parallelBlockSize, n);
+			auto columnsY = columns(Y, start, end);
+			noalias(columnsY) = Z % trans(rows(A, start, end));
+		}
+	}
+
+	//computes C = decay * C + c1 * p p^T + cMu * E E^T on the lower triangle by blocks of rows and copies it to the upper triangle.
+	//The blocks on the diagonal are computed completely, their upper triangles are overwritten by the copy.
+	void parallelCovarianceUpdate(
+		RealMatrix& C, double decay,
+		RealVector const& p, double c1,
+		RealMatrix const& E, double cMu
+	){
+		std::size_t n = C.size1();
+		std::size_t blocks = (n + parallelBlockSize - 1) / parallelBlockSize;
+		//the last rows contain the most elements of the triangle, start with them
+		SHARK_PARALLEL_FOR_DYNAMIC(int b = (int)blocks - 1; b >= 0; --b){
+			std::size_t start = b * parallelBlockSize;
+			std::size_t end = std::min(start + parallelBlockSize, n);
+			auto rowsC = subrange(C, start, end, 0, end);
+			noalias(rowsC) = decay * rowsC + c1 * blas::outer_prod(subrange(p, start, end), subrange(p, 0, end));
+			noalias(rowsC) += cMu * rows(E, start, end) % trans(rows(E, 0, end));
+		}
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)n; ++i){
+			for(std::size_t j = 0; j != (std::size_t)i; ++j){
+				C(j, i) = C(i, j);
+			}
+		}
+	}
 }
 
 /**
@@ -273,11 +313,26 @@ void CMA::doInit(
 }
 
 std::vector<CMA::IndividualType> CMA::generateOffspring( ) const{
+	//draw the standard normal samples z in the same order as the distribution,
+	//and transform all of them at once by y = BDz
+	RealMatrix Z( m_lambda, m_numberOfVariables );
+	for( std::size_t i = 0; i != m_lambda; i++ ) {
+		for( std::size_t j = 0; j != m_numberOfVariables; j++ ) {
+			Z( i, j ) = gauss( *mpe_rng, 0., 1. );
+		}
+	}
+	RealMatrix BD = m_mutationDistribution.eigenVectors();
+	RealVector const& eigenValues = m_mutationDistribution.eigenValues();
+	for( std::size_t j = 0; j != m_numberOfVariables; j++ ) {
+		column( BD, j ) *= std::sqrt( std::max( eigenValues( j ), 0.0 ) );
+	}
+	RealMatrix Y( m_lambda, m_numberOfVariables );
+	parallelProdTrans( Z, BD, Y );
+
 	std::vector< IndividualType > offspring( m_lambda );
 	for( std::size_t i = 0; i < offspring.size(); i++ ) {
-		MultiVariateNormalDistribution::result_type sample = m_mutationDistribution(*mpe_rng);
-		offspring[i].chromosome() = sample.second;
-		offspring[i].searchPoint() = m_mean + m_sigma * sample.first;
+		offspring[i].chromosome() = row( Z, i );
+		offspring[i].searchPoint() = m_mean + m_sigma * row( Y, i );
 	}
 	return offspring;
 }
@@ -298,12 +353,9 @@ void CMA::updatePopulation( std::vector<IndividualType> const& offspring ) {
 
 	// Covariance matrix update
 	RealMatrix& C = m_mutationDistribution.covarianceMatrix();
-	RealMatrix Z( m_numberOfVariables, m_numberOfVariables, 0.0); // matric for rank-mu update
+	RealMatrix E( m_numberOfVariables, m_mu ); // rank-mu update is C += cMu * E E^T
 	for( std::size_t i = 0; i < m_mu; i++ ) {
-		noalias(Z) += m_weights( i ) * blas::outer_prod(
-			selectedOffspring[i].searchPoint() - m_mean,
-			selectedOffspring[i].searchPoint() - m_mean
-		);
+		noalias(column( E, i )) = std::sqrt( m_weights( i ) ) / m_sigma * (selectedOffspring[i].searchPoint() - m_mean);
 	}
 	double n = static_cast<double>(m_numberOfVariables);
 	double expectedChi = std::sqrt( n )*(1. - 1./(4.*n) + 1./(21.*n*n));
@@ -314,15 +366,19 @@ void CMA::updatePopulation( std::vector<IndividualType> const& offspring ) {
 	double deltaHSig = (1.-hSig) * m_cC * (2. - m_cC);
 
 	m_evolutionPathC = (1. - m_cC ) * m_evolutionPathC + hSig * std::sqrt( m_cC * (2. - m_cC) * m_muEff ) * y; // eq. (42)
-	noalias(C) = (1.-m_c1 - m_cMu) * C + m_c1 * ( blas::outer_prod( m_evolutionPathC, m_evolutionPathC ) + deltaHSig * C) + m_cMu * 1./sqr( m_sigma ) * Z; // eq. (43)
+	parallelCovarianceUpdate(C, 1. - m_c1 - m_cMu + m_c1 * deltaHSig, m_evolutionPathC, m_c1, E, m_cMu); // eq. (43)
 
 	// Step size update
 	RealVector CInvY = blas::prod( m_mutationDistribution.eigenVectors(), z ); // C^(-1/2)y = Bz
 	m_evolutionPathSigma = (1. - m_cSigma)*m_evolutionPathSigma + std::sqrt( m_cSigma * (2. - m_cSigma) * m_muEff ) * CInvY; // eq. (40)
 	m_sigma *= std::exp((m_cSigma / m_dSigma) * (norm_2(m_evolutionPathSigma) / expectedChi - 1.)); // eq. (39)
 
-	// update mutation distribution
-	m_mutationDistribution.update();
+	// update mutation distribution. The eigendecomposition costs O(n^3), therefore
+	// it is only computed every 1/(10n(c1+cMu)) generations, which is O(n/lambda).
+	// Until then, the offspring are sampled from the previous decomposition
+	double decompositionInterval = 1. / (10. * n * (m_c1 + m_cMu));
+	if( decompositionInterval < 1 || m_counter % std::size_t( decompositionInterval ) == 0 )
+		m_mutationDistribution.update();
 	
 	//mean update
 	m_mean = m;
@@ -44,6 +44,10 @@ void LBFGS::initModel(){
 	
 	m_gradientDifferences.clear();
 	m_steps.clear();
+	if(m_compactRepresentation)
+		m_inverseHessian.init(m_dimension, m_numHist);
+	else
+		m_inverseHessian = LimitedMemoryInverseHessian();
 }
 void LBFGS::computeSearchDirection(){
 	// Update the history if necessary
@@ -62,6 +66,8 @@ void LBFGS::read( InArchive & archive )
 	archive>>m_hdiag;
 	archive>>m_steps;
 	archive>>m_gradientDifferences;
+	archive>>m_compactRepresentation;
+	archive>>m_inverseHessian;
 }
 
 void LBFGS::write( OutArchive & archive ) const
@@ -71,9 +77,16 @@ void LBFGS::write( OutArchive & archive ) const
 	archive<<m_hdiag;
 	archive<<m_steps;
 	archive<<m_gradientDifferences;
+	archive<<m_compactRepresentation;
+	archive<<m_inverseHessian;
 }
 
 void LBFGS::updateHist(RealVector& y, RealVector &step) {
+	//the representation chosen by initModel is used, not the current setting
+	if(m_inverseHessian.historySize() != 0){
+		m_inverseHessian.update(step, y, m_updThres);
+		return;
+	}
 	//Only update if <y,s> is above some reasonable threshold.
 	double ys = inner_prod(y, step);
 	if (ys > m_updThres) {
@@ -90,7 +103,12 @@ void LBFGS::updateHist(RealVector& y, RealVector &step) {
 }
 
 void LBFGS::getDirection(RealVector& searchDirection) {
-	
+	if(m_inverseHessian.historySize() != 0){
+		m_inverseHessian.multiply(m_derivative, searchDirection);
+		searchDirection *= -1;
+		return;
+	}
+
 	RealVector rho(m_numHist);
 	RealVector alpha(m_numHist);
 	RealVector beta(m_numHist);
@@ -0,0 +1,196 @@
+/*!
+ *
+ *
+ * \brief       Compact representation of the limited memory BFGS inverse Hessian
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#define SHARK_COMPILE_DLL
+#include <shark/Algorithms/GradientDescent/LimitedMemoryInverseHessian.h>
+#include <shark/Core/OpenMP.h>
+#include <vector>
+
+using namespace shark;
+
+//number of variables processed together as one block
+static const std::size_t inverseHessianBlockSize = 16384;
+
+void LimitedMemoryInverseHessian::init(std::size_t dimension, std::size_t historySize){
+	SHARK_RUNTIME_CHECK(historySize > 0, "An empty history is not allowed");
+	m_historySize = historySize;
+	m_steps.resize(historySize, dimension);
+	m_gradientDifferences.resize(historySize, dimension);
+	m_stepsTimesDifferences.resize(historySize, historySize);
+	m_differencesTimesDifferences.resize(historySize, historySize);
+	clear();
+}
+
+void LimitedMemoryInverseHessian::clear(){
+	m_start = 0;
+	m_size = 0;
+	m_gamma = 1.0;
+	m_steps.clear();
+	m_gradientDifferences.clear();
+	m_stepsTimesDifferences.clear();
+	m_differencesTimesDifferences.clear();
+}
+
+void LimitedMemoryInverseHessian::products(RealMatrix const& vectors, RealMatrix& result)const{
+	std::size_t n = dimension();
+	std::size_t m = m_historySize;
+	std::size_t numBlocks = (n + inverseHessianBlockSize - 1) / inverseHessianBlockSize;
+	std::vector<RealMatrix> blockProducts(numBlocks);
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+		std::size_t start = b * inverseHessianBlockSize;
+		std::size_t end = std::min(start + inverseHessianBlockSize, n);
+		RealMatrix& blockResult = blockProducts[b];
+		blockResult.resize(2 * m, vectors.size1());
+		auto blockVectors = trans(columns(vectors, start, end));
+		noalias(rows(blockResult, 0, m)) = prod(columns(m_steps, start, end), blockVectors);
+		noalias(rows(blockResult, m, 2 * m)) = prod(columns(m_gradientDifferences, start, end), blockVectors);
+	}
+	result.resize(2 * m, vectors.size1());
+	result.clear();
+	for(std::size_t b = 0; b != numBlocks; ++b){
+		noalias(result) += blockProducts[b];
+	}
+}
+
+bool LimitedMemoryInverseHessian::update(RealVector const& step, RealVector const& gradientDifference, double threshold){
+	SIZE_CHECK(step.size() == dimension());
+	SIZE_CHECK(gradientDifference.size() == dimension());
+	double sy = inner_prod(step, gradientDifference);
+	if(sy <= threshold)
+		return false;
+
+	//store the pair in the next free slot or replace the oldest one
+	std::size_t m = m_historySize;
+	std::size_t q = slot(m_size);
+	if(m_size == m)
+		m_start = (m_start + 1) % m;
+	else
+		++m_size;
+	noalias(row(m_steps, q)) = step;
+	noalias(row(m_gradientDifferences, q)) = gradientDifference;
+
+	//update the inner products with the new pair
+	RealMatrix pair(2, dimension());
+	noalias(row(pair, 0)) = step;
+	noalias(row(pair, 1)) = gradientDifference;
+	RealMatrix pairProducts;
+	products(pair, pairProducts);
+	for(std::size_t j = 0; j != m; ++j){
+		//<s_q,y_j> = <y_j,s_q>, <s_j,y_q> and <y_j,y_q>
+		m_stepsTimesDifferences(q, j) = pairProducts(m + j, 0);
+		m_stepsTimesDifferences(j, q) = pairProducts(j, 1);
+		m_differencesTimesDifferences(j, q) = pairProducts(m + j, 1);
+		m_differencesTimesDifferences(q, j) = pairProducts(m + j, 1);
+	}
+	m_gamma = sy / m_differencesTimesDifferences(q, q);
+	return true;
+}
+
+void LimitedMemoryInverseHessian::multiply(RealVector const& vector, RealVector& result)const{
+	SIZE_CHECK(vector.size() == dimension());
+	std::size_t n = dimension();
+	std::size_t m = m_historySize;
+	std::size_t k = m_size;
+	result.resize(n);
+	if(k == 0){
+		noalias(result) = gamma() * vector;
+		return;
+	}
+
+	//Sg and Yg in one pass
+	RealMatrix vectorMatrix(1, n);
+	noalias(row(vectorMatrix, 0)) = vector;
+	RealMatrix vectorProducts;
+	products(vectorMatrix, vectorProducts);
+
+	//bring the small matrices in chronological order
+	RealMatrix R(k, k, 0.0);
+	RealMatrix YY(k, k);
+	RealVector sg(k);
+	RealVector yg(k);
+	for(std::size_t i = 0; i != k; ++i){
+		sg(i) = vectorProducts(slot(i), 0);
+		yg(i) = vectorProducts(m + slot(i), 0);
+		for(std::size_t j = 0; j != k; ++j){
+			YY(i, j) = m_differencesTimesDifferences(slot(i), slot(j));
+			if(j >= i)
+				R(i, j) = m_stepsTimesDifferences(slot(i), slot(j));
+		}
+	}
+
+	//coefficients of the linear combination:
+	//u = R^{-1} Sg, w = R^{-T}((D + gamma YY^T) u - gamma Yg)
+	RealVector u = solve(R, sg, blas::upper(), blas::left());
+	RealVector w = gamma() * (prod(YY, u) - yg);
+	for(std::size_t i = 0; i != k; ++i){
+		w(i) += R(i, i) * u(i);
+	}
+	w = solve(trans(R), w, blas::lower(), blas::left());
+
+	//result = gamma g + S^T w - gamma Y^T u, the coefficients of the slots are stored in slot order
+	RealVector stepCoefficients(m, 0.0);
+	RealVector differenceCoefficients(m, 0.0);
+	for(std::size_t i = 0; i != k; ++i){
+		stepCoefficients(slot(i)) = w(i);
+		differenceCoefficients(slot(i)) = -gamma() * u(i);
+	}
+	std::size_t numBlocks = (n + inverseHessianBlockSize - 1) / inverseHessianBlockSize;
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+		std::size_t start = b * inverseHessianBlockSize;
+		std::size_t end = std::min(start + inverseHessianBlockSize, n);
+		auto blockResult = subrange(result, start, end);
+		noalias(blockResult) = gamma() * subrange(vector, start, end);
+		noalias(blockResult) += prod(trans(columns(m_steps, start, end)), stepCoefficients);
+		noalias(blockResult) += prod(trans(columns(m_gradientDifferences, start, end)), differenceCoefficients);
+	}
+}
+
+void LimitedMemoryInverseHessian::read(InArchive &archive){
+	archive >> m_historySize;
+	archive >> m_start;
+	archive >> m_size;
+	archive >> m_gamma;
+	archive >> m_steps;
+	archive >> m_gradientDifferences;
+	archive >> m_stepsTimesDifferences;
+	archive >> m_differencesTimesDifferences;
+}
+
+void LimitedMemoryInverseHessian::write(OutArchive &archive) const{
+	archive << m_historySize;
+	archive << m_start;
+	archive << m_size;
+	archive << m_gamma;
+	archive << m_steps;
+	archive << m_gradientDifferences;
+	archive << m_stepsTimesDifferences;
+	archive << m_differencesTimesDifferences;
+}
@@ -68,11 +68,15 @@ namespace{
 	/// (norm of the gradient below the given tolerance) or the step hits the border
 	/// of the trust region.
 	///
+	/// The Hessian is only accessed through hessianProduct(direction, result), which
+	/// computes result = H*direction.
+	///
 	/// Returns the improvement in function value and the solution as a pair.
 	///
 	/// Algorithm 7.2 in Wright, Nocedal: Numerical Optimization
+	template<class HessianProduct>
 	std::pair<double,RealVector> trustRegionCG(
-		RealMatrix const& hessian,
+		HessianProduct const& hessianProduct,
 		RealVector gradient,
 		double tolerance,   // bound on the norm of the gradient
 		double delta        // trust region size (radius)
@@ -86,8 +90,9 @@ namespace{
 		if( currentNormRes2 <sqr(tolerance))
 			return solution;
 
+		RealVector Hdir(gradient.size());
 		for(std::size_t iter = 0; iter != 10*gradient.size(); ++iter ){//numerical safeguard(should never be called)
-			RealVector Hdir=prod(hessian,direction);
+			hessianProduct(direction,Hdir);
 			double normH=inner_prod(direction, Hdir);
 			// if our Hessian is not positive definite then we just run to the boundary
 			if(normH <= 0){
@@ -125,13 +130,24 @@ namespace{
 	}
 }
 
-TrustRegionNewton::TrustRegionNewton()
+TrustRegionNewton::TrustRegionNewton():m_hessianFree(false), m_useHessianVectorProduct(false)
 {
 	m_features |= REQUIRES_VALUE;
 	m_features |= REQUIRES_FIRST_DERIVATIVE;
 	m_features |= REQUIRES_SECOND_DERIVATIVE;
 }
 
+void TrustRegionNewton::setHessianFree(bool hessianFree){
+	m_hessianFree = hessianFree;
+	if(hessianFree){
+		m_features.reset(REQUIRES_SECOND_DERIVATIVE);
+		m_features |= REQUIRES_HESSIAN_VECTOR_PRODUCT;
+	}else{
+		m_features.reset(REQUIRES_HESSIAN_VECTOR_PRODUCT);
+		m_features |= REQUIRES_SECOND_DERIVATIVE;
+	}
+}
+
 void TrustRegionNewton::init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint, double initialDelta) {
 	checkFeatures(objectiveFunction);
 
@@ -139,7 +155,17 @@ void TrustRegionNewton::init(ObjectiveFunctionType& objectiveFunction, SearchPoi
 	m_minImprovementRatio = 0.1;
 	
 	m_best.point = startingPoint;
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+	m_useHessianVectorProduct = m_hessianFree;
+	evalDerivatives(objectiveFunction);
+}
+
+void TrustRegionNewton::evalDerivatives(ObjectiveFunctionType const& objectiveFunction){
+	if(m_useHessianVectorProduct){
+		m_derivatives.hessian.resize(0,0);
+		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives.gradient);
+	}else{
+		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+	}
 }
 
 void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
@@ -158,7 +184,18 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//The initial guess of 0.5 might be too optimistic and we still spend a lot of time on finding the solution, but this is hugely problem dependent.
 	double gamma =std::min(0.5,std::sqrt(gradNorm_2));
 	double tolerance = gamma* gradNorm_2;
-	std::pair<double,RealVector> solution =  trustRegionCG(m_derivatives.hessian, m_derivatives.gradient, tolerance, m_delta);
+	std::pair<double,RealVector> solution;
+	if(m_useHessianVectorProduct){
+		auto hessianProduct = [&](RealVector const& direction, RealVector& result){
+			objectiveFunction.evalHessianVectorProduct(m_best.point, direction, result);
+		};
+		solution = trustRegionCG(hessianProduct, m_derivatives.gradient, tolerance, m_delta);
+	}else{
+		auto hessianProduct = [&](RealVector const& direction, RealVector& result){
+			noalias(result) = prod(m_derivatives.hessian,direction);
+		};
+		solution = trustRegionCG(hessianProduct, m_derivatives.gradient, tolerance, m_delta);
+	}
 	if (solution.first == 0) return;//we are done
 
 	//calculate the function value improvement of the point compared to the model prediction
@@ -176,6 +213,6 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//accept the point only if the improvement is significant
 	if(rho >= m_minImprovementRatio){
 		noalias(m_best.point) +=solution.second;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+		evalDerivatives(objectiveFunction);
 	}
 }
@@ -0,0 +1,189 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Incremental PCA
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define SHARK_COMPILE_DLL
+#include <shark/Algorithms/Trainers/IncrementalPCA.h>
+#include <shark/Core/OpenMP.h>
+
+using namespace shark;
+
+void IncrementalPCA::reset(){
+	m_l = 0;
+	m_factor.resize(0,0);
+	m_mean.resize(0);
+	m_eigenvalues.resize(0);
+	m_eigenvectors.resize(0,0);
+}
+
+void IncrementalPCA::update(RealMatrix const& batch){
+	if(batch.size1() == 0) return;
+	RealVector batchMean = sum_rows(batch) / double(batch.size1());
+	RealMatrix centered = batch - repeat(batchMean,batch.size1());
+	mergeFactor(batch.size1(), batchMean, centered);
+}
+
+void IncrementalPCA::update(UnlabeledData<RealVector> const& inputs){
+	std::size_t numBatches = inputs.numberOfBatches();
+	if(numBatches == 0) return;
+	std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+	//calculate optimal partitioning
+	std::size_t batchesPerThread = numBatches/numThreads;
+	std::size_t leftOver = numBatches - batchesPerThread*numThreads;
+	std::vector<IncrementalPCA> partials(numThreads,IncrementalPCA(m_components));
+	SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
+		std::size_t t = ti;
+		//get start and end index of batch-range
+		std::size_t start = t*batchesPerThread+std::min(t,leftOver);
+		std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
+		for(std::size_t b = start; b != end; ++b){
+			partials[t].update(inputs.batch(b));
+		}
+	}
+	//merge in fixed order so that the result does not depend on the scheduling
+	for(auto const& partial: partials){
+		merge(partial);
+	}
+}
+
+void IncrementalPCA::merge(IncrementalPCA const& other){
+	if(other.m_l == 0) return;
+	mergeFactor(other.m_l, other.m_mean, other.m_factor);
+}
+
+// Let R_1, R_2 be the factors of the two scatter matrices around their means mu_1, mu_2.
+// The scatter matrix of the union is M^T M with M = (R_1; R_2; sqrt(n_1n_2/(n_1+n_2))(mu_1-mu_2)^T).
+// With the SVD M = U S V^T, the new factor is U^T M = S V^T. U is obtained from
+// the eigenvalue decomposition of the small matrix M M^T, which is cheap as M has
+// at most 2k+1 rows (or k+b+1 for a batch of size b).
+void IncrementalPCA::mergeFactor(std::size_t count, RealVector const& mean, RealMatrix const& factor){
+	SHARK_RUNTIME_CHECK(m_components > 0, "Number of components must be set");
+	if(m_l == 0){
+		m_mean = mean;
+		m_factor.resize(0,mean.size());
+	}
+	SIZE_CHECK(mean.size() == m_mean.size());
+	SIZE_CHECK(factor.size2() == m_mean.size());
+
+	std::size_t dim = m_mean.size();
+	std::size_t r1 = m_factor.size1();
+	std::size_t r2 = factor.size1();
+	double n1 = double(m_l);
+	double n2 = double(count);
+
+	RealMatrix M(r1 + r2 + 1, dim);
+	noalias(rows(M,0,r1)) = m_factor;
+	noalias(rows(M,r1,r1 + r2)) = factor;
+	noalias(row(M,r1 + r2)) = std::sqrt(n1 * n2 / (n1 + n2)) * (m_mean - mean);
+
+	RealMatrix G = prod(M,trans(M));
+	blas::symm_eigenvalue_decomposition<RealMatrix> eigen(G);
+	std::size_t rank = std::min(m_components, M.size1());
+	m_factor = prod(trans(columns(eigen.Q(),0,rank)),M);
+
+	noalias(m_mean) = (n1 * m_mean + n2 * mean) / (n1 + n2);
+	m_l += count;
+}
+
+void IncrementalPCA::finalize(){
+	SHARK_RUNTIME_CHECK(m_l >= 2, "Input needs to contain at least two points");
+	std::size_t rank = m_factor.size1();
+	std::size_t dim = m_factor.size2();
+	m_eigenvalues.resize(rank);
+	m_eigenvectors.resize(dim,rank);
+	for(std::size_t i = 0; i != rank; ++i){
+		double normSqr = norm_sqr(row(m_factor,i));
+		m_eigenvalues(i) = normSqr / m_l;
+		if(normSqr > 0)
+			noalias(column(m_eigenvectors,i)) = row(m_factor,i) / std::sqrt(normSqr);
+		else
+			column(m_eigenvectors,i).clear();
+	}
+}
+
+void IncrementalPCA::train(LinearModel<>& model, UnlabeledData<RealVector> const& inputs){
+	std::size_t m = model.outputSize(); ///< reduced dimensionality
+	std::size_t components = m_components;
+	if(!components)
+		m_components = m;
+	reset();
+	update(inputs);
+	finalize();
+	encoder(model, m);
+	m_components = components;
+}
+
+//! Returns a model mapping the original data to the
+//! m-dimensional PCA coordinate system.
+void IncrementalPCA::encoder(LinearModel<>& model, std::size_t m) {
+	if(!m) m = m_eigenvectors.size2();
+	SHARK_RUNTIME_CHECK(m <= m_eigenvectors.size2(), "Number of requested components is larger than the number of computed components");
+
+	RealMatrix A = trans(columns(m_eigenvectors, 0, m) );
+	RealVector offset = -prod(A, m_mean);
+	if(m_whitening){
+		for(std::size_t i=0; i<A.size1(); i++) {
+			//take care of numerical difficulties for very small eigenvalues.
+			if(m_eigenvalues(i)/m_eigenvalues(0) < 1.e-15){
+				row(A,i).clear();
+				offset(i) = 0;
+			}
+			else{
+				row(A, i) /= std::sqrt(m_eigenvalues(i));
+				offset(i) /= std::sqrt(m_eigenvalues(i));
+			}
+		}
+	}
+	model.setStructure(A, offset);
+}
+
+//! Returns a model mapping encoded data from the
+//! m-dimensional PCA coordinate system back to the
+//! n-dimensional original coordinate system.
+void IncrementalPCA::decoder(LinearModel<>& model, std::size_t m) {
+	if(!m) m = m_eigenvectors.size2();
+	SHARK_RUNTIME_CHECK(m <= m_eigenvectors.size2(), "Number of requested components is larger than the number of computed components");
+
+	RealMatrix A = columns(m_eigenvectors, 0, m);
+	if(m_whitening){
+		for(std::size_t i=0; i<A.size2(); i++) {
+			//take care of numerical difficulties for very small eigenvalues.
+			if(m_eigenvalues(i)/m_eigenvalues(0) < 1.e-15){
+				column(A,i).clear();
+			}
+			else{
+				column(A, i) = column(A, i) * std::sqrt(m_eigenvalues(i));
+			}
+		}
+	}
+	model.setStructure(A, m_mean);
+}
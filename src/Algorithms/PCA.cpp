@@ -34,9 +34,30 @@
 #define SHARK_COMPILE_DLL
 #include <shark/Data/Statistics.h>
 #include <shark/Algorithms/Trainers/PCA.h>
+#include <shark/Rng/GlobalRng.h>
 
 using namespace shark;
 
+namespace{
+//orthonormalizes the rows of P using modified Gram-Schmidt.
+//rows which are (numerically) linearly dependent on the previous rows are set to zero.
+void orthonormalizeRows(RealMatrix& P){
+	for(std::size_t i = 0; i != P.size1(); ++i){
+		auto pi = row(P,i);
+		double initialNorm = norm_2(pi);
+		for(std::size_t j = 0; j != i; ++j){
+			auto pj = row(P,j);
+			noalias(pi) -= inner_prod(pi,pj) * pj;
+		}
+		double norm = norm_2(pi);
+		if(norm <= 1.e-10 * initialNorm)
+			pi.clear();
+		else
+			pi /= norm;
+	}
+}
+}
+
 /// Set the input data, which is stored in the PCA object.
 void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	SHARK_RUNTIME_CHECK(inputs.numberOfElements() >= 2, "Input needs to contain at least two points");
@@ -48,6 +69,10 @@ void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 		if(m_n > m_l) algorithm = SMALL_SAMPLE; // more attributes than data points
 		else algorithm = STANDARD;
 	}
+	if(algorithm == RANDOMIZED){
+		computeRandomized(inputs);
+		return;
+	}
 
 	// decompose covariance matrix
 	if(algorithm == STANDARD) { // standard case
@@ -109,10 +134,59 @@ void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	}
 }
 
+// Randomized subspace iteration. The rows of P span the current estimate of the
+// dominant subspace of the covariance matrix C = X0^T X0/l. Every pass over the data
+// replaces P by P C, which is computed batchwise as sum_b (P X_b^T) X_b. Neither C
+// nor the Gram matrix X0 X0^T is formed, thus this works for any ratio of m_n and m_l.
+// Finally the problem is projected onto the subspace and the small r x r eigenvalue
+// problem is solved exactly.
+void PCA::computeRandomized(UnlabeledData<RealVector> const& inputs){
+	SHARK_RUNTIME_CHECK(m_components > 0, "Number of components of the randomized PCA must be set");
+	std::size_t k = std::min(m_components,std::min(m_n,m_l));
+	std::size_t r = std::min(k + m_oversampling,std::min(m_n,m_l));
+	m_mean = shark::mean(inputs);
+
+	RealMatrix P(r,m_n);
+	for(std::size_t i = 0; i != r; ++i){
+		for(std::size_t j = 0; j != m_n; ++j){
+			P(i,j) = Rng::gauss();
+		}
+	}
+
+	RealMatrix PC(r,m_n);
+	for(std::size_t iter = 0; iter <= m_powerIterations; ++iter){
+		orthonormalizeRows(P);
+		PC.clear();
+		for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+			std::size_t batchSize = inputs.batch(b).size1();
+			RealMatrix X = inputs.batch(b)-repeat(m_mean,batchSize);
+			RealMatrix PXT = prod(P,trans(X));
+			noalias(PC) += prod(PXT,X);
+		}
+		P.swap(PC);
+	}
+	orthonormalizeRows(P);
+
+	//B = P C P^T = 1/l sum_b (X_b P^T)^T (X_b P^T)
+	RealMatrix B(r,r,0.0);
+	for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+		std::size_t batchSize = inputs.batch(b).size1();
+		RealMatrix X = inputs.batch(b)-repeat(m_mean,batchSize);
+		RealMatrix XPT = prod(X,trans(P));
+		noalias(B) += prod(trans(XPT),XPT);
+	}
+	B /= m_l;
+
+	blas::symm_eigenvalue_decomposition<RealMatrix> eigen(B);
+	m_eigenvalues = subrange(eigen.D(),0,k);
+	m_eigenvectors = prod(trans(P),columns(eigen.Q(),0,k));
+}
+
 //! Returns a model mapping the original data to the
 //! m-dimensional PCA coordinate system.
 void PCA::encoder(LinearModel<>& model, std::size_t m) {
 	if(!m) m = std::min(m_n,m_l);
+	m = std::min(m, m_eigenvectors.size2());
 
 	RealMatrix A = trans(columns(m_eigenvectors, 0, m) );
 	RealVector offset = -prod(A, m_mean);
@@ -137,6 +211,7 @@ void PCA::encoder(LinearModel<>& model, std::size_t m) {
 //! n-dimensional original coordinate system.
 void PCA::decoder(LinearModel<>& model, std::size_t m) {
 	if(!m) m = std::min(m_n,m_l);
+	m = std::min(m, m_eigenvectors.size2());
 	if( m == m_n && !m_whitening){
 		model.setStructure(m_eigenvectors, m_mean);
 	}
@@ -0,0 +1,187 @@
+/*!
+ *
+ *
+ * \brief       Implementation of the KernelExpansionPredictor
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#define SHARK_COMPILE_DLL
+#include <shark/Models/Kernels/KernelExpansionPredictor.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/PolynomialKernel.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Core/OpenMP.h>
+#include <vector>
+#include <cmath>
+
+using namespace shark;
+
+//number of patterns from which on the evaluation is parallelized over blocks of patterns instead of basis tiles
+static const std::size_t predictorRowBlockSize = 64;
+
+void KernelExpansionPredictor::setExpansion(KernelExpansion<RealVector> const& expansion){
+	SHARK_RUNTIME_CHECK(expansion.kernel() != NULL, "[KernelExpansionPredictor::setExpansion] expansion has no kernel");
+	AbstractKernelFunction<RealVector> const* kernel = expansion.kernel();
+	if(GaussianRbfKernel<RealVector> const* gaussian = dynamic_cast<GaussianRbfKernel<RealVector> const*>(kernel)){
+		m_kernelFunction = GAUSSIAN;
+		m_gamma = gaussian->gamma();
+	}else if(PolynomialKernel<RealVector> const* polynomial = dynamic_cast<PolynomialKernel<RealVector> const*>(kernel)){
+		m_kernelFunction = POLYNOMIAL;
+		m_degree = polynomial->degree();
+		m_kernelOffset = polynomial->offset();
+	}else if(dynamic_cast<LinearKernel<RealVector> const*>(kernel)){
+		m_kernelFunction = LINEAR;
+	}else{
+		throw SHARKEXCEPTION("[KernelExpansionPredictor::setExpansion] unsupported kernel "+kernel->name());
+	}
+
+	m_basis = createBatch<RealVector>(expansion.basis().elements());
+	m_basisNorms.resize(m_basis.size1());
+	for(std::size_t i = 0; i != m_basis.size1(); ++i){
+		m_basisNorms(i) = norm_sqr(row(m_basis,i));
+	}
+	m_alpha = expansion.alpha();
+	if(expansion.hasOffset())
+		m_offset = expansion.offset();
+	else
+		m_offset = RealVector();
+}
+
+void KernelExpansionPredictor::evalTile(
+	RealMatrix const& patterns, RealVector const& patternNorms,
+	std::size_t rowStart, std::size_t rowEnd,
+	std::size_t tileStart, std::size_t tileEnd,
+	RealMatrix& kernelValues
+)const{
+	std::size_t numRows = rowEnd - rowStart;
+	std::size_t numCols = tileEnd - tileStart;
+	auto K = subrange(kernelValues, 0, numRows, 0, numCols);
+	noalias(K) = prod(rows(patterns,rowStart,rowEnd),trans(rows(m_basis,tileStart,tileEnd)));
+	switch(m_kernelFunction){
+	case GAUSSIAN:
+		for(std::size_t i = 0; i != numRows; ++i){
+			double patternNorm = patternNorms(rowStart + i);
+			for(std::size_t j = 0; j != numCols; ++j){
+				double distance = patternNorm + m_basisNorms(tileStart + j) - 2 * K(i,j);
+				K(i,j) = std::exp(-m_gamma * std::max(distance, 0.0));
+			}
+		}
+		break;
+	case POLYNOMIAL:
+		for(std::size_t i = 0; i != numRows; ++i){
+			for(std::size_t j = 0; j != numCols; ++j){
+				K(i,j) = std::pow(K(i,j) + m_kernelOffset, (double)m_degree);
+			}
+		}
+		break;
+	case LINEAR:
+		break;
+	}
+}
+
+void KernelExpansionPredictor::eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+	SIZE_CHECK(patterns.size2() == inputSize());
+	std::size_t numPatterns = patterns.size1();
+	std::size_t numBasis = m_basis.size1();
+	outputs.resize(numPatterns, outputSize());
+	if(hasOffset())
+		noalias(outputs) = repeat(m_offset, numPatterns);
+	else
+		outputs.clear();
+	if(numBasis == 0 || numPatterns == 0) return;
+
+	RealVector patternNorms;
+	if(m_kernelFunction == GAUSSIAN){
+		patternNorms.resize(numPatterns);
+		for(std::size_t i = 0; i != numPatterns; ++i){
+			patternNorms(i) = norm_sqr(row(patterns,i));
+		}
+	}
+	std::size_t numTiles = (numBasis + m_tileSize - 1) / m_tileSize;
+
+	if(numPatterns > predictorRowBlockSize){
+		//every thread computes all tiles for its own block of patterns
+		std::size_t numBlocks = (numPatterns + predictorRowBlockSize - 1) / predictorRowBlockSize;
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+			std::size_t rowStart = b * predictorRowBlockSize;
+			std::size_t rowEnd = std::min(rowStart + predictorRowBlockSize, numPatterns);
+			RealMatrix kernelValues(rowEnd - rowStart, m_tileSize);
+			auto outputBlock = rows(outputs, rowStart, rowEnd);
+			for(std::size_t t = 0; t != numTiles; ++t){
+				std::size_t tileStart = t * m_tileSize;
+				std::size_t tileEnd = std::min(tileStart + m_tileSize, numBasis);
+				evalTile(patterns, patternNorms, rowStart, rowEnd, tileStart, tileEnd, kernelValues);
+				noalias(outputBlock) += prod(
+					subrange(kernelValues, 0, rowEnd - rowStart, 0, tileEnd - tileStart),
+					rows(m_alpha, tileStart, tileEnd)
+				);
+			}
+		}
+	}else{
+		//few patterns: the tiles are processed in parallel and the results summed in order
+		std::vector<RealMatrix> tileOutputs(numTiles);
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numTiles; ++t){
+			std::size_t tileStart = t * m_tileSize;
+			std::size_t tileEnd = std::min(tileStart + m_tileSize, numBasis);
+			RealMatrix kernelValues(numPatterns, tileEnd - tileStart);
+			evalTile(patterns, patternNorms, 0, numPatterns, tileStart, tileEnd, kernelValues);
+			tileOutputs[t] = prod(kernelValues, rows(m_alpha, tileStart, tileEnd));
+		}
+		for(std::size_t t = 0; t != numTiles; ++t){
+			noalias(outputs) += tileOutputs[t];
+		}
+	}
+}
+
+void KernelExpansionPredictor::read( InArchive & archive ){
+	int kernelFunction = 0;
+	archive >> kernelFunction;
+	m_kernelFunction = static_cast<KernelFunction>(kernelFunction);
+	archive >> m_gamma;
+	archive >> m_degree;
+	archive >> m_kernelOffset;
+	archive >> m_tileSize;
+	archive >> m_basis;
+	archive >> m_alpha;
+	archive >> m_offset;
+	m_basisNorms.resize(m_basis.size1());
+	for(std::size_t i = 0; i != m_basis.size1(); ++i){
+		m_basisNorms(i) = norm_sqr(row(m_basis,i));
+	}
+}
+
+void KernelExpansionPredictor::write( OutArchive & archive ) const{
+	int kernelFunction = m_kernelFunction;
+	archive << kernelFunction;
+	archive << m_gamma;
+	archive << m_degree;
+	archive << m_kernelOffset;
+	archive << m_tileSize;
+	archive << m_basis;
+	archive << m_alpha;
+	archive << m_offset;
+}
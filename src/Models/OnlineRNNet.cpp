@@ -33,53 +33,91 @@
 #define SHARK_COMPILE_DLL
 
 #include <shark/Models/OnlineRNNet.h>
+#include <shark/Core/OpenMP.h>
 using namespace std;
 using namespace shark;
 
 OnlineRNNet::OnlineRNNet(RecurrentStructure* structure, bool computeGradient)
-:mpe_structure(structure), m_computeGradient(computeGradient){
+:mpe_structure(structure), m_computeGradient(computeGradient), m_truncation(0){
 	SHARK_RUNTIME_CHECK(mpe_structure,"Structure pointer is not allowed to be NULL");
 	if(computeGradient)
 		m_features|=HAS_FIRST_PARAMETER_DERIVATIVE;
 }
 
+void OnlineRNNet::initializeState(InternalState& s, std::size_t streams)const{
+	if(s.activation.size1() != 0){
+		SHARK_RUNTIME_CHECK(s.activation.size1() == streams, "[OnlineRNNet] The number of streams can not change during a sequence");
+		return;
+	}
+	std::size_t numUnits = mpe_structure->numberOfUnits();
+	s.activation.resize(streams,numUnits);
+	s.activation.clear();
+	s.lastActivation.resize(streams,numUnits);
+	s.lastActivation.clear();
+	s.steps = 0;
+	s.truncation = m_truncation;
+	if(!m_computeGradient) return;
+	if(m_truncation == 0){
+		s.unitGradient.resize(streams * mpe_structure->parameters(),mpe_structure->numberOfNeurons());
+		s.unitGradient.clear();
+	}else{
+		s.lastActivationHistory.resize(m_truncation,RealMatrix(streams,numUnits,0.0));
+		s.activationHistory.resize(m_truncation,RealMatrix(streams,numUnits,0.0));
+	}
+}
+
+void OnlineRNNet::setOutputActivation(State& state, RealMatrix const& activations){
+	SIZE_CHECK(activations.size2() == outputSize());
+	InternalState& s = state.toState<InternalState>();
+	initializeState(s,activations.size1());
+	std::size_t numUnits = mpe_structure->numberOfUnits();
+	noalias(columns(s.activation,numUnits-outputSize(),numUnits)) = activations;
+}
 
 void OnlineRNNet::eval(RealMatrix const& pattern, RealMatrix& output, State& state)const{
-	SIZE_CHECK(pattern.size1()==1);//we can only process a single input at a time.
 	SIZE_CHECK(pattern.size2() == inputSize());
 	
-	
 	std::size_t numNeurons = mpe_structure->numberOfNeurons();
 	std::size_t numUnits = mpe_structure->numberOfUnits();
+	std::size_t numParameters = mpe_structure->parameters();
+	std::size_t streams = pattern.size1();
 	InternalState& s = state.toState<InternalState>();
-	RealVector& lastActivation = s.lastActivation;
-	RealVector& activation = s.activation;
+	initializeState(s,streams);
+	SHARK_RUNTIME_CHECK(s.truncation == m_truncation, "[OnlineRNNet] The truncation can not change during a sequence");
+	RealMatrix& lastActivation = s.lastActivation;
+	RealMatrix& activation = s.activation;
 	swap(lastActivation,activation);
 
 	//we want to treat input and bias neurons exactly as hidden or output neurons, so we copy the current
-	//pattern at the beginning of the the last activation pattern and set the bias neuron to 1
-	////so lastActivation has the format (input|1|lastNeuronActivation)
-	noalias(subrange(lastActivation,0,mpe_structure->inputs())) = row(pattern,0);
-	lastActivation(mpe_structure->bias())=1;
-	activation(mpe_structure->bias())=1;
-
-	//activation of the hidden neurons is now just a matrix vector multiplication
-
-	noalias(subrange(activation,inputSize()+1,numUnits)) = prod(
-		mpe_structure->weights(),
-		lastActivation
-	);
+	//patterns at the beginning of the the last activation patterns and set the bias neuron to 1
+	////so every row of lastActivation has the format (input|1|lastNeuronActivation)
+	noalias(columns(lastActivation,0,mpe_structure->inputs())) = pattern;
+	for(std::size_t k = 0; k != streams; ++k){
+		lastActivation(k,mpe_structure->bias())=1;
+		activation(k,mpe_structure->bias())=1;
+	}
 
+	//activation of the hidden neurons of all streams is now just a matrix-matrix multiplication
+	auto neurons = columns(activation,inputSize()+1,numUnits);
+	noalias(neurons) = prod(lastActivation,trans(mpe_structure->weights()));
 	//now apply the sigmoid function
-	for (std::size_t i = inputSize()+1;i != numUnits;i++){
-		activation(i) = mpe_structure->neuron(activation(i));
-	}
+	mpe_structure->applyNeuron(neurons);
+	
 	//copy the result to the output
-	output.resize(1,outputSize());
-	noalias(row(output,0)) = subrange(activation,numUnits-outputSize(),numUnits);
+	output.resize(streams,outputSize());
+	noalias(output) = columns(activation,numUnits-outputSize(),numUnits);
 	
 	//update the internal derivative if needed
 	if(!m_computeGradient) return;
+	++s.steps;
+	
+	//truncated BPTT only needs to store the activations
+	if(m_truncation != 0){
+		std::size_t slot = (s.steps - 1) % m_truncation;
+		noalias(s.lastActivationHistory[slot]) = lastActivation;
+		noalias(s.activationHistory[slot]) = activation;
+		return;
+	}
 	
 	RealMatrix& unitGradient = s.unitGradient;
 	
@@ -91,24 +129,29 @@ void OnlineRNNet::eval(RealMatrix const& pattern, RealMatrix& output, State& sta
 		inputSize()+1,numUnits
 	);
 	
-	//update the new gradient with the effect of last timestep
-	unitGradient = prod(unitGradient,trans(hiddenWeights));
-	
-	//add the effect of the current time step when there is a connection
-	std::size_t param = 0;
-	for(std::size_t i = 0; i != numNeurons; ++i){
-		for(std::size_t j = 0; j != numUnits; ++j){
-			if(mpe_structure->connection(i,j)){
-				unitGradient(param,i) += lastActivation(j);
-				++param;
+	//the streams are independent, every stream updates its own block of rows
+	SHARK_PARALLEL_FOR(int k = 0; k < (int)streams; ++k){
+		auto streamGradient = rows(unitGradient,k * numParameters, (k+1) * numParameters);
+		//update the new gradient with the effect of last timestep
+		RealMatrix newGradient = prod(streamGradient,trans(hiddenWeights));
+		
+		//add the effect of the current time step when there is a connection
+		std::size_t param = 0;
+		for(std::size_t i = 0; i != numNeurons; ++i){
+			for(std::size_t j = 0; j != numUnits; ++j){
+				if(mpe_structure->connection(i,j)){
+					newGradient(param,i) += lastActivation(k,j);
+					++param;
+				}
 			}
 		}
-	}
-	
-	//multiply with outer derivative of the neurons
-	for(std::size_t i = 0; i != unitGradient.size2();++i){
-		double neuronDerivative = mpe_structure->neuronDerivative(activation(i+inputSize()+1));
-		noalias(column(unitGradient,i)) *= neuronDerivative;
+		
+		//multiply with outer derivative of the neurons
+		for(std::size_t i = 0; i != numNeurons;++i){
+			double neuronDerivative = mpe_structure->neuronDerivative(activation(k,i+inputSize()+1));
+			noalias(column(newGradient,i)) *= neuronDerivative;
+		}
+		noalias(streamGradient) = newGradient;
 	}
 	
 	//We are done here for eval, the rest can only be computed using an error signal
@@ -117,18 +160,58 @@ void OnlineRNNet::eval(RealMatrix const& pattern, RealMatrix& output, State& sta
 
 void OnlineRNNet::weightedParameterDerivative(RealMatrix const& pattern, const RealMatrix& coefficients,  State const& state, RealVector& gradient)const{
 	SHARK_RUNTIME_CHECK(m_computeGradient, "Network is configured to not computing gradients!");
-	SIZE_CHECK(pattern.size1()==1);//we can only process a single input at a time.
-	SIZE_CHECK(coefficients.size1()==1);
+	SIZE_CHECK(pattern.size1() == coefficients.size1());
 	SIZE_CHECK(pattern.size2() == inputSize());
-	SIZE_CHECK(pattern.size2() == coefficients.size2());
+	SIZE_CHECK(coefficients.size2() == outputSize());
 	gradient.resize(mpe_structure->parameters());
+	gradient.clear();
 	
 	std::size_t numNeurons = mpe_structure->numberOfNeurons();
+	std::size_t numUnits = mpe_structure->numberOfUnits();
+	std::size_t numParameters = mpe_structure->parameters();
+	std::size_t streams = coefficients.size1();
 	InternalState const& s = state.toState<InternalState>();
-	RealMatrix const& unitGradient = s.unitGradient;
-	//and formula 4 (the gradient itself)
-	noalias(gradient) = prod(
-		columns(unitGradient,numNeurons-outputSize(),numNeurons),
-		row(coefficients,0)
-	);
+	SIZE_CHECK(s.activation.size1() == streams);
+	
+	if(s.truncation == 0){
+		//and formula 4 (the gradient itself)
+		RealMatrix const& unitGradient = s.unitGradient;
+		for(std::size_t k = 0; k != streams; ++k){
+			noalias(gradient) += prod(
+				subrange(unitGradient,k * numParameters, (k+1) * numParameters, numNeurons-outputSize(),numNeurons),
+				row(coefficients,k)
+			);
+		}
+		return;
+	}
+	
+	//truncated BPTT through the stored time steps, starting with the latest
+	auto hiddenWeights = columns(mpe_structure->weights(), inputSize()+1,numUnits);
+	RealMatrix weightGradient(numNeurons,numUnits,0.0);
+	RealMatrix errorDerivative(streams,numNeurons,0.0);
+	RealMatrix propagatedError(streams,numNeurons);
+	noalias(columns(errorDerivative,numNeurons-outputSize(),numNeurons)) = coefficients;
+	std::size_t window = std::min(s.steps,s.truncation);
+	for(std::size_t d = 0; d != window; ++d){
+		std::size_t slot = (s.steps - 1 - d) % s.truncation;
+		mpe_structure->multiplyNeuronDerivative(
+			errorDerivative,
+			columns(s.activationHistory[slot],inputSize()+1,numUnits)
+		);
+		noalias(weightGradient) += prod(trans(errorDerivative),s.lastActivationHistory[slot]);
+		if(d + 1 != window){
+			noalias(propagatedError) = prod(errorDerivative,hiddenWeights);
+			swap(errorDerivative,propagatedError);
+		}
+	}
+	
+	//copy the gradient of the existing connections
+	std::size_t param = 0;
+	for (std::size_t i = 0; i != numNeurons; ++i){
+		for (std::size_t j = 0; j != numUnits; ++j){
+			if(!mpe_structure->connection(i,j))continue;
+			gradient(param) = weightGradient(i,j);
+			++param;
+		}
+	}
 }
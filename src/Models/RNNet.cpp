@@ -30,50 +30,75 @@
  */
 #define SHARK_COMPILE_DLL
 #include <shark/Models/RNNet.h>
+#include <shark/Core/OpenMP.h>
+#include <map>
 
 using namespace std;
 using namespace shark;
 
+//maximum number of sequences which are processed together as one block
+static const std::size_t rnnetBlockSize = 64;
+
 void RNNet::eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
-	//initialize the history for the whole batch of sequences
 	InternalState& s = state.toState<InternalState>();
 	std::size_t warmUpLength=m_warmUpSequence.size();
 	std::size_t numUnits = mpe_structure->numberOfUnits();
-	s.timeActivation.resize(patterns.size());
 	outputs.resize(patterns.size());
 
-	//calculation of the sequences
+	//group the sequences by length and split the groups into blocks
+	std::map<std::size_t, std::vector<std::size_t> > lengthGroups;
 	for(std::size_t b = 0; b != patterns.size();++b){
-		std::size_t sequenceLength = patterns[b].size()+warmUpLength+1;
-		s.timeActivation[b].resize(sequenceLength,RealVector(numUnits));
-		outputs[b].resize(patterns[b].size(),RealVector(numUnits));
-		Sequence& sequence = s.timeActivation[b];
-		sequence[0].clear();
+		lengthGroups[patterns[b].size()].push_back(b);
+		outputs[b].resize(patterns[b].size(),RealVector(outputSize()));
+	}
+	s.blockSequences.clear();
+	for(auto const& group: lengthGroups){
+		std::vector<std::size_t> const& indices = group.second;
+		for(std::size_t start = 0; start < indices.size(); start += rnnetBlockSize){
+			std::size_t end = std::min(start + rnnetBlockSize, indices.size());
+			s.blockSequences.push_back(std::vector<std::size_t>(indices.begin() + start, indices.begin() + end));
+		}
+	}
+	std::size_t numBlocks = s.blockSequences.size();
+	s.blockActivation.resize(numBlocks);
+
+	//calculation of the sequences
+	SHARK_PARALLEL_FOR(int k = 0; k < (int)numBlocks; ++k){
+		std::vector<std::size_t> const& indices = s.blockSequences[k];
+		std::size_t blockSize = indices.size();
+		std::size_t sequenceLength = patterns[indices[0]].size()+warmUpLength+1;
+		std::vector<RealMatrix>& activation = s.blockActivation[k];
+		activation.resize(sequenceLength);
+		for(std::size_t t = 0; t != sequenceLength; ++t){
+			activation[t].resize(blockSize,numUnits);
+			activation[t].clear();
+		}
 		for (std::size_t t = 1; t < sequenceLength;t++){
 			//we want to treat input neurons exactly as hidden or output neurons, so we copy the current
-			//pattern at the beginning of the the last activation pattern. After that, all activations
-			//required for this timestep are in s.timeActivation[t-1]
-			if(t<=warmUpLength)
-				//we are still in warm up phase
-				noalias(subrange(sequence[t-1],0,inputSize())) = m_warmUpSequence[t-1];
-			else
-				noalias(subrange(sequence[t-1],0,inputSize())) = patterns[b][t-1-warmUpLength];
-			//and set the bias to 1
-			sequence[t-1](mpe_structure->bias())=1;
+			//patterns at the beginning of the last activation patterns. After that, all activations
+			//required for this timestep are in activation[t-1]
+			for(std::size_t i = 0; i != blockSize; ++i){
+				if(t<=warmUpLength)
+					//we are still in warm up phase
+					noalias(subrange(row(activation[t-1],i),0,inputSize())) = m_warmUpSequence[t-1];
+				else
+					noalias(subrange(row(activation[t-1],i),0,inputSize())) = patterns[indices[i]][t-1-warmUpLength];
+				//and set the bias to 1
+				activation[t-1](i,mpe_structure->bias()) = 1;
+			}
 
-			//activation of the hidden neurons is now just a matrix vector multiplication
-			noalias(subrange(sequence[t],inputSize()+1,numUnits)) = prod(
-				mpe_structure->weights(),
-				sequence[t-1]
-			);
+			//activation of the neurons of all sequences is now just a matrix-matrix multiplication
+			auto neurons = columns(activation[t],inputSize()+1,numUnits);
+			noalias(neurons) = prod(activation[t-1],trans(mpe_structure->weights()));
 			//now apply the sigmoid function
-			for (std::size_t i = inputSize()+1;i != numUnits;i++)
-				sequence[t](i) = mpe_structure->neuron(sequence[t](i));
+			mpe_structure->applyNeuron(neurons);
 			
 			//if the warmup is over, we can copy the results into the output
-			if(t>warmUpLength)
-				outputs[b][t-1-warmUpLength] = subrange(sequence[t],numUnits-outputSize(),numUnits);
-			
+			if(t>warmUpLength){
+				for(std::size_t i = 0; i != blockSize; ++i){
+					noalias(outputs[indices[i]][t-1-warmUpLength]) = subrange(row(activation[t],i),numUnits-outputSize(),numUnits);
+				}
+			}
 		}
 	}
 }
@@ -82,7 +107,7 @@ void RNNet::weightedParameterDerivative(
 	BatchInputType const& patterns, BatchInputType const& coefficients, 
 	State const& state, RealVector& gradient
 )const{
-	//SIZE_CHECK(pattern.size() == coefficients.size());
+	SIZE_CHECK(patterns.size() == coefficients.size());
 	InternalState const& s = state.toState<InternalState>();
 	gradient.resize(numberOfParameters());
 	gradient.clear();
@@ -90,43 +115,59 @@ void RNNet::weightedParameterDerivative(
 	std::size_t numUnits = mpe_structure->numberOfUnits();
 	std::size_t numNeurons = mpe_structure->numberOfNeurons();
 	std::size_t warmUpLength=m_warmUpSequence.size();
-	for(std::size_t b = 0; b != patterns.size(); ++b){
-		Sequence const& sequence = s.timeActivation[b];
-		std::size_t sequenceLength = s.timeActivation[b].size();
-		RealMatrix errorDerivative(sequenceLength,numNeurons);
-		errorDerivative.clear();
-		//copy errors
-		for (std::size_t t = warmUpLength+1; t != sequenceLength; ++t)
-			for(std::size_t i = 0; i != outputSize(); ++i)
-				errorDerivative(t,i+numNeurons-outputSize())=coefficients[b][t-warmUpLength-1](i);
-		
-		//backprop through time
-		for (std::size_t t = (int)sequence.size()-1; t > 0; t--){
-			for (std::size_t j = 0; j != numNeurons; ++j){
-				double derivative = mpe_structure->neuronDerivative(sequence[t](j+mpe_structure->inputs()+1));
-				errorDerivative(t,j)*=derivative;
+	std::size_t numBlocks = s.blockSequences.size();
+	//recurrent part of the weights, the error is propagated backwards through it
+	auto recurrentWeights = columns(mpe_structure->weights(), inputSize()+1,numUnits);
+
+	//the gradient of the weight matrix is computed for every block and summed afterwards in a fixed order
+	std::vector<RealMatrix> blockGradients(numBlocks);
+	SHARK_PARALLEL_FOR(int k = 0; k < (int)numBlocks; ++k){
+		std::vector<std::size_t> const& indices = s.blockSequences[k];
+		std::vector<RealMatrix> const& activation = s.blockActivation[k];
+		std::size_t blockSize = indices.size();
+		std::size_t sequenceLength = activation.size();
+		RealMatrix& weightGradient = blockGradients[k];
+		weightGradient.resize(numNeurons,numUnits);
+		weightGradient.clear();
+
+		//errorDerivative holds the BPTT error of the current time step for all sequences of the block
+		RealMatrix errorDerivative(blockSize,numNeurons,0.0);
+		RealMatrix propagatedError(blockSize,numNeurons);
+		for (std::size_t t = sequenceLength-1; t > 0; t--){
+			//add the errors of the outputs
+			if(t > warmUpLength){
+				for(std::size_t i = 0; i != blockSize; ++i){
+					noalias(subrange(row(errorDerivative,i),numNeurons-outputSize(),numNeurons))
+						+= coefficients[indices[i]][t-warmUpLength-1];
+				}
 			}
-			noalias(row(errorDerivative,t-1)) += prod(
-				trans(columns(mpe_structure->weights(), inputSize()+1,numUnits)),
-				row(errorDerivative,t)
-			);
-		}
-		
-		
-		//update gradient for batch element i
-		std::size_t param = 0;
-		for (std::size_t i = 0; i != numNeurons; ++i){
-			for (std::size_t j = 0; j != numUnits; ++j){
-				if(!mpe_structure->connection(i,j))continue;
+			mpe_structure->multiplyNeuronDerivative(errorDerivative,columns(activation[t],inputSize()+1,numUnits));
+			//update gradient with the contribution of time step t
+			noalias(weightGradient) += prod(trans(errorDerivative),activation[t-1]);
 
-				for(std::size_t t=1;t != sequence.size(); ++t)
-					gradient(param)+=errorDerivative(t,i) * sequence[t-1](j);
-				
-				++param;
+			//propagate the error to the previous time step, unless t starts a new window of truncated BPTT
+			if(t > 1 && (m_truncation == 0 || (t-1) % m_truncation != 0)){
+				noalias(propagatedError) = prod(errorDerivative,recurrentWeights);
+				swap(errorDerivative,propagatedError);
+			}else{
+				errorDerivative.clear();
 			}
 		}
-		//sanity check
-		SIZE_CHECK(param == mpe_structure->parameters());
 	}
+	for(std::size_t k = 1; k < numBlocks; ++k){
+		noalias(blockGradients[0]) += blockGradients[k];
+	}
+	if(numBlocks == 0) return;
+	
+	//copy the gradient of the existing connections
+	std::size_t param = 0;
+	for (std::size_t i = 0; i != numNeurons; ++i){
+		for (std::size_t j = 0; j != numUnits; ++j){
+			if(!mpe_structure->connection(i,j))continue;
+			gradient(param) = blockGradients[0](i,j);
+			++param;
+		}
+	}
+	//sanity check
+	SIZE_CHECK(param == mpe_structure->parameters());
 }
-
@@ -0,0 +1,69 @@
+/*!
+ *
+ *
+ * \brief       Implementation of the RandomFourierFeatures
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#define SHARK_COMPILE_DLL
+#include <shark/Models/Kernels/RandomFourierFeatures.h>
+#include <shark/Rng/GlobalRng.h>
+#include <boost/math/constants/constants.hpp>
+
+using namespace shark;
+
+void RandomFourierFeatures::setStructure(RealVector const& gammas, std::size_t numFeatures){
+	SHARK_RUNTIME_CHECK(numFeatures > 0, "[RandomFourierFeatures::setStructure] number of features must be positive");
+	SHARK_RUNTIME_CHECK(min(gammas) > 0, "[RandomFourierFeatures::setStructure] bandwidths must be positive");
+	double const pi = boost::math::constants::pi<double>();
+	std::size_t dim = gammas.size();
+	m_frequencies.resize(numFeatures, dim);
+	m_phases.resize(numFeatures);
+	for(std::size_t j = 0; j != numFeatures; ++j){
+		for(std::size_t i = 0; i != dim; ++i){
+			m_frequencies(j,i) = Rng::gauss(0, 2 * gammas(i));
+		}
+		m_phases(j) = Rng::uni(0, 2 * pi);
+	}
+}
+
+void RandomFourierFeatures::eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+	SIZE_CHECK(patterns.size2() == inputSize());
+	outputs.resize(patterns.size1(), outputSize());
+	noalias(outputs) = prod(patterns, trans(m_frequencies)) + repeat(m_phases, patterns.size1());
+	noalias(outputs) = std::sqrt(2.0 / outputSize()) * cos(outputs);
+}
+
+void RandomFourierFeatures::read( InArchive & archive ){
+	archive >> m_frequencies;
+	archive >> m_phases;
+}
+
+void RandomFourierFeatures::write( OutArchive & archive ) const{
+	archive << m_frequencies;
+	archive << m_phases;
+}